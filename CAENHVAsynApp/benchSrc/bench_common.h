@@ -0,0 +1,96 @@
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : bench_common.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Helpers shared by the benchmarks of the driver
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <epicsTime.h>
+
+// Current time, in seconds
+inline double now()
+{
+    epicsTimeStamp t;
+    epicsTimeGetCurrent(&t);
+    return t.secPastEpoch + t.nsec * 1e-9;
+}
+
+// Percentile of a sorted list of values, in ms
+inline double percentile(const std::vector<double>& v, double p)
+{
+    if (v.empty())
+        return 0;
+
+    std::size_t i = static_cast<std::size_t>(p * (v.size() - 1) + 0.5);
+    return v.at(i) * 1e3;
+}
+
+// Write a simulated crate layout, with all the slots filled, to a temporary
+// file whose name starts with 'prefix'. Returns the name of the file.
+inline std::string writeLayout(const std::string& prefix, std::size_t slots, std::size_t channels)
+{
+    std::ostringstream name;
+    name << "/tmp/" << prefix << "_" << getpid() << "_" << slots << "x" << channels << ".cfg";
+
+    std::ofstream f(name.str().c_str());
+    f << "slots " << slots << std::endl;
+    for (std::size_t s(0); s < slots; ++s)
+        f << "board " << s << " A1535 " << channels << std::endl;
+
+    return name.str();
+}
+
+// The driver prints the crate information to the standard output while
+// it is being constructed. This class sends it to /dev/null instead, so
+// that the results can be written to the standard output.
+class QuietStdout
+{
+public:
+    QuietStdout()
+    {
+        fflush(stdout);
+        std::cout.flush();
+        saved = dup(STDOUT_FILENO);
+        int null = open("/dev/null", O_WRONLY);
+        dup2(null, STDOUT_FILENO);
+        close(null);
+    };
+
+    ~QuietStdout()
+    {
+        fflush(stdout);
+        std::cout.flush();
+        dup2(saved, STDOUT_FILENO);
+        close(saved);
+    };
+
+private:
+    int saved;
+};
+
+#endif
@@ -0,0 +1,465 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : caenhv_bench.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Benchmark of the driver startup time and steady-state throughput, versus
+ * the crate size, using the simulated CAEN HV Wrapper library.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <epicsTime.h>
+#include <epicsThread.h>
+#include <epicsExit.h>
+#include <dbAccess.h>
+#include <dbStaticLib.h>
+#include <asynFloat64SyncIO.h>
+
+#include "drvCAENHVAsyn.h"
+#include "CAENHVWrapperSim.h"
+#include "bench_common.h"
+
+extern "C" int caenhvBench_registerRecordDeviceDriver(struct dbBase *pdbbase);
+
+namespace
+{
+    // Benchmark settings
+    struct Settings
+    {
+        Settings() :
+            duration(5),
+            writes(200),
+            acqPeriod(1),
+            latency(2),
+            jitter(1),
+            perChannel(20),
+            timeout(5),
+            format("csv"),
+            top(".")
+        {};
+
+        std::vector<std::size_t> slots;
+        std::vector<std::size_t> channels;
+        double      duration;   // Steady-state read phase, in seconds
+        std::size_t writes;     // Number of writes
+        double      acqPeriod;  // Driver acquisition period (0 = direct reads)
+        double      latency;    // Simulated latency, in ms
+        double      jitter;     // Simulated jitter, in ms
+        double      perChannel; // Simulated per-channel latency, in us
+        double      timeout;    // asyn timeout, in seconds
+        std::string format;
+        std::string output;
+        std::string top;
+    };
+
+    // Results for one crate layout
+    struct Result
+    {
+        std::size_t   slots;
+        std::size_t   channels;
+        double        discoveryTime;
+        unsigned long discoveryCalls;
+        double        driverInitTime;
+        double        recordGenTime;
+        unsigned long recordCount;
+        double        readsPerSecond;
+        double        wrapperCallsPerSecond;
+        double        readP50, readP99;
+        double        writeP50, writeP99;
+        unsigned long readErrors, writeErrors;
+    };
+
+    // Parse a comma separated list of numbers
+    std::vector<std::size_t> parseList(const std::string& s)
+    {
+        std::vector<std::size_t> v;
+        std::stringstream ss(s);
+        std::string item;
+
+        while (std::getline(ss, item, ','))
+            v.push_back(strtoul(item.c_str(), NULL, 0));
+
+        return v;
+    }
+
+    // Number of records currently loaded in the database
+    unsigned long countRecords()
+    {
+        unsigned long n(0);
+        DBENTRY entry;
+
+        dbInitEntry(pdbbase, &entry);
+        for (long s = dbFirstRecordType(&entry); !s; s = dbNextRecordType(&entry))
+            n += dbGetNRecords(&entry);
+        dbFinishEntry(&entry);
+
+        return n;
+    }
+
+    // Construct a driver on a new port, returning the construction time
+    double createDriver(const std::string& portName, const std::string& ipAddr, const std::string& prefix)
+    {
+        CAENHVAsyn::epicsPrefix = prefix;
+
+        double start = now();
+        {
+            QuietStdout q;
+            new CAENHVAsyn(portName, 0, ipAddr, "admin", "admin");
+        }
+        return now() - start;
+    }
+
+    // Write a Float64 parameter of a port
+    void writeParam(const std::string& portName, const std::string& param, double value, double timeout)
+    {
+        asynUser *pasynUser;
+        if (pasynFloat64SyncIO->connect(portName.c_str(), 0, &pasynUser, param.c_str()) != asynSuccess)
+            throw std::runtime_error("Can not connect to parameter '" + param + "' on port '" + portName + "'");
+
+        pasynFloat64SyncIO->write(pasynUser, value, timeout);
+        pasynFloat64SyncIO->disconnect(pasynUser);
+    }
+
+    // Connect to a parameter of every channel
+    std::vector<asynUser*> connectChannels(const std::string& portName, std::size_t slots, std::size_t channels, const std::string& param)
+    {
+        std::vector<asynUser*> users;
+
+        for (std::size_t s(0); s < slots; ++s)
+        {
+            for (std::size_t c(0); c < channels; ++c)
+            {
+                std::ostringstream name;
+                name << "S" << std::setfill('0') << std::setw(2) << s << "_" \
+                     << "C" << std::setfill('0') << std::setw(2) << c << "_" \
+                     << param;
+
+                asynUser *pasynUser;
+                if (pasynFloat64SyncIO->connect(portName.c_str(), 0, &pasynUser, name.str().c_str()) != asynSuccess)
+                    throw std::runtime_error("Can not connect to parameter '" + name.str() + "' on port '" + portName + "'");
+
+                users.push_back(pasynUser);
+            }
+        }
+
+        return users;
+    }
+
+    void disconnectChannels(std::vector<asynUser*>& users)
+    {
+        for (std::vector<asynUser*>::iterator it = users.begin(); it != users.end(); ++it)
+            pasynFloat64SyncIO->disconnect(*it);
+
+        users.clear();
+    }
+
+    Result runLayout(const Settings& s, std::size_t index, std::size_t slots, std::size_t channels)
+    {
+        Result r = Result();
+        r.slots    = slots;
+        r.channels = channels;
+
+        // Each layout is a different crate, on a different address
+        std::string layout = writeLayout("caenhvBench", slots, channels);
+        if (CAENHVSim_LoadConfig(layout.c_str()))
+            throw std::runtime_error("Can not load the simulated crate layout '" + layout + "'");
+        remove(layout.c_str());
+
+        std::ostringstream ipAddr;
+        ipAddr << "10.0." << index << ".1";
+
+        std::ostringstream portName;
+        portName << "BENCH" << index;
+
+        // Discovery: crate map, properties and parameter lists
+        CAENHVSim_ResetCallCounts();
+        double start = now();
+        {
+            QuietStdout q;
+            Crate crate = ICrate::create(0, ipAddr.str(), "admin", "admin");
+        }
+        r.discoveryTime  = now() - start;
+        r.discoveryCalls = CAENHVSim_GetCallCount("*");
+
+        // Driver initialization, without and with the auto-generation of records.
+        // The difference between both is the record generation time.
+        unsigned long records = countRecords();
+        r.driverInitTime = createDriver(portName.str() + "_NOREC", ipAddr.str(), "");
+        writeParam(portName.str() + "_NOREC", "ACQ_PERIOD", 0, s.timeout);
+
+        std::string port = portName.str();
+        r.recordGenTime = createDriver(port, ipAddr.str(), port + ":") - r.driverInitTime;
+        r.recordCount   = countRecords() - records;
+
+        // Let the acquisition fill the first snapshots
+        if (s.acqPeriod > 0)
+            epicsThreadSleep(2 * s.acqPeriod);
+
+        // Steady-state reads, round robin over all the channels
+        std::vector<asynUser*> readers = connectChannels(port, slots, channels, "VMON");
+        std::vector<double> readTimes;
+        CAENHVSim_ResetCallCounts();
+
+        start = now();
+        double end = start + s.duration;
+        for (std::size_t i(0); now() < end; ++i)
+        {
+            epicsFloat64 value;
+            double t0 = now();
+            if (pasynFloat64SyncIO->read(readers.at(i % readers.size()), &value, s.timeout) != asynSuccess)
+                ++r.readErrors;
+            readTimes.push_back(now() - t0);
+        }
+        double elapsed = now() - start;
+
+        r.readsPerSecond        = readTimes.size() / elapsed;
+        r.wrapperCallsPerSecond = CAENHVSim_GetCallCount("*") / elapsed;
+        std::sort(readTimes.begin(), readTimes.end());
+        r.readP50               = percentile(readTimes, 0.50);
+        r.readP99               = percentile(readTimes, 0.99);
+        disconnectChannels(readers);
+
+        // Writes, round robin over all the channels
+        std::vector<asynUser*> writers = connectChannels(port, slots, channels, "V0SET");
+        std::vector<double> writeTimes;
+
+        for (std::size_t i(0); i < s.writes; ++i)
+        {
+            double t0 = now();
+            if (pasynFloat64SyncIO->write(writers.at(i % writers.size()), i % 100, s.timeout) != asynSuccess)
+                ++r.writeErrors;
+            writeTimes.push_back(now() - t0);
+        }
+
+        std::sort(writeTimes.begin(), writeTimes.end());
+        r.writeP50 = percentile(writeTimes, 0.50);
+        r.writeP99 = percentile(writeTimes, 0.99);
+        disconnectChannels(writers);
+
+        // Stop the acquisition of this driver, so it doesn't load the next layouts
+        writeParam(port, "ACQ_PERIOD", 0, s.timeout);
+
+        return r;
+    }
+
+    void writeCsv(std::ostream& o, const std::vector<Result>& results)
+    {
+        o << "slots,channels,discovery_s,discovery_calls,driver_init_s,record_gen_s,records,"
+          << "reads_per_s,wrapper_calls_per_s,read_p50_ms,read_p99_ms,write_p50_ms,write_p99_ms,"
+          << "read_errors,write_errors" << std::endl;
+
+        for (std::vector<Result>::const_iterator it = results.begin(); it != results.end(); ++it)
+        {
+            o << it->slots                 << ","
+              << it->channels              << ","
+              << it->discoveryTime         << ","
+              << it->discoveryCalls        << ","
+              << it->driverInitTime        << ","
+              << it->recordGenTime         << ","
+              << it->recordCount           << ","
+              << it->readsPerSecond        << ","
+              << it->wrapperCallsPerSecond << ","
+              << it->readP50               << ","
+              << it->readP99               << ","
+              << it->writeP50              << ","
+              << it->writeP99              << ","
+              << it->readErrors            << ","
+              << it->writeErrors           << std::endl;
+        }
+    }
+
+    void writeJson(std::ostream& o, const Settings& s, const std::vector<Result>& results)
+    {
+        o << "{" << std::endl;
+        o << "  \"settings\": { "
+          << "\"acq_period_s\": "      << s.acqPeriod  << ", "
+          << "\"latency_ms\": "        << s.latency    << ", "
+          << "\"jitter_ms\": "         << s.jitter     << ", "
+          << "\"per_channel_us\": "    << s.perChannel << ", "
+          << "\"read_duration_s\": "   << s.duration   << ", "
+          << "\"writes\": "            << s.writes     << " }," << std::endl;
+        o << "  \"results\": [" << std::endl;
+
+        for (std::vector<Result>::const_iterator it = results.begin(); it != results.end(); ++it)
+        {
+            o << "    { "
+              << "\"slots\": "               << it->slots                 << ", "
+              << "\"channels\": "            << it->channels              << ", "
+              << "\"discovery_s\": "         << it->discoveryTime         << ", "
+              << "\"discovery_calls\": "     << it->discoveryCalls        << ", "
+              << "\"driver_init_s\": "       << it->driverInitTime        << ", "
+              << "\"record_gen_s\": "        << it->recordGenTime         << ", "
+              << "\"records\": "             << it->recordCount           << ", "
+              << "\"reads_per_s\": "         << it->readsPerSecond        << ", "
+              << "\"wrapper_calls_per_s\": " << it->wrapperCallsPerSecond << ", "
+              << "\"read_p50_ms\": "         << it->readP50               << ", "
+              << "\"read_p99_ms\": "         << it->readP99               << ", "
+              << "\"write_p50_ms\": "        << it->writeP50              << ", "
+              << "\"write_p99_ms\": "        << it->writeP99              << ", "
+              << "\"read_errors\": "         << it->readErrors            << ", "
+              << "\"write_errors\": "        << it->writeErrors           << " }"
+              << ( ( it + 1 != results.end() ) ? "," : "" ) << std::endl;
+        }
+
+        o << "  ]" << std::endl;
+        o << "}" << std::endl;
+    }
+
+    void usage(const char* name)
+    {
+        std::cout << "Usage: " << name << " [options]" << std::endl;
+        std::cout << "  -s, --slots LIST          Comma separated number of slots (default 1,4,8,16)" << std::endl;
+        std::cout << "  -c, --channels LIST       Comma separated number of channels per board (default 12,24,48)" << std::endl;
+        std::cout << "  -d, --duration SECONDS    Duration of the steady-state read phase (default 5)" << std::endl;
+        std::cout << "  -w, --writes N            Number of writes (default 200)" << std::endl;
+        std::cout << "  -a, --acq-period SECONDS  Driver acquisition period, 0 for direct reads (default 1)" << std::endl;
+        std::cout << "  -l, --latency MS,MS,US    Simulated latency, jitter and per-channel latency (default 2,1,20)" << std::endl;
+        std::cout << "  -f, --format csv|json     Output format (default csv)" << std::endl;
+        std::cout << "  -o, --output FILE         Output file (default standard output)" << std::endl;
+        std::cout << "  -t, --top DIR             Top of the module, with the 'dbd' and 'db' directories (default .)" << std::endl;
+        std::cout << "  -h, --help                Show this message" << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Settings s;
+
+    const struct option options[] =
+    {
+        { "slots",      required_argument, NULL, 's' },
+        { "channels",   required_argument, NULL, 'c' },
+        { "duration",   required_argument, NULL, 'd' },
+        { "writes",     required_argument, NULL, 'w' },
+        { "acq-period", required_argument, NULL, 'a' },
+        { "latency",    required_argument, NULL, 'l' },
+        { "format",     required_argument, NULL, 'f' },
+        { "output",     required_argument, NULL, 'o' },
+        { "top",        required_argument, NULL, 't' },
+        { "help",       no_argument,       NULL, 'h' },
+        { NULL,         0,                 NULL, 0   }
+    };
+
+    int opt;
+    while ( ( opt = getopt_long(argc, argv, "s:c:d:w:a:l:f:o:t:h", options, NULL) ) != -1 )
+    {
+        switch (opt)
+        {
+            case 's': s.slots     = parseList(optarg); break;
+            case 'c': s.channels  = parseList(optarg); break;
+            case 'd': s.duration  = atof(optarg);      break;
+            case 'w': s.writes    = atoi(optarg);      break;
+            case 'a': s.acqPeriod = atof(optarg);      break;
+            case 'l':
+                if (sscanf(optarg, "%lf,%lf,%lf", &s.latency, &s.jitter, &s.perChannel) < 2)
+                {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'f': s.format    = optarg;            break;
+            case 'o': s.output    = optarg;            break;
+            case 't': s.top       = optarg;            break;
+            default:
+                usage(argv[0]);
+                return ( opt == 'h' ) ? 0 : 1;
+        }
+    }
+
+    if (s.slots.empty())
+        s.slots = parseList("1,4,8,16");
+
+    if (s.channels.empty())
+        s.channels = parseList("12,24,48");
+
+    if ( ( s.format != "csv" ) && ( s.format != "json" ) )
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // The auto-generation of records loads the templates from 'db/'
+    if (chdir(s.top.c_str()))
+    {
+        std::cerr << "Can not change to directory '" << s.top << "'" << std::endl;
+        return 1;
+    }
+
+    if (dbLoadDatabase("dbd/caenhvBench.dbd", NULL, NULL))
+    {
+        std::cerr << "Can not load 'dbd/caenhvBench.dbd'" << std::endl;
+        return 1;
+    }
+    caenhvBench_registerRecordDeviceDriver(pdbbase);
+
+    CAENHVSim_SetLatency(s.latency * 1e-3, s.jitter * 1e-3, s.perChannel * 1e-6);
+    CAENHVAsyn::defaultAcqPeriod = s.acqPeriod;
+    CAENHVAsyn::wrapperTimeout   = s.timeout;
+
+    std::vector<Result> results;
+    std::size_t index(0);
+
+    try
+    {
+        for (std::vector<std::size_t>::const_iterator sIt = s.slots.begin(); sIt != s.slots.end(); ++sIt)
+        {
+            for (std::vector<std::size_t>::const_iterator cIt = s.channels.begin(); cIt != s.channels.end(); ++cIt)
+            {
+                std::cerr << "Running " << *sIt << " slots x " << *cIt << " channels..." << std::endl;
+                results.push_back(runLayout(s, index++, *sIt, *cIt));
+            }
+        }
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!s.output.empty())
+    {
+        file.open(s.output.c_str());
+        if (!file.is_open())
+        {
+            std::cerr << "Can not open output file '" << s.output << "'" << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& o = s.output.empty() ? std::cout : file;
+
+    if (s.format == "json")
+        writeJson(o, s, results);
+    else
+        writeCsv(o, results);
+
+    o.flush();
+
+    // The driver threads never exit
+    epicsExit(0);
+    return 0;
+}
@@ -0,0 +1,198 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : caenhv_io_bench.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Micro-benchmark of the per-call overhead of the asyn interface methods
+ * overridden by the driver, with the I/O trace disabled and enabled, using
+ * the simulated CAEN HV Wrapper library.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <functional>
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+#include <epicsTime.h>
+#include <asynDriver.h>
+
+#include "drvCAENHVAsyn.h"
+#include "CAENHVWrapperSim.h"
+#include "bench_common.h"
+
+namespace
+{
+    const char *portName = "IOBENCH";
+
+    // One of the overridden methods, with the parameter it is called on
+    struct Method
+    {
+        std::string                name;
+        int                        reason;
+        std::function<asynStatus()> call;
+    };
+
+    // Average time per call, in ns
+    double measure(CAENHVAsyn *drv, asynUser *pasynUser, const Method& m, unsigned long calls)
+    {
+        pasynUser->reason = m.reason;
+
+        // The methods are called with the port locked, as asynManager does
+        drv->lock();
+        double start = now();
+        for (unsigned long i(0); i < calls; ++i)
+            m.call();
+        double elapsed = now() - start;
+        drv->unlock();
+
+        return elapsed * 1e9 / calls;
+    }
+
+    void usage(const char* name)
+    {
+        std::cout << "Usage: " << name << " [options]" << std::endl;
+        std::cout << "  -n, --calls N             Number of calls to each method (default 1000000)" << std::endl;
+        std::cout << "  -h, --help                Show this message" << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long calls(1000000);
+
+    static struct option longOptions[] =
+    {
+        { "calls", required_argument, 0, 'n' },
+        { "help",  no_argument,       0, 'h' },
+        { 0,       0,                 0, 0   }
+    };
+
+    int c;
+    while ( ( c = getopt_long(argc, argv, "n:h", longOptions, NULL) ) != -1 )
+    {
+        switch (c)
+        {
+            case 'n':
+                calls = strtoul(optarg, NULL, 0);
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (!calls)
+    {
+        std::cerr << "The number of calls must be greater than 0" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        // A driver on the default simulated crate, without records and
+        // without background acquisition
+        CAENHVAsyn *drv;
+        {
+            QuietStdout q;
+            CAENHVAsyn::epicsPrefix = "";
+            drv = new CAENHVAsyn(portName, 0, "10.0.0.1", "admin", "admin");
+        }
+
+        // Parameters which are not handled by the driver: the calls go
+        // through all the driver parameter lists, and then to asynPortDriver,
+        // without calling the wrapper library
+        int int32Param, float64Param, digitalParam, octetParam;
+        if ( ( drv->createParam("IOBENCH_INT32",   asynParamInt32,         &int32Param)   != asynSuccess ) ||
+             ( drv->createParam("IOBENCH_FLOAT64", asynParamFloat64,       &float64Param) != asynSuccess ) ||
+             ( drv->createParam("IOBENCH_DIGITAL", asynParamUInt32Digital, &digitalParam) != asynSuccess ) ||
+             ( drv->createParam("IOBENCH_OCTET",   asynParamOctet,         &octetParam)   != asynSuccess ) )
+            throw std::runtime_error("Can not create the benchmark parameters");
+
+        drv->setIntegerParam(int32Param, 0);
+        drv->setDoubleParam(float64Param, 0);
+        drv->setUIntDigitalParam(digitalParam, 0, 0xFFFFFFFF);
+        drv->setStringParam(octetParam, "benchmark");
+
+        asynUser *pasynUser = pasynManager->createAsynUser(0, 0);
+        if (pasynManager->connectDevice(pasynUser, portName, 0) != asynSuccess)
+            throw std::runtime_error("Can not connect to the driver port");
+
+        // Stop the background acquisition, so it does not compete for the port lock
+        int acqPeriodParam;
+        if (drv->findParam("ACQ_PERIOD", &acqPeriodParam) != asynSuccess)
+            throw std::runtime_error("Can not find the ACQ_PERIOD parameter");
+
+        pasynUser->reason = acqPeriodParam;
+        drv->lock();
+        drv->writeFloat64(pasynUser, 0);
+        drv->unlock();
+
+        epicsInt32   i32(0);
+        epicsFloat64 f64(0);
+        epicsUInt32  u32(0);
+        char         octet[64];
+        size_t       nActual;
+        int          eomReason;
+
+        std::vector<Method> methods;
+        methods.push_back( { "readInt32",          int32Param,   [&]() { return drv->readInt32(pasynUser, &i32); } } );
+        methods.push_back( { "writeInt32",         int32Param,   [&]() { return drv->writeInt32(pasynUser, 1); } } );
+        methods.push_back( { "readFloat64",        float64Param, [&]() { return drv->readFloat64(pasynUser, &f64); } } );
+        methods.push_back( { "writeFloat64",       float64Param, [&]() { return drv->writeFloat64(pasynUser, 1.0); } } );
+        methods.push_back( { "readUInt32Digital",  digitalParam, [&]() { return drv->readUInt32Digital(pasynUser, &u32, 0xFFFFFFFF); } } );
+        methods.push_back( { "writeUInt32Digital", digitalParam, [&]() { return drv->writeUInt32Digital(pasynUser, 1, 0xFFFFFFFF); } } );
+        methods.push_back( { "readOctet",          octetParam,   [&]() { return drv->readOctet(pasynUser, octet, sizeof(octet), &nActual, &eomReason); } } );
+        methods.push_back( { "writeOctet",         octetParam,   [&]() { return drv->writeOctet(pasynUser, "benchmark", 9, &nActual); } } );
+
+        // The enabled trace messages are written to /dev/null
+        FILE *null = fopen("/dev/null", "w");
+        if (!null)
+            throw std::runtime_error("Can not open /dev/null");
+
+        std::cout << "method,trace_off_ns,trace_on_ns" << std::endl;
+        for (std::vector<Method>::const_iterator it = methods.begin(); it != methods.end(); ++it)
+        {
+            pasynTrace->setTraceMask(pasynUser, ASYN_TRACE_ERROR);
+            double off = measure(drv, pasynUser, *it, calls);
+
+            pasynTrace->setTraceFile(pasynUser, null);
+            pasynTrace->setTraceMask(pasynUser, ASYN_TRACE_ERROR | ASYN_TRACEIO_DRIVER);
+            double on = measure(drv, pasynUser, *it, calls);
+
+            pasynTrace->setTraceMask(pasynUser, ASYN_TRACE_ERROR);
+            pasynTrace->setTraceFile(pasynUser, stderr);
+
+            std::cout << it->name << "," << off << "," << on << std::endl;
+        }
+
+        fclose(null);
+        pasynManager->disconnect(pasynUser);
+        pasynManager->freeAsynUser(pasynUser);
+    }
+    catch(std::runtime_error& e)
+    {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,579 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : caenhv_load.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Load generator: drives a driver on a simulated crate from many concurrent
+ * asyn users, mixing reads, writes and status bit reads at configurable
+ * rates, and reports the throughput, the latencies, and the port lock wait
+ * and hold times of each kind of client.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <epicsTime.h>
+#include <epicsThread.h>
+#include <epicsEvent.h>
+#include <epicsExit.h>
+#include <asynDriver.h>
+
+#include "drvCAENHVAsyn.h"
+#include "CAENHVWrapperSim.h"
+#include "bench_common.h"
+
+namespace
+{
+    const char *portName = "LOAD";
+
+    // Kinds of clients
+    enum Kind
+    {
+        Reader = 0,     // Reads VMon, as CA clients and archivers do
+        Writer,         // Writes V0Set, as operators and sequencers do
+        StatusReader,   // Reads the channel status bits
+        NumKinds
+    };
+
+    const char* kindNames[NumKinds] = { "read", "write", "status" };
+
+    // Number of clients of a kind, and the rate of each one (0 = as fast as possible)
+    struct ClientGroup
+    {
+        ClientGroup(std::size_t n, double r) : count(n), rate(r) {};
+
+        std::size_t count;
+        double      rate; // Hz
+    };
+
+    // Load generator settings
+    struct Settings
+    {
+        Settings() :
+            slots(4),
+            channels(24),
+            duration(10),
+            acqPeriod(1),
+            latency(2),
+            jitter(1),
+            perChannel(20),
+            errorRate(0),
+            timeout(5),
+            format("csv")
+        {
+            groups.push_back(ClientGroup(8, 10));
+            groups.push_back(ClientGroup(2, 1));
+            groups.push_back(ClientGroup(4, 10));
+        };
+
+        std::size_t slots;
+        std::size_t channels;
+        double      duration;   // Seconds
+        double      acqPeriod;  // Driver acquisition period (0 = direct reads)
+        double      latency;    // Simulated latency, in ms
+        double      jitter;     // Simulated jitter, in ms
+        double      perChannel; // Simulated per-channel latency, in us
+        double      errorRate;  // Simulated probability for each call to fail
+        double      timeout;    // Wrapper call timeout, in seconds
+        std::string format;
+        std::string output;
+        std::vector<ClientGroup> groups; // Indexed by Kind
+    };
+
+    // Measurements of one client. Times are in seconds.
+    struct Samples
+    {
+        Samples() : errors(0) {};
+
+        std::vector<double> latency;  // From the request to the release of the lock
+        std::vector<double> lockWait; // Waiting for the port lock
+        std::vector<double> lockHold; // Holding the port lock
+        unsigned long       errors;
+    };
+
+    // A client thread
+    struct Client
+    {
+        Kind                   kind;
+        double                 rate;
+        double                 end;
+        std::size_t            first;  // First parameter, so that clients don't go in lockstep
+        CAENHVAsyn            *drv;
+        asynUser              *pasynUser;
+        const std::vector<int> *params;
+        Samples                samples;
+        epicsEventId           done;
+    };
+
+    // Results of a kind of client
+    struct Result
+    {
+        std::size_t   clients;
+        double        rate;
+        unsigned long ops;
+        unsigned long errors;
+        double        opsPerSecond;
+        double        latencyP50, latencyP99, latencyP999, latencyMax;
+        double        waitP50, waitP99, waitMax;
+        double        holdP50, holdP99, holdMax;
+    };
+
+    // Find a parameter of every channel
+    std::vector<int> findChannelParams(CAENHVAsyn *drv, std::size_t slots, std::size_t channels, const std::string& param)
+    {
+        std::vector<int> params;
+
+        for (std::size_t s(0); s < slots; ++s)
+        {
+            for (std::size_t c(0); c < channels; ++c)
+            {
+                std::ostringstream name;
+                name << "S" << std::setfill('0') << std::setw(2) << s << "_" \
+                     << "C" << std::setfill('0') << std::setw(2) << c << "_" \
+                     << param;
+
+                int index;
+                if (drv->findParam(name.str().c_str(), &index) != asynSuccess)
+                    throw std::runtime_error("Can not find parameter '" + name.str() + "'");
+
+                params.push_back(index);
+            }
+        }
+
+        return params;
+    }
+
+    // Each operation locks the port and calls the driver method, as
+    // asynManager does for the requests of the records.
+    void clientTask(Client *c)
+    {
+        double next = now();
+
+        for (std::size_t i(c->first); now() < c->end; ++i)
+        {
+            c->pasynUser->reason = c->params->at(i % c->params->size());
+
+            epicsFloat64 f64;
+            epicsUInt32  u32;
+            asynStatus   status;
+
+            double t0 = now();
+            c->drv->lock();
+            double t1 = now();
+
+            switch (c->kind)
+            {
+                case Reader:
+                    status = c->drv->readFloat64(c->pasynUser, &f64);
+                    break;
+                case Writer:
+                    status = c->drv->writeFloat64(c->pasynUser, i % 100);
+                    break;
+                default:
+                    status = c->drv->readUInt32Digital(c->pasynUser, &u32, 0xFFFFFFFF);
+                    break;
+            }
+
+            double t2 = now();
+            c->drv->unlock();
+
+            c->samples.latency.push_back(t2 - t0);
+            c->samples.lockWait.push_back(t1 - t0);
+            c->samples.lockHold.push_back(t2 - t1);
+            if (status != asynSuccess)
+                ++c->samples.errors;
+
+            // Don't try to catch up after falling behind
+            if (c->rate > 0)
+            {
+                next = std::max(next + 1.0 / c->rate, t2);
+                double wait = next - now();
+                if (wait > 0)
+                    epicsThreadSleep(wait);
+            }
+        }
+
+        epicsEventSignal(c->done);
+    }
+
+    void clientTaskC(void *arg)
+    {
+        clientTask(static_cast<Client*>(arg));
+    }
+
+    Result summarize(const std::vector<Client*>& clients, Kind kind, const ClientGroup& g, double elapsed)
+    {
+        Result r = Result();
+        r.clients = g.count;
+        r.rate    = g.rate;
+
+        std::vector<double> latency, wait, hold;
+        for (std::vector<Client*>::const_iterator it = clients.begin(); it != clients.end(); ++it)
+        {
+            if ((*it)->kind != kind)
+                continue;
+
+            const Samples& s = (*it)->samples;
+            latency.insert(latency.end(), s.latency.begin(), s.latency.end());
+            wait.insert(wait.end(), s.lockWait.begin(), s.lockWait.end());
+            hold.insert(hold.end(), s.lockHold.begin(), s.lockHold.end());
+            r.errors += s.errors;
+        }
+
+        std::sort(latency.begin(), latency.end());
+        std::sort(wait.begin(), wait.end());
+        std::sort(hold.begin(), hold.end());
+
+        r.ops          = latency.size();
+        r.opsPerSecond = r.ops / elapsed;
+        r.latencyP50   = percentile(latency, 0.50);
+        r.latencyP99   = percentile(latency, 0.99);
+        r.latencyP999  = percentile(latency, 0.999);
+        r.latencyMax   = percentile(latency, 1);
+        r.waitP50      = percentile(wait, 0.50);
+        r.waitP99      = percentile(wait, 0.99);
+        r.waitMax      = percentile(wait, 1);
+        r.holdP50      = percentile(hold, 0.50);
+        r.holdP99      = percentile(hold, 0.99);
+        r.holdMax      = percentile(hold, 1);
+
+        return r;
+    }
+
+    // Driver wide counters, read from the parameter library
+    struct DriverCounters
+    {
+        epicsInt32    reconnects;
+        epicsInt32    overruns;
+        double        wrapperCallsPerSecond;
+    };
+
+    epicsInt32 getCounter(CAENHVAsyn *drv, const char *name)
+    {
+        int index;
+        epicsInt32 value(0);
+
+        if (drv->findParam(name, &index) == asynSuccess)
+        {
+            drv->lock();
+            drv->getIntegerParam(index, &value);
+            drv->unlock();
+        }
+
+        return value;
+    }
+
+    void writeCsv(std::ostream& o, const std::vector<Result>& results, const DriverCounters& d)
+    {
+        o << "client,clients,rate_hz,ops,errors,ops_per_s,"
+          << "latency_p50_ms,latency_p99_ms,latency_p999_ms,latency_max_ms,"
+          << "lock_wait_p50_ms,lock_wait_p99_ms,lock_wait_max_ms,"
+          << "lock_hold_p50_ms,lock_hold_p99_ms,lock_hold_max_ms" << std::endl;
+
+        for (std::size_t k(0); k < results.size(); ++k)
+        {
+            const Result& r = results.at(k);
+            o << kindNames[k]   << ","
+              << r.clients      << ","
+              << r.rate         << ","
+              << r.ops          << ","
+              << r.errors       << ","
+              << r.opsPerSecond << ","
+              << r.latencyP50   << ","
+              << r.latencyP99   << ","
+              << r.latencyP999  << ","
+              << r.latencyMax   << ","
+              << r.waitP50      << ","
+              << r.waitP99      << ","
+              << r.waitMax      << ","
+              << r.holdP50      << ","
+              << r.holdP99      << ","
+              << r.holdMax      << std::endl;
+        }
+
+        o << std::endl;
+        o << "wrapper_calls_per_s,reconnects,acq_overruns" << std::endl;
+        o << d.wrapperCallsPerSecond << "," << d.reconnects << "," << d.overruns << std::endl;
+    }
+
+    void writeJson(std::ostream& o, const Settings& s, const std::vector<Result>& results, const DriverCounters& d)
+    {
+        o << "{" << std::endl;
+        o << "  \"settings\": { "
+          << "\"slots\": "          << s.slots      << ", "
+          << "\"channels\": "       << s.channels   << ", "
+          << "\"duration_s\": "     << s.duration   << ", "
+          << "\"acq_period_s\": "   << s.acqPeriod  << ", "
+          << "\"latency_ms\": "     << s.latency    << ", "
+          << "\"jitter_ms\": "      << s.jitter     << ", "
+          << "\"per_channel_us\": " << s.perChannel << ", "
+          << "\"error_rate\": "     << s.errorRate  << " }," << std::endl;
+        o << "  \"driver\": { "
+          << "\"wrapper_calls_per_s\": " << d.wrapperCallsPerSecond << ", "
+          << "\"reconnects\": "          << d.reconnects            << ", "
+          << "\"acq_overruns\": "        << d.overruns              << " }," << std::endl;
+        o << "  \"clients\": [" << std::endl;
+
+        for (std::size_t k(0); k < results.size(); ++k)
+        {
+            const Result& r = results.at(k);
+            o << "    { "
+              << "\"client\": \""          << kindNames[k]   << "\", "
+              << "\"clients\": "           << r.clients      << ", "
+              << "\"rate_hz\": "           << r.rate         << ", "
+              << "\"ops\": "               << r.ops          << ", "
+              << "\"errors\": "            << r.errors       << ", "
+              << "\"ops_per_s\": "         << r.opsPerSecond << ", "
+              << "\"latency_p50_ms\": "    << r.latencyP50   << ", "
+              << "\"latency_p99_ms\": "    << r.latencyP99   << ", "
+              << "\"latency_p999_ms\": "   << r.latencyP999  << ", "
+              << "\"latency_max_ms\": "    << r.latencyMax   << ", "
+              << "\"lock_wait_p50_ms\": "  << r.waitP50      << ", "
+              << "\"lock_wait_p99_ms\": "  << r.waitP99      << ", "
+              << "\"lock_wait_max_ms\": "  << r.waitMax      << ", "
+              << "\"lock_hold_p50_ms\": "  << r.holdP50      << ", "
+              << "\"lock_hold_p99_ms\": "  << r.holdP99      << ", "
+              << "\"lock_hold_max_ms\": "  << r.holdMax      << " }"
+              << ( ( k + 1 != results.size() ) ? "," : "" ) << std::endl;
+        }
+
+        o << "  ]" << std::endl;
+        o << "}" << std::endl;
+    }
+
+    // Parse a "N,RATE" client group
+    bool parseGroup(const char *arg, ClientGroup& g)
+    {
+        unsigned long n;
+        double        rate;
+
+        if ( ( sscanf(arg, "%lu,%lf", &n, &rate) != 2 ) || ( rate < 0 ) )
+            return false;
+
+        g = ClientGroup(n, rate);
+        return true;
+    }
+
+    void usage(const char* name)
+    {
+        std::cout << "Usage: " << name << " [options]" << std::endl;
+        std::cout << "  -s, --slots N             Number of slots (default 4)" << std::endl;
+        std::cout << "  -c, --channels N          Number of channels per board (default 24)" << std::endl;
+        std::cout << "  -d, --duration SECONDS    Duration of the test (default 10)" << std::endl;
+        std::cout << "  -r, --readers N,RATE      VMon reader clients, and rate of each one in Hz (default 8,10)" << std::endl;
+        std::cout << "  -w, --writers N,RATE      V0Set writer clients, and rate of each one in Hz (default 2,1)" << std::endl;
+        std::cout << "  -b, --status N,RATE       Status bit reader clients, and rate of each one in Hz (default 4,10)" << std::endl;
+        std::cout << "                            A rate of 0 means as fast as possible" << std::endl;
+        std::cout << "  -a, --acq-period SECONDS  Driver acquisition period, 0 for direct reads (default 1)" << std::endl;
+        std::cout << "  -l, --latency MS,MS,US    Simulated latency, jitter and per-channel latency (default 2,1,20)" << std::endl;
+        std::cout << "  -e, --error-rate P        Simulated probability for each wrapper call to fail (default 0)" << std::endl;
+        std::cout << "  -f, --format csv|json     Output format (default csv)" << std::endl;
+        std::cout << "  -o, --output FILE         Output file (default standard output)" << std::endl;
+        std::cout << "  -h, --help                Show this message" << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Settings s;
+
+    const struct option options[] =
+    {
+        { "slots",      required_argument, NULL, 's' },
+        { "channels",   required_argument, NULL, 'c' },
+        { "duration",   required_argument, NULL, 'd' },
+        { "readers",    required_argument, NULL, 'r' },
+        { "writers",    required_argument, NULL, 'w' },
+        { "status",     required_argument, NULL, 'b' },
+        { "acq-period", required_argument, NULL, 'a' },
+        { "latency",    required_argument, NULL, 'l' },
+        { "error-rate", required_argument, NULL, 'e' },
+        { "format",     required_argument, NULL, 'f' },
+        { "output",     required_argument, NULL, 'o' },
+        { "help",       no_argument,       NULL, 'h' },
+        { NULL,         0,                 NULL, 0   }
+    };
+
+    int opt;
+    while ( ( opt = getopt_long(argc, argv, "s:c:d:r:w:b:a:l:e:f:o:h", options, NULL) ) != -1 )
+    {
+        bool ok(true);
+
+        switch (opt)
+        {
+            case 's': s.slots     = strtoul(optarg, NULL, 0);                 break;
+            case 'c': s.channels  = strtoul(optarg, NULL, 0);                 break;
+            case 'd': s.duration  = atof(optarg);                             break;
+            case 'r': ok = parseGroup(optarg, s.groups.at(Reader));           break;
+            case 'w': ok = parseGroup(optarg, s.groups.at(Writer));           break;
+            case 'b': ok = parseGroup(optarg, s.groups.at(StatusReader));     break;
+            case 'a': s.acqPeriod = atof(optarg);                             break;
+            case 'l': ok = ( sscanf(optarg, "%lf,%lf,%lf", &s.latency, &s.jitter, &s.perChannel) >= 2 ); break;
+            case 'e': s.errorRate = atof(optarg);                             break;
+            case 'f': s.format    = optarg;                                   break;
+            case 'o': s.output    = optarg;                                   break;
+            default:
+                usage(argv[0]);
+                return ( opt == 'h' ) ? 0 : 1;
+        }
+
+        if (!ok)
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if ( ( !s.slots ) || ( !s.channels ) || ( s.duration <= 0 ) || ( ( s.format != "csv" ) && ( s.format != "json" ) ) )
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    CAENHVSim_SetLatency(s.latency * 1e-3, s.jitter * 1e-3, s.perChannel * 1e-6);
+    CAENHVAsyn::defaultAcqPeriod = s.acqPeriod;
+    CAENHVAsyn::wrapperTimeout   = s.timeout;
+
+    std::vector<Client*> clients;
+    std::vector<Result>  results;
+    DriverCounters       counters = DriverCounters();
+
+    try
+    {
+        std::string layout = writeLayout("caenhvLoad", s.slots, s.channels);
+        if (CAENHVSim_LoadConfig(layout.c_str()))
+            throw std::runtime_error("Can not load the simulated crate layout '" + layout + "'");
+        remove(layout.c_str());
+
+        // A driver without records
+        CAENHVAsyn *drv;
+        {
+            QuietStdout q;
+            CAENHVAsyn::epicsPrefix = "";
+            drv = new CAENHVAsyn(portName, 0, "10.0.0.1", "admin", "admin");
+        }
+
+        std::vector< std::vector<int> > params(NumKinds);
+        params.at(Reader)       = findChannelParams(drv, s.slots, s.channels, "VMON");
+        params.at(Writer)       = findChannelParams(drv, s.slots, s.channels, "V0SET");
+        params.at(StatusReader) = findChannelParams(drv, s.slots, s.channels, "STATUS");
+
+        // Let the acquisition fill the first snapshots
+        if (s.acqPeriod > 0)
+            epicsThreadSleep(2 * s.acqPeriod);
+
+        // The errors are only injected during the test
+        CAENHVSim_SetErrorRate(s.errorRate);
+        CAENHVSim_ResetCallCounts();
+        epicsInt32 reconnects = getCounter(drv, "DRV_RECONNECTS");
+        epicsInt32 overruns   = getCounter(drv, "DRV_POLL_MISSED");
+
+        std::size_t total(0);
+        for (std::size_t k(0); k < NumKinds; ++k)
+            total += s.groups.at(k).count;
+
+        std::cerr << "Running " << total << " clients for " << s.duration << " s..." << std::endl;
+
+        double start = now();
+        for (std::size_t k(0); k < NumKinds; ++k)
+        {
+            for (std::size_t i(0); i < s.groups.at(k).count; ++i)
+            {
+                Client *c = new Client();
+                c->kind      = static_cast<Kind>(k);
+                c->rate      = s.groups.at(k).rate;
+                c->end       = start + s.duration;
+                c->first     = ( clients.size() * 7 ) % params.at(k).size();
+                c->drv       = drv;
+                c->params    = &params.at(k);
+                c->done      = epicsEventMustCreate(epicsEventEmpty);
+                c->pasynUser = pasynManager->createAsynUser(0, 0);
+
+                if (pasynManager->connectDevice(c->pasynUser, portName, 0) != asynSuccess)
+                    throw std::runtime_error("Can not connect to the driver port");
+
+                std::ostringstream name;
+                name << "load_" << kindNames[k] << i;
+                clients.push_back(c);
+
+                if (!epicsThreadCreate(name.str().c_str(),
+                        epicsThreadPriorityMedium,
+                        epicsThreadGetStackSize(epicsThreadStackMedium),
+                        (EPICSTHREADFUNC)clientTaskC,
+                        c))
+                    throw std::runtime_error("Can not create the client threads");
+            }
+        }
+
+        for (std::vector<Client*>::iterator it = clients.begin(); it != clients.end(); ++it)
+            epicsEventMustWait((*it)->done);
+
+        double elapsed = now() - start;
+
+        CAENHVSim_SetErrorRate(0);
+        counters.wrapperCallsPerSecond = CAENHVSim_GetCallCount("*") / elapsed;
+        counters.reconnects            = getCounter(drv, "DRV_RECONNECTS") - reconnects;
+        counters.overruns              = getCounter(drv, "DRV_POLL_MISSED") - overruns;
+
+        for (std::size_t k(0); k < NumKinds; ++k)
+            results.push_back(summarize(clients, static_cast<Kind>(k), s.groups.at(k), elapsed));
+
+        for (std::vector<Client*>::iterator it = clients.begin(); it != clients.end(); ++it)
+        {
+            pasynManager->disconnect((*it)->pasynUser);
+            pasynManager->freeAsynUser((*it)->pasynUser);
+            epicsEventDestroy((*it)->done);
+            delete *it;
+        }
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cerr << "Load test failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!s.output.empty())
+    {
+        file.open(s.output.c_str());
+        if (!file.is_open())
+        {
+            std::cerr << "Can not open output file '" << s.output << "'" << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& o = s.output.empty() ? std::cout : file;
+
+    if (s.format == "json")
+        writeJson(o, s, results, counters);
+    else
+        writeCsv(o, results, counters);
+
+    o.flush();
+
+    // The driver threads never exit
+    epicsExit(0);
+    return 0;
+}
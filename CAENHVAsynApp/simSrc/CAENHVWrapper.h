@@ -0,0 +1,158 @@
+#ifndef CAENHVWRAPPER_H
+#define CAENHVWRAPPER_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : CAENHVWrapper.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Simulated CAEN HV Wrapper library. This header declares the subset of the
+ * CAEN HV Wrapper API used by this module, with the same names, signatures
+ * and values as the original one, so the driver can be built against either.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+typedef int CAENHVRESULT;
+
+// Return codes
+#define CAENHV_OK                0
+#define CAENHV_SYSERR            1
+#define CAENHV_WRITEERR          2
+#define CAENHV_READERR           3
+#define CAENHV_TIMEERR           4
+#define CAENHV_DOWN              5
+#define CAENHV_NOTPRES           6
+#define CAENHV_SLOTNOTPRES       7
+#define CAENHV_NOSERIAL          8
+#define CAENHV_MEMORYFAULT       9
+#define CAENHV_OUTOFRANGE        10
+#define CAENHV_EXECCOMNOTIMPL    11
+#define CAENHV_GETPROPNOTIMPL    12
+#define CAENHV_SETPROPNOTIMPL    13
+#define CAENHV_PROPNOTFOUND      14
+#define CAENHV_EXECNOTFOUND      15
+#define CAENHV_NOTEXEC           16
+#define CAENHV_NOTGETPROP        17
+#define CAENHV_NOTSETPROP        18
+#define CAENHV_NOTEXECCOMM       19
+#define CAENHV_PARAMNOTFOUND     0x23
+#define CAENHV_INVALIDHANDLE     0x40
+
+// System types
+typedef enum
+{
+    SY1527  = 0,
+    SY2527  = 1,
+    SY4527  = 2,
+    SY5527  = 3,
+    N568    = 4,
+    V65XX   = 5,
+    N1470   = 6,
+    V8100   = 7,
+    N568E   = 8,
+    DT55XX  = 9,
+    FTK     = 10,
+    DT55XXE = 11,
+    N1068   = 12
+} CAENHV_SYSTEM_TYPE_t;
+
+// Link types
+#define LINKTYPE_TCPIP           0
+#define LINKTYPE_RS232           1
+#define LINKTYPE_CAENET          2
+#define LINKTYPE_USB             3
+#define LINKTYPE_OPTLINK         4
+#define LINKTYPE_USB_VCP         5
+
+// Name lengths
+#define MAX_PARAM_NAME           10
+#define MAX_CH_NAME              12
+
+// Parameter types
+#define PARAM_TYPE_NUMERIC       0
+#define PARAM_TYPE_ONOFF         1
+#define PARAM_TYPE_CHSTATUS      2
+#define PARAM_TYPE_BDSTATUS      3
+#define PARAM_TYPE_BINARY        4
+#define PARAM_TYPE_STRING        5
+#define PARAM_TYPE_ENUM          6
+
+// Parameter modes
+#define PARAM_MODE_RDONLY        0
+#define PARAM_MODE_WRONLY        1
+#define PARAM_MODE_RDWR          2
+
+// Parameter units
+#define PARAM_UN_NONE            0
+#define PARAM_UN_AMPERE          1
+#define PARAM_UN_VOLT            2
+#define PARAM_UN_WATT            3
+#define PARAM_UN_CELSIUS         4
+#define PARAM_UN_HERTZ           5
+#define PARAM_UN_BAR             6
+#define PARAM_UN_VPS             7
+#define PARAM_UN_SECOND          8
+#define PARAM_UN_RPM             9
+#define PARAM_UN_COUNT           10
+#define PARAM_UN_BIT             11
+
+// System property types
+#define SYSPROP_TYPE_STR         0
+#define SYSPROP_TYPE_REAL        1
+#define SYSPROP_TYPE_UINT2       2
+#define SYSPROP_TYPE_UINT4       3
+#define SYSPROP_TYPE_INT2        4
+#define SYSPROP_TYPE_INT4        5
+#define SYSPROP_TYPE_BOOLEAN     6
+
+// System property modes
+#define SYSPROP_MODE_RDONLY      0
+#define SYSPROP_MODE_WRONLY      1
+#define SYSPROP_MODE_RDWR        2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+CAENHVRESULT CAENHV_InitSystem(CAENHV_SYSTEM_TYPE_t system, int LinkType, void *Arg, const char *UserName, const char *Passwd, int *handle);
+CAENHVRESULT CAENHV_DeinitSystem(int handle);
+char*        CAENHV_GetError(int handle);
+CAENHVRESULT CAENHV_Free(void *arg);
+
+CAENHVRESULT CAENHV_GetCrateMap(int handle, unsigned short *NrOfSlot, unsigned short **NrofChList, char **ModelList, char **DescriptionList, unsigned short **SerNumList, unsigned char **FmwRelMinList, unsigned char **FmwRelMaxList);
+
+CAENHVRESULT CAENHV_GetSysPropList(int handle, unsigned short *NumProp, char **PropNameList);
+CAENHVRESULT CAENHV_GetSysPropInfo(int handle, const char *PropName, unsigned *PropMode, unsigned *PropType);
+CAENHVRESULT CAENHV_GetSysProp(int handle, const char *PropName, void *Result);
+CAENHVRESULT CAENHV_SetSysProp(int handle, const char *PropName, void *Set);
+
+CAENHVRESULT CAENHV_GetBdParamInfo(int handle, unsigned short slot, char **ParNameList);
+CAENHVRESULT CAENHV_GetBdParamProp(int handle, unsigned short slot, const char *ParName, const char *PropName, void *retval);
+CAENHVRESULT CAENHV_GetBdParam(int handle, unsigned short slotNum, const unsigned short *slotList, const char *ParName, void *ParValList);
+CAENHVRESULT CAENHV_SetBdParam(int handle, unsigned short slotNum, const unsigned short *slotList, const char *ParName, void *ParValue);
+
+CAENHVRESULT CAENHV_GetChParamInfo(int handle, unsigned short slot, unsigned short Ch, char **ParNameList, int *ParNumber);
+CAENHVRESULT CAENHV_GetChParamProp(int handle, unsigned short slot, unsigned short Ch, const char *ParName, const char *PropName, void *retval);
+CAENHVRESULT CAENHV_GetChParam(int handle, unsigned short slot, const char *ParName, unsigned short ChNum, const unsigned short *ChList, void *ParValList);
+CAENHVRESULT CAENHV_SetChParam(int handle, unsigned short slot, const char *ParName, unsigned short ChNum, const unsigned short *ChList, void *ParValue);
+
+CAENHVRESULT CAENHV_GetChName(int handle, unsigned short slot, unsigned short ChNum, const unsigned short *ChList, char (*ChNameList)[MAX_CH_NAME]);
+CAENHVRESULT CAENHV_SetChName(int handle, unsigned short slot, unsigned short ChNum, const unsigned short *ChList, const char *ChName);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
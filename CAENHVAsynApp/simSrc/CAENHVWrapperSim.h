@@ -0,0 +1,59 @@
+#ifndef CAENHVWRAPPERSIM_H
+#define CAENHVWRAPPERSIM_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : CAENHVWrapperSim.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Control interface of the simulated CAEN HV Wrapper library. These
+ * functions are not part of the CAEN HV Wrapper API: they are used by
+ * benchmarks and test applications to configure the simulation.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Load a configuration file. The crate layout is used by the crates
+// initialized after this call; the rest of the settings apply right away.
+// Returns 0 on success.
+int CAENHVSim_LoadConfig(const char *fileName);
+
+// Latency added to each wrapper call: 'base' plus a uniformly distributed
+// jitter in [-jitter, +jitter], plus 'perChannel' for each channel in a
+// multi-channel call. All in seconds.
+void CAENHVSim_SetLatency(double base, double jitter, double perChannel);
+
+// Probability, between 0 and 1, for each wrapper call to fail.
+void CAENHVSim_SetErrorRate(double p);
+
+// Make the next 'count' calls to 'function' fail. 'function' is the
+// wrapper function name (e.g. "CAENHV_GetChParam"), or "*" for any.
+void CAENHVSim_FailNext(const char *function, unsigned count);
+
+// Make the next call to 'function' hang for 'seconds', and then fail.
+void CAENHVSim_HangNext(const char *function, double seconds);
+
+// Number of calls done to 'function' ("*" for all) since the last reset.
+unsigned long CAENHVSim_GetCallCount(const char *function);
+void CAENHVSim_ResetCallCounts(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
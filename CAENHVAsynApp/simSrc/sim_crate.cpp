@@ -0,0 +1,553 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : sim_crate.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Simulated CAEN HV crate: layout, parameters and ramping physics
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <string.h>
+#include <stdio.h>
+#include "sim_crate.h"
+
+// Channel status bits
+static const uint32_t chStatusOn = 0x001;
+static const uint32_t chStatusRU = 0x002;
+static const uint32_t chStatusRD = 0x004;
+static const uint32_t chStatusOC = 0x008;
+static const uint32_t chStatusMV = 0x080;
+static const uint32_t chStatusIT = 0x200;
+
+// Board status bits
+static const uint32_t bdStatusUT = 0x010;
+static const uint32_t bdStatusOT = 0x020;
+
+// Trip times equal or above this value mean 'never trip'
+static const float tripInfinite = 1000;
+
+/////////////////
+// SimChannel  //
+/////////////////
+SimChannel::SimChannel(std::size_t c, float vMax, float iMax, float load)
+:
+    vMax(vMax),
+    iMax(iMax),
+    load(load),
+    vSet(0),
+    iSet(iMax),
+    rUp(50),
+    rDwn(50),
+    trip(tripInfinite),
+    svMax(vMax),
+    pw(false),
+    kill(false),
+    v(0),
+    overCurrent(false),
+    tripped(false),
+    last(SimClock::now()),
+    ocStart(last)
+{
+    char n[MAX_CH_NAME];
+    snprintf(n, sizeof(n), "CHANNEL%02zu", c);
+    name = n;
+}
+
+float SimChannel::target() const
+{
+    return pw ? std::min(vSet, svMax) : 0;
+}
+
+void SimChannel::update(SimClock::time_point now)
+{
+    double dt = std::chrono::duration<double>(now - last).count();
+    if (dt <= 0)
+        return;
+
+    last = now;
+
+    float t = target();
+
+    if (v < t)
+        v = std::min(t, static_cast<float>(v + rUp * dt));
+    else if (v > t)
+        v = std::max(t, static_cast<float>(v - rDwn * dt));
+
+    // The current is limited to I0Set: above that the voltage can not go
+    // higher, and the channel trips if it stays there for longer than 'Trip'.
+    float vLimit = iSet * load;
+    if ( pw && ( v >= vLimit ) && ( t > vLimit ) )
+    {
+        v = vLimit;
+
+        if (!overCurrent)
+        {
+            overCurrent = true;
+            ocStart     = now;
+        }
+        else if ( ( trip < tripInfinite ) && ( std::chrono::duration<double>(now - ocStart).count() >= trip ) )
+        {
+            pw          = false;
+            tripped     = true;
+            overCurrent = false;
+            if (kill)
+                v = 0;
+        }
+    }
+    else
+    {
+        overCurrent = false;
+    }
+}
+
+float SimChannel::getIMon() const
+{
+    return v / load;
+}
+
+uint32_t SimChannel::getStatus() const
+{
+    uint32_t s(0);
+    float t = target();
+
+    if (pw)
+        s |= chStatusOn;
+
+    if ( pw && ( v < t ) && !overCurrent )
+        s |= chStatusRU;
+
+    if (v > t)
+        s |= chStatusRD;
+
+    if (overCurrent)
+        s |= chStatusOC;
+
+    if (vSet > svMax)
+        s |= chStatusMV;
+
+    if (tripped)
+        s |= chStatusIT;
+
+    return s;
+}
+
+CAENHVRESULT SimChannel::get(const std::string& param, void* value, float dv, float di) const
+{
+    float*    f = static_cast<float*>(value);
+    uint32_t* u = static_cast<uint32_t*>(value);
+
+    if      (param == "V0Set")  *f = vSet;
+    else if (param == "I0Set")  *f = iSet;
+    else if (param == "RUp")    *f = rUp;
+    else if (param == "RDWn")   *f = rDwn;
+    else if (param == "Trip")   *f = trip;
+    else if (param == "SVMax")  *f = svMax;
+    else if (param == "VMon")   *f = std::max(0.0f, v + dv);
+    else if (param == "IMon")   *f = std::max(0.0f, getIMon() + di);
+    else if (param == "Pw")     *u = pw ? 1 : 0;
+    else if (param == "PDwn")   *u = kill ? 0 : 1;
+    else if (param == "Status") *u = getStatus();
+    else
+        return CAENHV_PARAMNOTFOUND;
+
+    return CAENHV_OK;
+}
+
+CAENHVRESULT SimChannel::set(const std::string& param, const void* value)
+{
+    float    f = *static_cast<const float*>(value);
+    uint32_t u = *static_cast<const uint32_t*>(value);
+
+    if      (param == "V0Set") { if ( f < 0 || f > vMax )         return CAENHV_OUTOFRANGE; vSet  = f; }
+    else if (param == "I0Set") { if ( f < 0 || f > iMax )         return CAENHV_OUTOFRANGE; iSet  = f; }
+    else if (param == "RUp")   { if ( f < 1 || f > 500 )          return CAENHV_OUTOFRANGE; rUp   = f; }
+    else if (param == "RDWn")  { if ( f < 1 || f > 500 )          return CAENHV_OUTOFRANGE; rDwn  = f; }
+    else if (param == "Trip")  { if ( f < 0 || f > tripInfinite ) return CAENHV_OUTOFRANGE; trip  = f; }
+    else if (param == "SVMax") { if ( f < 0 || f > vMax )         return CAENHV_OUTOFRANGE; svMax = f; }
+    else if (param == "PDwn")  { kill = ( u == 0 ); }
+    else if (param == "Pw")
+    {
+        pw = ( u != 0 );
+
+        // Turning a channel on clears the trip condition
+        if (pw)
+            tripped = false;
+        else if (kill)
+            v = 0;
+    }
+    else if ( param == "VMon" || param == "IMon" || param == "Status" )
+        return CAENHV_NOTSETPROP;
+    else
+        return CAENHV_PARAMNOTFOUND;
+
+    return CAENHV_OK;
+}
+
+/////////////////
+// SimBoard    //
+/////////////////
+SimBoard::SimBoard(const SimBoardConfig& c, uint16_t serial)
+:
+    model(c.model),
+    description(" " + c.model + " HV Board (simulated)"),
+    serial(serial),
+    fwMin(0),
+    fwMax(1),
+    vMax(c.vMax),
+    iMax(c.iMax),
+    baseTemp(c.temp),
+    temp(c.temp)
+{
+    SimParamDef bd[] =
+    {
+        { "BdStatus", PARAM_TYPE_BDSTATUS, PARAM_MODE_RDONLY, 0,   0,    PARAM_UN_NONE,    0, "", "" },
+        { "Temp",     PARAM_TYPE_NUMERIC,  PARAM_MODE_RDONLY, -20, 100,  PARAM_UN_CELSIUS, 0, "", "" },
+        { "HVMax",    PARAM_TYPE_NUMERIC,  PARAM_MODE_RDONLY, 0,   vMax, PARAM_UN_VOLT,    0, "", "" },
+    };
+    bdParams.assign(bd, bd + sizeof(bd) / sizeof(bd[0]));
+
+    SimParamDef ch[] =
+    {
+        { "V0Set",  PARAM_TYPE_NUMERIC,  PARAM_MODE_RDWR,   0, vMax,         PARAM_UN_VOLT,    0,  "",     ""     },
+        { "I0Set",  PARAM_TYPE_NUMERIC,  PARAM_MODE_RDWR,   0, iMax,         PARAM_UN_AMPERE,  -6, "",     ""     },
+        { "RUp",    PARAM_TYPE_NUMERIC,  PARAM_MODE_RDWR,   1, 500,          PARAM_UN_VPS,     0,  "",     ""     },
+        { "RDWn",   PARAM_TYPE_NUMERIC,  PARAM_MODE_RDWR,   1, 500,          PARAM_UN_VPS,     0,  "",     ""     },
+        { "Trip",   PARAM_TYPE_NUMERIC,  PARAM_MODE_RDWR,   0, tripInfinite, PARAM_UN_SECOND,  0,  "",     ""     },
+        { "SVMax",  PARAM_TYPE_NUMERIC,  PARAM_MODE_RDWR,   0, vMax,         PARAM_UN_VOLT,    0,  "",     ""     },
+        { "VMon",   PARAM_TYPE_NUMERIC,  PARAM_MODE_RDONLY, 0, vMax,         PARAM_UN_VOLT,    0,  "",     ""     },
+        { "IMon",   PARAM_TYPE_NUMERIC,  PARAM_MODE_RDONLY, 0, iMax,         PARAM_UN_AMPERE,  -6, "",     ""     },
+        { "Pw",     PARAM_TYPE_ONOFF,    PARAM_MODE_RDWR,   0, 1,            PARAM_UN_NONE,    0,  "On",   "Off"  },
+        { "PDwn",   PARAM_TYPE_ONOFF,    PARAM_MODE_RDWR,   0, 1,            PARAM_UN_NONE,    0,  "Ramp", "Kill" },
+        { "Status", PARAM_TYPE_CHSTATUS, PARAM_MODE_RDONLY, 0, 0,            PARAM_UN_NONE,    0,  "",     ""     },
+    };
+    chParams.assign(ch, ch + sizeof(ch) / sizeof(ch[0]));
+
+    for (std::size_t i(0); i < c.numChannels; ++i)
+        channels.push_back( SimChannel(i, vMax, iMax, c.load) );
+
+    for (std::vector< std::pair<std::size_t, float> >::const_iterator it = c.loads.begin(); it != c.loads.end(); ++it)
+        if (it->first < channels.size())
+            channels.at(it->first).setLoad(it->second);
+}
+
+const SimParamDef* SimBoard::findParamDef(const std::vector<SimParamDef>& defs, const std::string& name)
+{
+    for (std::vector<SimParamDef>::const_iterator it = defs.begin(); it != defs.end(); ++it)
+        if (it->name == name)
+            return &(*it);
+
+    return NULL;
+}
+
+CAENHVRESULT SimBoard::getParamProp(const SimParamDef* def, const std::string& prop, void* value)
+{
+    if (!def)
+        return CAENHV_PARAMNOTFOUND;
+
+    if      (prop == "Type")     *static_cast<uint32_t*>(value) = def->type;
+    else if (prop == "Mode")     *static_cast<uint32_t*>(value) = def->mode;
+    else if (def->type == PARAM_TYPE_NUMERIC && prop == "Minval") *static_cast<float*>(value)    = def->minVal;
+    else if (def->type == PARAM_TYPE_NUMERIC && prop == "Maxval") *static_cast<float*>(value)    = def->maxVal;
+    else if (def->type == PARAM_TYPE_NUMERIC && prop == "Unit")   *static_cast<uint16_t*>(value) = def->unit;
+    // The exponent is written as a single byte, which is how the driver reads it
+    else if (def->type == PARAM_TYPE_NUMERIC && prop == "Exp")    *static_cast<int8_t*>(value)   = def->exp;
+    else if (def->type == PARAM_TYPE_ONOFF   && prop == "Onstate")  strcpy(static_cast<char*>(value), def->onState.c_str());
+    else if (def->type == PARAM_TYPE_ONOFF   && prop == "Offstate") strcpy(static_cast<char*>(value), def->offState.c_str());
+    else
+        return CAENHV_PROPNOTFOUND;
+
+    return CAENHV_OK;
+}
+
+void SimBoard::update(SimClock::time_point now)
+{
+    // The board heats up with the power delivered by its channels
+    float power(0);
+    for (std::vector<SimChannel>::iterator it = channels.begin(); it != channels.end(); ++it)
+    {
+        it->update(now);
+        power += it->getPower();
+    }
+
+    temp = baseTemp + power;
+}
+
+CAENHVRESULT SimBoard::getBdParam(const std::string& param, void* value) const
+{
+    if (param == "BdStatus")
+    {
+        uint32_t s(0);
+
+        if (temp > 65)
+            s |= bdStatusOT;
+
+        if (temp < 5)
+            s |= bdStatusUT;
+
+        *static_cast<uint32_t*>(value) = s;
+    }
+    else if (param == "Temp")
+        *static_cast<float*>(value) = temp;
+    else if (param == "HVMax")
+        *static_cast<float*>(value) = vMax;
+    else
+        return CAENHV_PARAMNOTFOUND;
+
+    return CAENHV_OK;
+}
+
+CAENHVRESULT SimBoard::setBdParam(const std::string& param, const void* value)
+{
+    if (findParamDef(bdParams, param))
+        return CAENHV_NOTSETPROP;
+
+    return CAENHV_PARAMNOTFOUND;
+}
+
+/////////////////
+// SimCrate    //
+/////////////////
+SimCrate::SimCrate(const SimCrateConfig& c, CAENHV_SYSTEM_TYPE_t t, const std::string& arg)
+:
+    numSlots(c.numSlots),
+    boards(c.numSlots),
+    vNoise(c.vNoise),
+    iNoise(c.iNoise),
+    ipAddr(arg),
+    symbolicName("simcrate"),
+    genSignCfg(0),
+    rng(12345)
+{
+    switch (t)
+    {
+        case SY1527: modelName = "SY1527"; break;
+        case SY2527: modelName = "SY2527"; break;
+        case SY5527: modelName = "SY5527"; break;
+        default:     modelName = "SY4527"; break;
+    }
+
+    uint16_t serial(1000);
+    for (std::vector<SimBoardConfig>::const_iterator it = c.boards.begin(); it != c.boards.end(); ++it)
+        if (it->slot < numSlots)
+            boards.at(it->slot) = std::make_shared<SimBoard>(*it, serial++);
+}
+
+const std::vector<SimPropDef>& SimCrate::getSysPropDefs()
+{
+    static const SimPropDef defs[] =
+    {
+        { "ModelName",    SYSPROP_TYPE_STR,   SYSPROP_MODE_RDONLY },
+        { "SwRelease",    SYSPROP_TYPE_STR,   SYSPROP_MODE_RDONLY },
+        { "SymbolicName", SYSPROP_TYPE_STR,   SYSPROP_MODE_RDWR   },
+        { "IPAddr",       SYSPROP_TYPE_STR,   SYSPROP_MODE_RDONLY },
+        { "HVClkConf",    SYSPROP_TYPE_STR,   SYSPROP_MODE_RDONLY },
+        { "CPULoad",      SYSPROP_TYPE_STR,   SYSPROP_MODE_RDONLY },
+        { "ClkFreq",      SYSPROP_TYPE_INT2,  SYSPROP_MODE_RDONLY },
+        { "GenSignCfg",   SYSPROP_TYPE_UINT2, SYSPROP_MODE_RDWR   },
+        { "FrontPanIn",   SYSPROP_TYPE_UINT2, SYSPROP_MODE_RDONLY },
+    };
+    static const std::vector<SimPropDef> list(defs, defs + sizeof(defs) / sizeof(defs[0]));
+
+    return list;
+}
+
+const SimPropDef* SimCrate::findPropDef(const std::string& name)
+{
+    const std::vector<SimPropDef>& defs = getSysPropDefs();
+    for (std::vector<SimPropDef>::const_iterator it = defs.begin(); it != defs.end(); ++it)
+        if (it->name == name)
+            return &(*it);
+
+    return NULL;
+}
+
+void SimCrate::update()
+{
+    SimClock::time_point now = SimClock::now();
+
+    for (std::vector< std::shared_ptr<SimBoard> >::iterator it = boards.begin(); it != boards.end(); ++it)
+        if (*it)
+            (*it)->update(now);
+}
+
+SimBoard* SimCrate::getBoard(std::size_t slot)
+{
+    if (slot >= boards.size())
+        return NULL;
+
+    return boards.at(slot).get();
+}
+
+CAENHVRESULT SimCrate::getSysProp(const std::string& prop, void* value) const
+{
+    const SimPropDef* def = findPropDef(prop);
+
+    if (!def)
+        return CAENHV_PROPNOTFOUND;
+
+    if (def->mode == SYSPROP_MODE_WRONLY)
+        return CAENHV_NOTGETPROP;
+
+    char* s = static_cast<char*>(value);
+
+    if      (prop == "ModelName")    strcpy(s, modelName.c_str());
+    else if (prop == "SwRelease")    strcpy(s, "1.0.0-sim");
+    else if (prop == "SymbolicName") strcpy(s, symbolicName.c_str());
+    else if (prop == "IPAddr")       strcpy(s, ipAddr.c_str());
+    else if (prop == "HVClkConf")    strcpy(s, "Internal");
+    else if (prop == "CPULoad")      strcpy(s, "5");
+    else if (prop == "ClkFreq")      *static_cast<int16_t*>(value)  = 2;
+    else if (prop == "GenSignCfg")   *static_cast<uint16_t*>(value) = genSignCfg;
+    else if (prop == "FrontPanIn")   *static_cast<uint16_t*>(value) = 0;
+
+    return CAENHV_OK;
+}
+
+CAENHVRESULT SimCrate::setSysProp(const std::string& prop, const void* value)
+{
+    const SimPropDef* def = findPropDef(prop);
+
+    if (!def)
+        return CAENHV_PROPNOTFOUND;
+
+    if (def->mode == SYSPROP_MODE_RDONLY)
+        return CAENHV_NOTSETPROP;
+
+    if      (prop == "SymbolicName") symbolicName = static_cast<const char*>(value);
+    else if (prop == "GenSignCfg")   genSignCfg   = *static_cast<const uint16_t*>(value);
+
+    return CAENHV_OK;
+}
+
+float SimCrate::noise(float amplitude)
+{
+    if (amplitude <= 0)
+        return 0;
+
+    std::uniform_real_distribution<float> d(-amplitude, amplitude);
+    return d(rng);
+}
+
+//////////////////////////
+// Configuration parser //
+//////////////////////////
+bool simParseConfig(const std::string& fileName, SimCrateConfig& crate,
+                    double& latency, double& jitter, double& perChannel, double& errorRate,
+                    std::string& error)
+{
+    std::ifstream file(fileName.c_str());
+    if (!file.is_open())
+    {
+        error = "Can not open file '" + fileName + "'";
+        return false;
+    }
+
+    SimCrateConfig c;
+    c.numSlots = 0;
+
+    std::string line;
+    for (std::size_t n(1); std::getline(file, line); ++n)
+    {
+        // Remove comments
+        std::size_t pos = line.find('#');
+        if (pos != std::string::npos)
+            line.erase(pos);
+
+        std::istringstream ss(line);
+        std::string key;
+        if (!(ss >> key))
+            continue;
+
+        bool ok(true);
+
+        if (key == "slots")
+        {
+            ok = static_cast<bool>(ss >> c.numSlots);
+        }
+        else if (key == "board")
+        {
+            SimBoardConfig b;
+            ok = static_cast<bool>(ss >> b.slot >> b.model >> b.numChannels);
+            if (ok)
+            {
+                // Optional: vMax, iMax, load, temperature
+                ss >> b.vMax >> b.iMax >> b.load >> b.temp;
+                c.boards.push_back(b);
+            }
+        }
+        else if (key == "load")
+        {
+            std::size_t slot, channel;
+            float load;
+            ok = static_cast<bool>(ss >> slot >> channel >> load);
+            if (ok)
+            {
+                ok = false;
+                for (std::vector<SimBoardConfig>::iterator it = c.boards.begin(); it != c.boards.end(); ++it)
+                {
+                    if (it->slot == slot)
+                    {
+                        it->loads.push_back( std::make_pair(channel, load) );
+                        ok = true;
+                    }
+                }
+            }
+        }
+        else if (key == "noise")
+        {
+            ok = static_cast<bool>(ss >> c.vNoise >> c.iNoise);
+        }
+        else if (key == "latency")
+        {
+            // In ms, ms, and us
+            double l, j, p(0);
+            ok = static_cast<bool>(ss >> l >> j);
+            if (ok)
+            {
+                ss >> p;
+                latency    = l * 1e-3;
+                jitter     = j * 1e-3;
+                perChannel = p * 1e-6;
+            }
+        }
+        else if (key == "error_rate")
+        {
+            ok = static_cast<bool>(ss >> errorRate);
+        }
+        else
+        {
+            ok = false;
+        }
+
+        if (!ok)
+        {
+            std::ostringstream msg;
+            msg << fileName << ":" << n << ": invalid line '" << line << "'";
+            error = msg.str();
+            return false;
+        }
+    }
+
+    // If the number of slots was not given, use the minimum needed
+    if (c.numSlots == 0)
+        for (std::vector<SimBoardConfig>::const_iterator it = c.boards.begin(); it != c.boards.end(); ++it)
+            c.numSlots = std::max(c.numSlots, it->slot + 1);
+
+    crate = c;
+    return true;
+}
@@ -0,0 +1,181 @@
+#ifndef SIM_CRATE_H
+#define SIM_CRATE_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : sim_crate.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Simulated CAEN HV crate: layout, parameters and ramping physics
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <chrono>
+#include <stdint.h>
+#include "CAENHVWrapper.h"
+
+typedef std::chrono::steady_clock SimClock;
+
+// Description of a board or channel parameter
+struct SimParamDef
+{
+    std::string name;
+    unsigned    type;
+    unsigned    mode;
+    float       minVal;
+    float       maxVal;
+    uint16_t    unit;
+    int8_t      exp;
+    std::string onState;
+    std::string offState;
+};
+
+// Description of a system property
+struct SimPropDef
+{
+    std::string name;
+    unsigned    type;
+    unsigned    mode;
+};
+
+// Layout of a board, as given in the configuration
+struct SimBoardConfig
+{
+    SimBoardConfig() : slot(0), numChannels(24), vMax(3500), iMax(3000), load(10), temp(30) {};
+
+    std::size_t slot;
+    std::string model;
+    std::size_t numChannels;
+    float       vMax;  // V
+    float       iMax;  // uA
+    float       load;  // MOhm, default for all the channels
+    float       temp;  // Celsius, with all the channels off
+    std::vector< std::pair<std::size_t, float> > loads; // Per-channel loads
+};
+
+// Layout of a crate, as given in the configuration
+struct SimCrateConfig
+{
+    SimCrateConfig() : numSlots(16), vNoise(0.05), iNoise(0.005) {};
+
+    std::size_t                 numSlots;
+    float                       vNoise; // VMon noise amplitude, V
+    float                       iNoise; // IMon noise amplitude, uA
+    std::vector<SimBoardConfig> boards;
+};
+
+// A channel, with its ramping and trip physics. The state is advanced
+// lazily, every time the channel is accessed.
+class SimChannel
+{
+public:
+    SimChannel(std::size_t c, float vMax, float iMax, float load);
+
+    void setLoad(float l) { load = l; };
+
+    // Advance the state up to 'now'
+    void update(SimClock::time_point now);
+
+    float    getVMon()   const { return v; };
+    float    getIMon()   const;
+    uint32_t getStatus() const;
+    float    getPower()  const { return pw ? v * getIMon() * 1e-6 : 0; }; // W
+
+    // 'dv' and 'di' are the noise added to VMon and IMon
+    CAENHVRESULT get(const std::string& param, void* value, float dv, float di) const;
+    CAENHVRESULT set(const std::string& param, const void* value);
+
+    std::string name;
+
+private:
+    // Voltage the channel is going to
+    float target() const;
+
+    float    vMax, iMax, load;
+    float    vSet, iSet, rUp, rDwn, trip, svMax;
+    bool     pw, kill;
+    float    v;
+    bool     overCurrent, tripped;
+    SimClock::time_point last, ocStart;
+};
+
+class SimBoard
+{
+public:
+    SimBoard(const SimBoardConfig& c, uint16_t serial);
+
+    // Parameter definitions. Ranges depend on the board.
+    static const SimParamDef* findParamDef(const std::vector<SimParamDef>& defs, const std::string& name);
+    static CAENHVRESULT getParamProp(const SimParamDef* def, const std::string& prop, void* value);
+
+    void update(SimClock::time_point now);
+
+    CAENHVRESULT getBdParam(const std::string& param, void* value) const;
+    CAENHVRESULT setBdParam(const std::string& param, const void* value);
+
+    std::string model, description;
+    uint16_t    serial;
+    uint8_t     fwMin, fwMax;
+    float       vMax, iMax, baseTemp, temp;
+
+    std::vector<SimParamDef> bdParams;
+    std::vector<SimParamDef> chParams;
+    std::vector<SimChannel>  channels;
+};
+
+class SimCrate
+{
+public:
+    SimCrate(const SimCrateConfig& c, CAENHV_SYSTEM_TYPE_t t, const std::string& arg);
+
+    static const std::vector<SimPropDef>& getSysPropDefs();
+    static const SimPropDef* findPropDef(const std::string& name);
+
+    // Advance the state of all the boards up to now
+    void update();
+
+    // Get a board, or NULL if the slot is empty or out of range
+    SimBoard* getBoard(std::size_t slot);
+
+    CAENHVRESULT getSysProp(const std::string& prop, void* value) const;
+    CAENHVRESULT setSysProp(const std::string& prop, const void* value);
+
+    // Uniformly distributed noise in [-amplitude, amplitude]
+    float noise(float amplitude);
+
+    // All the calls on a crate are serialized
+    std::mutex mutex;
+
+    std::size_t numSlots;
+    std::vector< std::shared_ptr<SimBoard> > boards;
+    float       vNoise, iNoise;
+
+private:
+    std::string  modelName, ipAddr, symbolicName;
+    uint16_t     genSignCfg;
+    std::mt19937 rng;
+};
+
+// Parse a configuration file. Returns false on error, with a description in 'error'.
+bool simParseConfig(const std::string& fileName, SimCrateConfig& crate,
+                    double& latency, double& jitter, double& perChannel, double& errorRate,
+                    std::string& error);
+
+#endif
@@ -0,0 +1,794 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : sim_wrapper.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Simulated CAEN HV Wrapper library: CAEN HV Wrapper API and control
+ * interface on top of the simulated crates.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <map>
+#include <thread>
+#include <fstream>
+#include <iostream>
+#include <string.h>
+#include <stdlib.h>
+#include "CAENHVWrapper.h"
+#include "CAENHVWrapperSim.h"
+#include "sim_crate.h"
+
+namespace
+{
+    const std::size_t maxErrorLength = 256;
+
+    // An open connection to a crate
+    struct Handle
+    {
+        std::shared_ptr<SimCrate> crate;           // NULL when closed
+        char                      error[maxErrorLength];
+    };
+
+    // Global simulator state. The crates are kept across connections, so
+    // that a reconnection finds the channels as they were left.
+    std::mutex                                         stateMutex;
+    bool                                               initialized(false);
+    SimCrateConfig                                     layout;
+    double                                             latency(2e-3);
+    double                                             jitter(1e-3);
+    double                                             perChannel(20e-6);
+    double                                             errorRate(0);
+    std::map<std::string, unsigned>                    failNext;
+    std::map<std::string, double>                      hangNext;
+    std::map<std::string, unsigned long>               callCounts;
+    unsigned long                                      totalCalls(0);
+    std::map<std::string, std::shared_ptr<SimCrate> >  crates;
+    std::map<int, Handle>                              handles;
+    char                                               initError[maxErrorLength] = "Invalid handle";
+    std::mt19937                                       rng(54321);
+
+    // Default layout, used when no configuration file is given
+    void setDefaultLayout()
+    {
+        layout = SimCrateConfig();
+
+        SimBoardConfig b;
+        b.model       = "A1535";
+        b.numChannels = 24;
+        b.slot        = 0;
+        layout.boards.push_back(b);
+        b.slot        = 1;
+        layout.boards.push_back(b);
+
+        b.model       = "A1526";
+        b.numChannels = 6;
+        b.vMax        = 15000;
+        b.iMax        = 1000;
+        b.load        = 100;
+        b.slot        = 3;
+        layout.boards.push_back(b);
+    }
+
+    // Must be called with the state mutex held
+    bool loadConfig(const std::string& fileName)
+    {
+        std::string error;
+        SimCrateConfig c;
+        double l(latency), j(jitter), p(perChannel), e(errorRate);
+
+        if (!simParseConfig(fileName, c, l, j, p, e, error))
+        {
+            std::cerr << "CAENHVWrapperSim: " << error << std::endl;
+            return false;
+        }
+
+        layout     = c;
+        latency    = l;
+        jitter     = j;
+        perChannel = p;
+        errorRate  = e;
+
+        return true;
+    }
+
+    // Must be called with the state mutex held
+    void init()
+    {
+        if (initialized)
+            return;
+
+        initialized = true;
+        setDefaultLayout();
+
+        const char* fileName = getenv("CAENHVSIM_CONFIG");
+        if (fileName)
+            loadConfig(fileName);
+    }
+
+    // Must be called with the state mutex held
+    bool takeInjection(std::map<std::string, unsigned>& m, const std::string& function)
+    {
+        const std::string keys[] = { function, "*" };
+
+        for (std::size_t i(0); i < 2; ++i)
+        {
+            std::map<std::string, unsigned>::iterator it = m.find(keys[i]);
+            if ( ( it != m.end() ) && ( it->second > 0 ) )
+            {
+                --(it->second);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Must be called with the state mutex held
+    double takeHang(const std::string& function)
+    {
+        const std::string keys[] = { function, "*" };
+
+        for (std::size_t i(0); i < 2; ++i)
+        {
+            std::map<std::string, double>::iterator it = hangNext.find(keys[i]);
+            if (it != hangNext.end())
+            {
+                double t = it->second;
+                hangNext.erase(it);
+                return t;
+            }
+        }
+
+        return 0;
+    }
+
+    void setError(char* buffer, const std::string& msg)
+    {
+        strncpy(buffer, msg.c_str(), maxErrorLength - 1);
+        buffer[maxErrorLength - 1] = '\0';
+    }
+
+    void setError(int handle, const std::string& msg)
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+
+        std::map<int, Handle>::iterator it = handles.find(handle);
+        if (it != handles.end())
+            setError(it->second.error, msg);
+    }
+
+    // Simulates the communication with the crate: counts the call, and
+    // applies the latency and the injected errors. On success, 'crate' is
+    // set to the crate behind 'handle'.
+    CAENHVRESULT beginCall(const char* function, int handle, std::size_t numChannels, std::shared_ptr<SimCrate>& crate)
+    {
+        double delay, hang;
+        bool fail;
+
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            init();
+
+            ++callCounts[function];
+            ++totalCalls;
+
+            std::map<int, Handle>::iterator it = handles.find(handle);
+            if ( ( it == handles.end() ) || ( !it->second.crate ) )
+                return CAENHV_INVALIDHANDLE;
+
+            crate = it->second.crate;
+
+            hang = takeHang(function);
+            fail = takeInjection(failNext, function);
+
+            std::uniform_real_distribution<double> u(0, 1);
+            if ( ( errorRate > 0 ) && ( u(rng) < errorRate ) )
+                fail = true;
+
+            std::uniform_real_distribution<double> j(-jitter, jitter);
+            delay = latency + ( ( jitter > 0 ) ? j(rng) : 0 ) + perChannel * numChannels;
+        }
+
+        if (hang > 0)
+        {
+            std::this_thread::sleep_for(std::chrono::duration<double>(hang));
+            setError(handle, std::string(function) + ": communication timeout (simulated hang)");
+            return CAENHV_TIMEERR;
+        }
+
+        if (delay > 0)
+            std::this_thread::sleep_for(std::chrono::duration<double>(delay));
+
+        if (fail)
+        {
+            setError(handle, std::string(function) + ": communication error (simulated)");
+            return CAENHV_TIMEERR;
+        }
+
+        return CAENHV_OK;
+    }
+
+    // Sets the error message of the call, based on its result
+    CAENHVRESULT endCall(const char* function, int handle, CAENHVRESULT r)
+    {
+        std::string msg;
+
+        switch (r)
+        {
+            case CAENHV_OK:             msg = "Command Successfully Executed"; break;
+            case CAENHV_SLOTNOTPRES:    msg = "Slot is not present";           break;
+            case CAENHV_OUTOFRANGE:     msg = "Value out of range";            break;
+            case CAENHV_PROPNOTFOUND:   msg = "Property not found";            break;
+            case CAENHV_PARAMNOTFOUND:  msg = "Parameter not found";           break;
+            case CAENHV_NOTGETPROP:     msg = "Property is write only";        break;
+            case CAENHV_NOTSETPROP:     msg = "Read only";                     break;
+            default:                    msg = "Error";                         break;
+        }
+
+        if (r != CAENHV_OK)
+            msg = std::string(function) + ": " + msg;
+
+        setError(handle, msg);
+
+        return r;
+    }
+
+    // Copies a list of names into a malloc'ed array of fixed length entries,
+    // terminated with an empty entry.
+    char* makeNameArray(const std::vector<SimParamDef>& defs)
+    {
+        char* list = static_cast<char*>(calloc(defs.size() + 1, MAX_PARAM_NAME));
+
+        for (std::size_t i(0); i < defs.size(); ++i)
+            strncpy(list + i * MAX_PARAM_NAME, defs.at(i).name.c_str(), MAX_PARAM_NAME - 1);
+
+        return list;
+    }
+}
+
+///////////////////////////
+// CAEN HV Wrapper API   //
+///////////////////////////
+CAENHVRESULT CAENHV_InitSystem(CAENHV_SYSTEM_TYPE_t system, int LinkType, void *Arg, const char *UserName, const char *Passwd, int *handle)
+{
+    std::string arg( Arg ? static_cast<const char*>(Arg) : "" );
+    double delay;
+    bool fail;
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        init();
+
+        ++callCounts["CAENHV_InitSystem"];
+        ++totalCalls;
+
+        fail  = takeInjection(failNext, "CAENHV_InitSystem");
+        delay = latency;
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(delay));
+
+    std::lock_guard<std::mutex> lock(stateMutex);
+
+    if (fail)
+    {
+        setError(initError, "CAENHV_InitSystem: login failed (simulated)");
+        return CAENHV_SYSERR;
+    }
+
+    // If the argument is the name of a configuration file, use it
+    std::map<std::string, std::shared_ptr<SimCrate> >::iterator cIt = crates.find(arg);
+    if (cIt == crates.end())
+    {
+        SimCrateConfig c(layout);
+        double l(latency), j(jitter), p(perChannel), e(errorRate);
+        std::string error;
+
+        if (std::ifstream(arg.c_str()).good() && simParseConfig(arg, c, l, j, p, e, error))
+        {
+            latency    = l;
+            jitter     = j;
+            perChannel = p;
+            errorRate  = e;
+        }
+        else
+        {
+            c = layout;
+        }
+
+        cIt = crates.insert( std::make_pair(arg, std::make_shared<SimCrate>(c, system, arg)) ).first;
+    }
+
+    // Reuse the lowest free handle number, as the original library does
+    int h(0);
+    while ( ( handles.find(h) != handles.end() ) && handles[h].crate )
+        ++h;
+
+    handles[h].crate = cIt->second;
+    setError(handles[h].error, "Command Successfully Executed");
+    setError(initError, "Command Successfully Executed");
+
+    *handle = h;
+
+    return CAENHV_OK;
+}
+
+CAENHVRESULT CAENHV_DeinitSystem(int handle)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+
+    ++callCounts["CAENHV_DeinitSystem"];
+    ++totalCalls;
+
+    std::map<int, Handle>::iterator it = handles.find(handle);
+    if ( ( it == handles.end() ) || ( !it->second.crate ) )
+        return CAENHV_INVALIDHANDLE;
+
+    // The entry is kept, so pointers returned by CAENHV_GetError stay valid
+    it->second.crate.reset();
+
+    return CAENHV_OK;
+}
+
+char* CAENHV_GetError(int handle)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+
+    std::map<int, Handle>::iterator it = handles.find(handle);
+    if (it == handles.end())
+        return initError;
+
+    return it->second.error;
+}
+
+CAENHVRESULT CAENHV_Free(void *arg)
+{
+    free(arg);
+    return CAENHV_OK;
+}
+
+CAENHVRESULT CAENHV_GetCrateMap(int handle, unsigned short *NrOfSlot, unsigned short **NrofChList, char **ModelList, char **DescriptionList, unsigned short **SerNumList, unsigned char **FmwRelMinList, unsigned char **FmwRelMaxList)
+{
+    const char* function("CAENHV_GetCrateMap");
+    std::shared_ptr<SimCrate> crate;
+
+    CAENHVRESULT r = beginCall(function, handle, 0, crate);
+    if (r != CAENHV_OK)
+        return r;
+
+    std::lock_guard<std::mutex> lock(crate->mutex);
+
+    std::size_t n(crate->numSlots);
+    std::string models, descriptions;
+
+    *NrOfSlot      = n;
+    *NrofChList    = static_cast<unsigned short*>(calloc(n, sizeof(unsigned short)));
+    *SerNumList    = static_cast<unsigned short*>(calloc(n, sizeof(unsigned short)));
+    *FmwRelMinList = static_cast<unsigned char*>(calloc(n, sizeof(unsigned char)));
+    *FmwRelMaxList = static_cast<unsigned char*>(calloc(n, sizeof(unsigned char)));
+
+    // Model and description lists are sequences of null terminated strings,
+    // with empty strings for empty slots
+    for (std::size_t i(0); i < n; ++i)
+    {
+        SimBoard* b = crate->getBoard(i);
+
+        if (b)
+        {
+            (*NrofChList)[i]    = b->channels.size();
+            (*SerNumList)[i]    = b->serial;
+            (*FmwRelMinList)[i] = b->fwMin;
+            (*FmwRelMaxList)[i] = b->fwMax;
+            models.append(b->model);
+            descriptions.append(b->description);
+        }
+
+        models.push_back('\0');
+        descriptions.push_back('\0');
+    }
+
+    *ModelList       = static_cast<char*>(malloc(models.size()));
+    *DescriptionList = static_cast<char*>(malloc(descriptions.size()));
+    memcpy(*ModelList, models.data(), models.size());
+    memcpy(*DescriptionList, descriptions.data(), descriptions.size());
+
+    return endCall(function, handle, CAENHV_OK);
+}
+
+CAENHVRESULT CAENHV_GetSysPropList(int handle, unsigned short *NumProp, char **PropNameList)
+{
+    const char* function("CAENHV_GetSysPropList");
+    std::shared_ptr<SimCrate> crate;
+
+    CAENHVRESULT r = beginCall(function, handle, 0, crate);
+    if (r != CAENHV_OK)
+        return r;
+
+    const std::vector<SimPropDef>& defs = SimCrate::getSysPropDefs();
+    std::string names;
+
+    for (std::vector<SimPropDef>::const_iterator it = defs.begin(); it != defs.end(); ++it)
+    {
+        names.append(it->name);
+        names.push_back('\0');
+    }
+
+    *NumProp      = defs.size();
+    *PropNameList = static_cast<char*>(malloc(names.size()));
+    memcpy(*PropNameList, names.data(), names.size());
+
+    return endCall(function, handle, CAENHV_OK);
+}
+
+CAENHVRESULT CAENHV_GetSysPropInfo(int handle, const char *PropName, unsigned *PropMode, unsigned *PropType)
+{
+    const char* function("CAENHV_GetSysPropInfo");
+    std::shared_ptr<SimCrate> crate;
+
+    CAENHVRESULT r = beginCall(function, handle, 0, crate);
+    if (r != CAENHV_OK)
+        return r;
+
+    const SimPropDef* def = SimCrate::findPropDef(PropName);
+    if (!def)
+        return endCall(function, handle, CAENHV_PROPNOTFOUND);
+
+    *PropMode = def->mode;
+    *PropType = def->type;
+
+    return endCall(function, handle, CAENHV_OK);
+}
+
+CAENHVRESULT CAENHV_GetSysProp(int handle, const char *PropName, void *Result)
+{
+    const char* function("CAENHV_GetSysProp");
+    std::shared_ptr<SimCrate> crate;
+
+    CAENHVRESULT r = beginCall(function, handle, 0, crate);
+    if (r != CAENHV_OK)
+        return r;
+
+    std::lock_guard<std::mutex> lock(crate->mutex);
+
+    return endCall(function, handle, crate->getSysProp(PropName, Result));
+}
+
+CAENHVRESULT CAENHV_SetSysProp(int handle, const char *PropName, void *Set)
+{
+    const char* function("CAENHV_SetSysProp");
+    std::shared_ptr<SimCrate> crate;
+
+    CAENHVRESULT r = beginCall(function, handle, 0, crate);
+    if (r != CAENHV_OK)
+        return r;
+
+    std::lock_guard<std::mutex> lock(crate->mutex);
+
+    return endCall(function, handle, crate->setSysProp(PropName, Set));
+}
+
+CAENHVRESULT CAENHV_GetBdParamInfo(int handle, unsigned short slot, char **ParNameList)
+{
+    const char* function("CAENHV_GetBdParamInfo");
+    std::shared_ptr<SimCrate> crate;
+
+    CAENHVRESULT r = beginCall(function, handle, 0, crate);
+    if (r != CAENHV_OK)
+        return r;
+
+    std::lock_guard<std::mutex> lock(crate->mutex);
+
+    SimBoard* b = crate->getBoard(slot);
+    if (!b)
+        return endCall(function, handle, CAENHV_SLOTNOTPRES);
+
+    *ParNameList = makeNameArray(b->bdParams);
+
+    return endCall(function, handle, CAENHV_OK);
+}
+
+CAENHVRESULT CAENHV_GetBdParamProp(int handle, unsigned short slot, const char *ParName, const char *PropName, void *retval)
+{
+    const char* function("CAENHV_GetBdParamProp");
+    std::shared_ptr<SimCrate> crate;
+
+    CAENHVRESULT r = beginCall(function, handle, 0, crate);
+    if (r != CAENHV_OK)
+        return r;
+
+    std::lock_guard<std::mutex> lock(crate->mutex);
+
+    SimBoard* b = crate->getBoard(slot);
+    if (!b)
+        return endCall(function, handle, CAENHV_SLOTNOTPRES);
+
+    return endCall(function, handle, SimBoard::getParamProp(SimBoard::findParamDef(b->bdParams, ParName), PropName, retval));
+}
+
+CAENHVRESULT CAENHV_GetBdParam(int handle, unsigned short slotNum, const unsigned short *slotList, const char *ParName, void *ParValList)
+{
+    const char* function("CAENHV_GetBdParam");
+    std::shared_ptr<SimCrate> crate;
+
+    CAENHVRESULT r = beginCall(function, handle, 0, crate);
+    if (r != CAENHV_OK)
+        return r;
+
+    std::lock_guard<std::mutex> lock(crate->mutex);
+    crate->update();
+
+    // All the values have 4 bytes: float for numeric parameters, unsigned for the rest
+    uint32_t* values = static_cast<uint32_t*>(ParValList);
+
+    for (std::size_t i(0); i < slotNum; ++i)
+    {
+        SimBoard* b = crate->getBoard(slotList[i]);
+        if (!b)
+            return endCall(function, handle, CAENHV_SLOTNOTPRES);
+
+        r = b->getBdParam(ParName, &values[i]);
+        if (r != CAENHV_OK)
+            return endCall(function, handle, r);
+    }
+
+    return endCall(function, handle, CAENHV_OK);
+}
+
+CAENHVRESULT CAENHV_SetBdParam(int handle, unsigned short slotNum, const unsigned short *slotList, const char *ParName, void *ParValue)
+{
+    const char* function("CAENHV_SetBdParam");
+    std::shared_ptr<SimCrate> crate;
+
+    CAENHVRESULT r = beginCall(function, handle, 0, crate);
+    if (r != CAENHV_OK)
+        return r;
+
+    std::lock_guard<std::mutex> lock(crate->mutex);
+    crate->update();
+
+    for (std::size_t i(0); i < slotNum; ++i)
+    {
+        SimBoard* b = crate->getBoard(slotList[i]);
+        if (!b)
+            return endCall(function, handle, CAENHV_SLOTNOTPRES);
+
+        r = b->setBdParam(ParName, ParValue);
+        if (r != CAENHV_OK)
+            return endCall(function, handle, r);
+    }
+
+    return endCall(function, handle, CAENHV_OK);
+}
+
+CAENHVRESULT CAENHV_GetChParamInfo(int handle, unsigned short slot, unsigned short Ch, char **ParNameList, int *ParNumber)
+{
+    const char* function("CAENHV_GetChParamInfo");
+    std::shared_ptr<SimCrate> crate;
+
+    CAENHVRESULT r = beginCall(function, handle, 0, crate);
+    if (r != CAENHV_OK)
+        return r;
+
+    std::lock_guard<std::mutex> lock(crate->mutex);
+
+    SimBoard* b = crate->getBoard(slot);
+    if (!b)
+        return endCall(function, handle, CAENHV_SLOTNOTPRES);
+
+    if (Ch >= b->channels.size())
+        return endCall(function, handle, CAENHV_OUTOFRANGE);
+
+    *ParNameList = makeNameArray(b->chParams);
+    *ParNumber   = b->chParams.size();
+
+    return endCall(function, handle, CAENHV_OK);
+}
+
+CAENHVRESULT CAENHV_GetChParamProp(int handle, unsigned short slot, unsigned short Ch, const char *ParName, const char *PropName, void *retval)
+{
+    const char* function("CAENHV_GetChParamProp");
+    std::shared_ptr<SimCrate> crate;
+
+    CAENHVRESULT r = beginCall(function, handle, 0, crate);
+    if (r != CAENHV_OK)
+        return r;
+
+    std::lock_guard<std::mutex> lock(crate->mutex);
+
+    SimBoard* b = crate->getBoard(slot);
+    if (!b)
+        return endCall(function, handle, CAENHV_SLOTNOTPRES);
+
+    if (Ch >= b->channels.size())
+        return endCall(function, handle, CAENHV_OUTOFRANGE);
+
+    return endCall(function, handle, SimBoard::getParamProp(SimBoard::findParamDef(b->chParams, ParName), PropName, retval));
+}
+
+CAENHVRESULT CAENHV_GetChParam(int handle, unsigned short slot, const char *ParName, unsigned short ChNum, const unsigned short *ChList, void *ParValList)
+{
+    const char* function("CAENHV_GetChParam");
+    std::shared_ptr<SimCrate> crate;
+
+    CAENHVRESULT r = beginCall(function, handle, ChNum, crate);
+    if (r != CAENHV_OK)
+        return r;
+
+    std::lock_guard<std::mutex> lock(crate->mutex);
+    crate->update();
+
+    SimBoard* b = crate->getBoard(slot);
+    if (!b)
+        return endCall(function, handle, CAENHV_SLOTNOTPRES);
+
+    // All the values have 4 bytes: float for numeric parameters, unsigned for the rest
+    uint32_t* values = static_cast<uint32_t*>(ParValList);
+
+    for (std::size_t i(0); i < ChNum; ++i)
+    {
+        if (ChList[i] >= b->channels.size())
+            return endCall(function, handle, CAENHV_OUTOFRANGE);
+
+        r = b->channels.at(ChList[i]).get(ParName, &values[i], crate->noise(crate->vNoise), crate->noise(crate->iNoise));
+        if (r != CAENHV_OK)
+            return endCall(function, handle, r);
+    }
+
+    return endCall(function, handle, CAENHV_OK);
+}
+
+CAENHVRESULT CAENHV_SetChParam(int handle, unsigned short slot, const char *ParName, unsigned short ChNum, const unsigned short *ChList, void *ParValue)
+{
+    const char* function("CAENHV_SetChParam");
+    std::shared_ptr<SimCrate> crate;
+
+    CAENHVRESULT r = beginCall(function, handle, ChNum, crate);
+    if (r != CAENHV_OK)
+        return r;
+
+    std::lock_guard<std::mutex> lock(crate->mutex);
+    crate->update();
+
+    SimBoard* b = crate->getBoard(slot);
+    if (!b)
+        return endCall(function, handle, CAENHV_SLOTNOTPRES);
+
+    for (std::size_t i(0); i < ChNum; ++i)
+    {
+        if (ChList[i] >= b->channels.size())
+            return endCall(function, handle, CAENHV_OUTOFRANGE);
+
+        r = b->channels.at(ChList[i]).set(ParName, ParValue);
+        if (r != CAENHV_OK)
+            return endCall(function, handle, r);
+    }
+
+    return endCall(function, handle, CAENHV_OK);
+}
+
+CAENHVRESULT CAENHV_GetChName(int handle, unsigned short slot, unsigned short ChNum, const unsigned short *ChList, char (*ChNameList)[MAX_CH_NAME])
+{
+    const char* function("CAENHV_GetChName");
+    std::shared_ptr<SimCrate> crate;
+
+    CAENHVRESULT r = beginCall(function, handle, ChNum, crate);
+    if (r != CAENHV_OK)
+        return r;
+
+    std::lock_guard<std::mutex> lock(crate->mutex);
+
+    SimBoard* b = crate->getBoard(slot);
+    if (!b)
+        return endCall(function, handle, CAENHV_SLOTNOTPRES);
+
+    for (std::size_t i(0); i < ChNum; ++i)
+    {
+        if (ChList[i] >= b->channels.size())
+            return endCall(function, handle, CAENHV_OUTOFRANGE);
+
+        strncpy(ChNameList[i], b->channels.at(ChList[i]).name.c_str(), MAX_CH_NAME - 1);
+        ChNameList[i][MAX_CH_NAME - 1] = '\0';
+    }
+
+    return endCall(function, handle, CAENHV_OK);
+}
+
+CAENHVRESULT CAENHV_SetChName(int handle, unsigned short slot, unsigned short ChNum, const unsigned short *ChList, const char *ChName)
+{
+    const char* function("CAENHV_SetChName");
+    std::shared_ptr<SimCrate> crate;
+
+    CAENHVRESULT r = beginCall(function, handle, ChNum, crate);
+    if (r != CAENHV_OK)
+        return r;
+
+    std::lock_guard<std::mutex> lock(crate->mutex);
+
+    SimBoard* b = crate->getBoard(slot);
+    if (!b)
+        return endCall(function, handle, CAENHV_SLOTNOTPRES);
+
+    for (std::size_t i(0); i < ChNum; ++i)
+    {
+        if (ChList[i] >= b->channels.size())
+            return endCall(function, handle, CAENHV_OUTOFRANGE);
+
+        b->channels.at(ChList[i]).name = std::string(ChName).substr(0, MAX_CH_NAME - 1);
+    }
+
+    return endCall(function, handle, CAENHV_OK);
+}
+
+///////////////////////////
+// Control interface     //
+///////////////////////////
+int CAENHVSim_LoadConfig(const char *fileName)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    init();
+
+    return loadConfig(fileName) ? 0 : -1;
+}
+
+void CAENHVSim_SetLatency(double base, double jitter_, double perChannel_)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    init();
+
+    latency    = base;
+    jitter     = jitter_;
+    perChannel = perChannel_;
+}
+
+void CAENHVSim_SetErrorRate(double p)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    init();
+
+    errorRate = p;
+}
+
+void CAENHVSim_FailNext(const char *function, unsigned count)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+
+    failNext[function] += count;
+}
+
+void CAENHVSim_HangNext(const char *function, double seconds)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+
+    hangNext[function] = seconds;
+}
+
+unsigned long CAENHVSim_GetCallCount(const char *function)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+
+    if (std::string(function) == "*")
+        return totalCalls;
+
+    std::map<std::string, unsigned long>::const_iterator it = callCounts.find(function);
+    return ( it == callCounts.end() ) ? 0 : it->second;
+}
+
+void CAENHVSim_ResetCallCounts(void)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+
+    callCounts.clear();
+    totalCalls = 0;
+}
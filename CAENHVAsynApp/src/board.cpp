@@ -21,9 +21,10 @@
 
 #include "board.h"
 
-IBoard::IBoard(int h, std::size_t s, std::string m, std::string d, std::size_t n, std::string sn, std::string fw)
+IBoard::IBoard(int h, const Stats& st, std::size_t s, std::string m, std::string d, std::size_t n, std::string sn, std::string fw)
 :
     handle(h),
+    stats(st),
     slot(s),
     model(m),
     description(d),
@@ -33,15 +34,17 @@ IBoard::IBoard(int h, std::size_t s, std::string m, std::string d, std::size_t n
 {
     GetBoardParams();
     GetBoardChannels();
+    BuildSnapshotLayout();
+    BuildSetpointLayout();
 }
 
 IBoard::~IBoard()
 {
 }
 
-Board IBoard::create(int h, std::size_t s, std::string m, std::string d, std::size_t n, std::string sn, std::string fw)
+Board IBoard::create(int h, const Stats& st, std::size_t s, std::string m, std::string d, std::size_t n, std::string sn, std::string fw)
 {
-    return std::make_shared<IBoard>(h, s, m, d, n, sn, fw);
+    return std::make_shared<IBoard>(h, st, s, m, d, n, sn, fw);
 }
 
 void IBoard::printInfo(std::ostream& stream) const
@@ -90,7 +93,7 @@ void IBoard::GetBoardParams()
     std::string functionName("GetBoardParams");
 
     char *ParNameList = (char *)NULL;
-    CAENHVRESULT r = CAENHV_GetBdParamInfo(handle, slot, &ParNameList);
+    CAENHVRESULT r = timedCall(stats, WrapperStats::GetBdParamInfo, slot, [&]() { return CAENHV_GetBdParamInfo(handle, slot, &ParNameList); });
 
     std::stringstream retMessage;
     retMessage << "CAENHV_GetBdParamInfo (slot = " << slot << ") : " << CAENHV_GetError(handle) << " (num. " << r << ")";
@@ -110,21 +113,21 @@ void IBoard::GetBoardParams()
     {
         uint32_t type, mode;
 
-        if ( CAENHV_GetBdParamProp(handle, slot, p[i], "Type", &type) != CAENHV_OK )
+        if ( timedCall(stats, WrapperStats::GetBdParamProp, slot, [&]() { return CAENHV_GetBdParamProp(handle, slot, p[i], "Type", &type); }) != CAENHV_OK )
             throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
 
-        if (CAENHV_GetBdParamProp(handle, slot, p[i], "Mode", &mode) != CAENHV_OK )
+        if (timedCall(stats, WrapperStats::GetBdParamProp, slot, [&]() { return CAENHV_GetBdParamProp(handle, slot, p[i], "Mode", &mode); }) != CAENHV_OK )
             throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
 
 
         if (type == PARAM_TYPE_NUMERIC)
-            boardParameterNumerics.push_back( IBoardParameterNumeric::create(handle, slot, p[i], mode));
+            boardParameterNumerics.push_back( IBoardParameterNumeric::create(handle, stats, slot, p[i], mode));
         else if (type == PARAM_TYPE_ONOFF)
-            boardParameterOnOffs.push_back( IBoardParameterOnOff::create(handle, slot, p[i], mode));
+            boardParameterOnOffs.push_back( IBoardParameterOnOff::create(handle, stats, slot, p[i], mode));
         else if (type == PARAM_TYPE_CHSTATUS)
-            boardParameterChStatuses.push_back( IBoardParameterChStatus::create(handle, slot, p[i], mode));
+            boardParameterChStatuses.push_back( IBoardParameterChStatus::create(handle, stats, slot, p[i], mode));
         else if (type == PARAM_TYPE_BDSTATUS)
-            boardParameterBdStatuses.push_back( IBoardParameterBdStatus::create(handle, slot, p[i], mode));
+            boardParameterBdStatuses.push_back( IBoardParameterBdStatus::create(handle, stats, slot, p[i], mode));
         else
             //throw std::runtime_error("Parameter type not  supported!");
             std::cerr << "Error found when creating a Board Parameter object for pamater '" << p[i] << "'. Unsupported type = " << type << std::endl;
@@ -137,5 +140,372 @@ void IBoard::GetBoardParams()
 void IBoard::GetBoardChannels()
 {
     for (std::size_t i(0); i < numChannels; ++i)
-        channels.push_back( IChannel::create(handle, slot, i) );
+        channels.push_back( IChannel::create(handle, stats, slot, i) );
+}
+
+void IBoard::allChannelsOff() const
+{
+    // Only consider channels that have a 'Pw' parameter
+    std::vector<uint16_t> chList;
+    for (std::vector<Channel>::const_iterator it = channels.begin(); it != channels.end(); ++it)
+    {
+        std::vector<ChannelParameterOnOff> po = (*it)->getChannelParameterOnOffs();
+        for (std::vector<ChannelParameterOnOff>::const_iterator paramIt = po.begin(); paramIt != po.end(); ++paramIt)
+        {
+            if ( !(*paramIt)->getParam().compare("Pw") )
+            {
+                chList.push_back((*it)->getChannel());
+                break;
+            }
+        }
+    }
+
+    if (chList.empty())
+        return;
+
+    uint32_t off(0);
+    if ( timedCall(stats, WrapperStats::SetChParam, slot, [&]() { return CAENHV_SetChParam(handle, slot, "Pw", chList.size(), chList.data(), &off); }) != CAENHV_OK )
+        throw std::runtime_error("CAENHV_SetChParam failed: " + std::string(CAENHV_GetError(handle)));
+}
+
+void IBoard::setChParam(const std::string& param, const std::vector<uint16_t>& channels, double value) const
+{
+    const SetpointParam* p = findSetpointParam(chSetpointParams, param);
+    if (!p)
+        throw std::runtime_error("'" + param + "' is not a writable channel parameter");
+
+    if (channels.empty())
+        return;
+
+    CAENHVRESULT r;
+    if (p->isFloat)
+    {
+        float f = value;
+        r = timedCall(stats, WrapperStats::SetChParam, slot, [&]() { return CAENHV_SetChParam(handle, slot, param.c_str(), channels.size(), channels.data(), &f); });
+    }
+    else
+    {
+        uint32_t w = static_cast<uint32_t>(static_cast<int64_t>(value));
+        r = timedCall(stats, WrapperStats::SetChParam, slot, [&]() { return CAENHV_SetChParam(handle, slot, param.c_str(), channels.size(), channels.data(), &w); });
+    }
+
+    if (r != CAENHV_OK)
+        throw std::runtime_error("CAENHV_SetChParam failed: " + std::string(CAENHV_GetError(handle)));
+}
+
+void IBoard::setBdParam(const std::string& param, double value) const
+{
+    const SetpointParam* p = findSetpointParam(bdSetpointParams, param);
+    if (!p)
+        throw std::runtime_error("'" + param + "' is not a writable board parameter");
+
+    unsigned short s = slot;
+
+    CAENHVRESULT r;
+    if (p->isFloat)
+    {
+        float f = value;
+        r = timedCall(stats, WrapperStats::SetBdParam, slot, [&]() { return CAENHV_SetBdParam(handle, 1, &s, param.c_str(), &f); });
+    }
+    else
+    {
+        uint32_t w = static_cast<uint32_t>(static_cast<int64_t>(value));
+        r = timedCall(stats, WrapperStats::SetBdParam, slot, [&]() { return CAENHV_SetBdParam(handle, 1, &s, param.c_str(), &w); });
+    }
+
+    if (r != CAENHV_OK)
+        throw std::runtime_error("CAENHV_SetBdParam failed: " + std::string(CAENHV_GetError(handle)));
+}
+
+void IBoard::getChNames(std::vector<std::string>& names) const
+{
+    names.clear();
+
+    if (!numChannels)
+        return;
+
+    std::vector<uint16_t> list(numChannels);
+    for (std::size_t i(0); i < numChannels; ++i)
+        list[i] = i;
+
+    std::vector<char> buffer(numChannels * MAX_CH_NAME);
+    char (*n)[MAX_CH_NAME] = reinterpret_cast<char (*)[MAX_CH_NAME]>(buffer.data());
+
+    if ( timedCall(stats, WrapperStats::GetChName, slot, [&]() { return CAENHV_GetChName(handle, slot, list.size(), list.data(), n); }) != CAENHV_OK )
+        throw std::runtime_error("CAENHV_GetChName failed: " + std::string(CAENHV_GetError(handle)));
+
+    for (std::size_t i(0); i < numChannels; ++i)
+        names.push_back(std::string(n[i], strnlen(n[i], MAX_CH_NAME)));
+}
+
+void IBoard::setChName(const std::vector<uint16_t>& channels, const std::string& name) const
+{
+    if (name.size() >= MAX_CH_NAME)
+        throw std::invalid_argument("'" + name + "' is longer than the maximum channel name length");
+
+    if (channels.empty())
+        return;
+
+    if ( timedCall(stats, WrapperStats::SetChName, slot, [&]() { return CAENHV_SetChName(handle, slot, channels.size(), channels.data(), name.c_str()); }) != CAENHV_OK )
+        throw std::runtime_error("CAENHV_SetChName failed: " + std::string(CAENHV_GetError(handle)));
+}
+
+void IBoard::readSetpoints(std::vector<Setpoint>& setpoints) const
+{
+    // At least one element, for the board parameters
+    std::vector<float>    f(std::max<std::size_t>(numChannels, 1));
+    std::vector<uint32_t> w(std::max<std::size_t>(numChannels, 1));
+
+    for (std::vector<SetpointParam>::const_iterator it = chSetpointParams.begin(); it != chSetpointParams.end(); ++it)
+    {
+        if ( ( !it->readable ) || ( it->channels.empty() ) )
+            continue;
+
+        void* values = it->isFloat ? static_cast<void*>(f.data()) : static_cast<void*>(w.data());
+
+        if ( timedCall(stats, WrapperStats::GetChParam, slot, [&]() { return CAENHV_GetChParam(handle, slot, it->name.c_str(), it->channels.size(), it->channels.data(), values); }) != CAENHV_OK )
+            throw std::runtime_error("CAENHV_GetChParam failed: " + std::string(CAENHV_GetError(handle)));
+
+        for (std::size_t j(0); j < it->channels.size(); ++j)
+        {
+            Setpoint s;
+            s.slot    = slot;
+            s.channel = it->channels[j];
+            s.param   = it->name;
+            s.value   = it->isFloat ? static_cast<double>(f[j]) : static_cast<double>(w[j]);
+            setpoints.push_back(s);
+        }
+    }
+
+    uint16_t tempSlot = slot;
+
+    for (std::vector<SetpointParam>::const_iterator it = bdSetpointParams.begin(); it != bdSetpointParams.end(); ++it)
+    {
+        if (!it->readable)
+            continue;
+
+        void* value = it->isFloat ? static_cast<void*>(f.data()) : static_cast<void*>(w.data());
+
+        if ( timedCall(stats, WrapperStats::GetBdParam, slot, [&]() { return CAENHV_GetBdParam(handle, 1, &tempSlot, it->name.c_str(), value); }) != CAENHV_OK )
+            throw std::runtime_error("CAENHV_GetBdParam failed: " + std::string(CAENHV_GetError(handle)));
+
+        Setpoint s;
+        s.slot    = slot;
+        s.channel = -1;
+        s.param   = it->name;
+        s.value   = it->isFloat ? static_cast<double>(f[0]) : static_cast<double>(w[0]);
+        setpoints.push_back(s);
+    }
+}
+
+template <typename T>
+void IBoard::addSetpointParam(std::vector<SetpointParam>& list, const T& p, bool isFloat, int channel)
+{
+    // Read-only parameters can not be set
+    if ( !p->getMode().compare("RO") )
+        return;
+
+    std::vector<SetpointParam>::iterator sp = list.begin();
+    while ( ( sp != list.end() ) && ( sp->name.compare(p->getParam()) ) )
+        ++sp;
+
+    if (sp == list.end())
+    {
+        SetpointParam n;
+        n.name     = p->getParam();
+        n.isFloat  = isFloat;
+        n.readable = p->getMode().compare("WO");
+        list.push_back(n);
+        sp = list.end() - 1;
+    }
+
+    if (channel >= 0)
+        sp->channels.push_back(channel);
+}
+
+const IBoard::SetpointParam* IBoard::findSetpointParam(const std::vector<SetpointParam>& list, const std::string& param)
+{
+    for (std::vector<SetpointParam>::const_iterator it = list.begin(); it != list.end(); ++it)
+        if ( !it->name.compare(param) )
+            return &(*it);
+
+    return NULL;
+}
+
+void IBoard::BuildSetpointLayout()
+{
+    for (std::vector<BoardParameterNumeric>::const_iterator it = boardParameterNumerics.begin(); it != boardParameterNumerics.end(); ++it)
+        addSetpointParam(bdSetpointParams, *it, true, -1);
+
+    for (std::vector<BoardParameterOnOff>::const_iterator it = boardParameterOnOffs.begin(); it != boardParameterOnOffs.end(); ++it)
+        addSetpointParam(bdSetpointParams, *it, false, -1);
+
+    for (std::vector<Channel>::const_iterator chIt = channels.begin(); chIt != channels.end(); ++chIt)
+    {
+        int c = (*chIt)->getChannel();
+
+        std::vector<ChannelParameterNumeric> cpn = (*chIt)->getChannelParameterNumerics();
+        for (std::vector<ChannelParameterNumeric>::const_iterator it = cpn.begin(); it != cpn.end(); ++it)
+            addSetpointParam(chSetpointParams, *it, true, c);
+
+        std::vector<ChannelParameterOnOff> cpo = (*chIt)->getChannelParameterOnOffs();
+        for (std::vector<ChannelParameterOnOff>::const_iterator it = cpo.begin(); it != cpo.end(); ++it)
+            addSetpointParam(chSetpointParams, *it, false, c);
+
+        std::vector<ChannelParameterBinary> cpb = (*chIt)->getChannelParameterBinaries();
+        for (std::vector<ChannelParameterBinary>::const_iterator it = cpb.begin(); it != cpb.end(); ++it)
+            addSetpointParam(chSetpointParams, *it, false, c);
+    }
+}
+
+template <typename T>
+void IBoard::addSnapshotParam(std::vector<SnapshotParam>& list, const T& p, std::size_t channel)
+{
+    // Write-only parameters can not be acquired
+    if ( !p->getMode().compare("WO") )
+        return;
+
+    int i = findSnapshotParam(list, p->getParam());
+    if (i < 0)
+    {
+        SnapshotParam sp;
+        sp.name = p->getParam();
+        list.push_back(sp);
+        i = list.size() - 1;
+    }
+
+    list.at(i).channels.push_back(channel);
+}
+
+int IBoard::findSnapshotParam(const std::vector<SnapshotParam>& list, const std::string& param)
+{
+    for (std::size_t i(0); i < list.size(); ++i)
+        if ( !list.at(i).name.compare(param) )
+            return i;
+
+    return -1;
+}
+
+void IBoard::BuildSnapshotLayout()
+{
+    for (std::vector<BoardParameterNumeric>::const_iterator it = boardParameterNumerics.begin(); it != boardParameterNumerics.end(); ++it)
+        addSnapshotParam(bdFloatParams, *it, 0);
+
+    for (std::vector<BoardParameterOnOff>::const_iterator it = boardParameterOnOffs.begin(); it != boardParameterOnOffs.end(); ++it)
+        addSnapshotParam(bdWordParams, *it, 0);
+
+    for (std::vector<BoardParameterChStatus>::const_iterator it = boardParameterChStatuses.begin(); it != boardParameterChStatuses.end(); ++it)
+        addSnapshotParam(bdWordParams, *it, 0);
+
+    for (std::vector<BoardParameterBdStatus>::const_iterator it = boardParameterBdStatuses.begin(); it != boardParameterBdStatuses.end(); ++it)
+        addSnapshotParam(bdWordParams, *it, 0);
+
+    for (std::vector<Channel>::const_iterator chIt = channels.begin(); chIt != channels.end(); ++chIt)
+    {
+        std::size_t c = (*chIt)->getChannel();
+
+        std::vector<ChannelParameterNumeric> cpn = (*chIt)->getChannelParameterNumerics();
+        for (std::vector<ChannelParameterNumeric>::const_iterator it = cpn.begin(); it != cpn.end(); ++it)
+            addSnapshotParam(chFloatParams, *it, c);
+
+        std::vector<ChannelParameterOnOff> cpo = (*chIt)->getChannelParameterOnOffs();
+        for (std::vector<ChannelParameterOnOff>::const_iterator it = cpo.begin(); it != cpo.end(); ++it)
+            addSnapshotParam(chWordParams, *it, c);
+
+        std::vector<ChannelParameterChStatus> cpcs = (*chIt)->getChannelParameterChStatuses();
+        for (std::vector<ChannelParameterChStatus>::const_iterator it = cpcs.begin(); it != cpcs.end(); ++it)
+            addSnapshotParam(chWordParams, *it, c);
+    }
+
+    snapshot.resize(chFloatParams.size(), chWordParams.size(), bdFloatParams.size(), bdWordParams.size(), numChannels);
+}
+
+void IBoard::acquire(BoardSnapshotData& d) const
+{
+    // A new buffer gets the layout of the snapshot
+    if ( ( d.numChannels != numChannels ) || ( d.chFloats.size() != chFloatParams.size() * numChannels ) ||
+         ( d.chWords.size() != chWordParams.size() * numChannels ) || ( d.bdFloats.size() != bdFloatParams.size() ) ||
+         ( d.bdWords.size() != bdWordParams.size() ) )
+        d.resize(chFloatParams.size(), chWordParams.size(), bdFloatParams.size(), bdWordParams.size(), numChannels);
+
+    std::vector<float>    f(numChannels);
+    std::vector<uint32_t> w(numChannels);
+
+    for (std::size_t i(0); i < chFloatParams.size(); ++i)
+    {
+        const SnapshotParam& p = chFloatParams.at(i);
+
+        if ( timedCall(stats, WrapperStats::GetChParam, slot, [&]() { return CAENHV_GetChParam(handle, slot, p.name.c_str(), p.channels.size(), p.channels.data(), f.data()); }) != CAENHV_OK )
+            throw std::runtime_error("CAENHV_GetChParam failed: " + std::string(CAENHV_GetError(handle)));
+
+        for (std::size_t j(0); j < p.channels.size(); ++j)
+            d.chFloats[i * numChannels + p.channels[j]] = f[j];
+    }
+
+    for (std::size_t i(0); i < chWordParams.size(); ++i)
+    {
+        const SnapshotParam& p = chWordParams.at(i);
+
+        if ( timedCall(stats, WrapperStats::GetChParam, slot, [&]() { return CAENHV_GetChParam(handle, slot, p.name.c_str(), p.channels.size(), p.channels.data(), w.data()); }) != CAENHV_OK )
+            throw std::runtime_error("CAENHV_GetChParam failed: " + std::string(CAENHV_GetError(handle)));
+
+        for (std::size_t j(0); j < p.channels.size(); ++j)
+            d.chWords[i * numChannels + p.channels[j]] = w[j];
+    }
+
+    uint16_t tempSlot = slot;
+
+    for (std::size_t i(0); i < bdFloatParams.size(); ++i)
+        if ( timedCall(stats, WrapperStats::GetBdParam, slot, [&]() { return CAENHV_GetBdParam(handle, 1, &tempSlot, bdFloatParams.at(i).name.c_str(), &d.bdFloats[i]); }) != CAENHV_OK )
+            throw std::runtime_error("CAENHV_GetBdParam failed: " + std::string(CAENHV_GetError(handle)));
+
+    for (std::size_t i(0); i < bdWordParams.size(); ++i)
+        if ( timedCall(stats, WrapperStats::GetBdParam, slot, [&]() { return CAENHV_GetBdParam(handle, 1, &tempSlot, bdWordParams.at(i).name.c_str(), &d.bdWords[i]); }) != CAENHV_OK )
+            throw std::runtime_error("CAENHV_GetBdParam failed: " + std::string(CAENHV_GetError(handle)));
+}
+
+void IBoard::publish(BoardSnapshotData& d, const epicsTimeStamp& stamp, double duration, bool valid)
+{
+    // A failed acquisition may have left 'd' incomplete, so the last values
+    // are published again instead
+    if (!valid)
+        snapshot.read(d);
+
+    d.stamp    = stamp;
+    d.duration = duration;
+    d.valid    = valid;
+
+    snapshot.publish(d);
+}
+
+int IBoard::getChFloatIndex(const std::string& param) const
+{
+    return findSnapshotParam(chFloatParams, param);
+}
+
+int IBoard::getChWordIndex(const std::string& param) const
+{
+    return findSnapshotParam(chWordParams, param);
+}
+
+int IBoard::getBdFloatIndex(const std::string& param) const
+{
+    return findSnapshotParam(bdFloatParams, param);
+}
+
+int IBoard::getBdWordIndex(const std::string& param) const
+{
+    return findSnapshotParam(bdWordParams, param);
+}
+
+std::string IBoard::getIMonUnits() const
+{
+    if (!channels.empty()) {
+        std::vector<ChannelParameterNumeric> cpn = channels.front()->getChannelParameterNumerics();
+        for (std::vector<ChannelParameterNumeric>::iterator it = cpn.begin(); it != cpn.end(); ++it)
+            if ( ( (*it)->getParam() == "IMon" ) && ( !(*it)->getUnits().empty() ) )
+                return (*it)->getUnits();
+    }
+
+    return "uA";
 }
@@ -41,6 +41,8 @@
 #include "common.h"
 #include "board_parameter.h"
 #include "channel.h"
+#include "board_snapshot.h"
+#include "setpoint_file.h"
 
 class IBoard;
 
@@ -49,27 +51,110 @@ typedef std::shared_ptr<IBoard> Board;
 class IBoard
 {
 public:
-    IBoard(int h, std::size_t s, std::string m, std::string d, std::size_t n, std::string sn, std::string fw);
+    IBoard(int h, const Stats& st, std::size_t s, std::string m, std::string d, std::size_t n, std::string sn, std::string fw);
     ~IBoard();
 
     // Factory method
-    static Board create(int h, std::size_t s, std::string m, std::string d, std::size_t n, std::string sn, std::string fw);
+    static Board create(int h, const Stats& st, std::size_t s, std::string m, std::string d, std::size_t n, std::string sn, std::string fw);
 
     void printInfo(std::ostream& stream) const;
     void printBoardInfo(std::ostream& stream) const;
 
+    // Turn off all the channels in the board, using a single wrapper call
+    void allChannelsOff() const;
+
+    // Writable parameter (setpoint), and the channels that have it
+    struct SetpointParam
+    {
+        std::string           name;
+        bool                  isFloat;  // Otherwise, a 32-bit word
+        bool                  readable;
+        std::vector<uint16_t> channels; // Empty for board parameters
+    };
+    const std::vector<SetpointParam>& getChSetpointParams() const { return chSetpointParams; };
+    const std::vector<SetpointParam>& getBdSetpointParams() const { return bdSetpointParams; };
+
+    // Set a writable channel parameter in several channels with a single
+    // wrapper call, or a writable board parameter. The value is converted to
+    // the type of the parameter. Throws a std::runtime_error on errors.
+    void setChParam(const std::string& param, const std::vector<uint16_t>& channels, double value) const;
+    void setBdParam(const std::string& param, double value) const;
+
+    // Names of all the channels of the board, read with a single wrapper call
+    void getChNames(std::vector<std::string>& names) const;
+    // Set the same name to several channels with a single wrapper call.
+    // Throws a std::runtime_error on errors, or a std::invalid_argument if
+    // the name is too long.
+    void setChName(const std::vector<uint16_t>& channels, const std::string& name) const;
+
+    // Read all the readable writable parameters of the board, appending them
+    // to 'setpoints', using one wrapper call per parameter. Throws a
+    // std::runtime_error on errors.
+    void readSetpoints(std::vector<Setpoint>& setpoints) const;
+
     std::vector<BoardParameterNumeric>  getBoardParameterNumerics()   { return boardParameterNumerics;   };
     std::vector<BoardParameterOnOff>    getBoardParameterOnOffs()     { return boardParameterOnOffs;     };
     std::vector<BoardParameterChStatus> getBoardParameterChStatuses() { return boardParameterChStatuses; };
     std::vector<BoardParameterBdStatus> getBoardParameterBdStatuses() { return boardParameterBdStatuses; };
     std::vector<Channel>                getChannels()                 { return channels;                 };
 
+    std::size_t getSlot()            const { return slot;            };
+    std::size_t getNumChannels()     const { return numChannels;     };
+    std::string getModel()           const { return model;           };
+    std::string getSerialNumber()    const { return serialNumber;    };
+    std::string getFirmwareRelease() const { return firmwareRelease; };
+
+    // Batched acquisition: read all the readable board and channel parameters
+    // into 'd', using one wrapper call per parameter. As the call can outlive
+    // a timeout, 'd' must be owned by the job, and not used if it failed.
+    void acquire(BoardSnapshotData& d) const;
+    // Publish an acquisition in the snapshot. If it failed, the last values
+    // are published again, read into 'd', and marked as invalid.
+    void publish(BoardSnapshotData& d, const epicsTimeStamp& stamp, double duration, bool valid);
+    const BoardSnapshot& getSnapshot() const { return snapshot; };
+
+    // Position of a parameter in the snapshot arrays, or -1 if it is not acquired
+    int getChFloatIndex(const std::string& param) const;
+    int getChWordIndex(const std::string& param)  const;
+    int getBdFloatIndex(const std::string& param) const;
+    int getBdWordIndex(const std::string& param)  const;
+
+    // Units of the IMon channel parameter, which depend on the board model.
+    // Defaults to "uA" if the board has no channels or no IMon parameter.
+    std::string getIMonUnits() const;
+
+    // Parameters acquired in the snapshot, in the order of the snapshot arrays
+    std::size_t getNumChFloats()                const { return chFloatParams.size();  };
+    std::string getChFloatName(std::size_t i)   const { return chFloatParams.at(i).name; };
+    std::size_t getNumChWords()                 const { return chWordParams.size();   };
+    std::string getChWordName(std::size_t i)    const { return chWordParams.at(i).name;  };
+
 private:
 
     void GetBoardParams();
     void GetBoardChannels();
+    void BuildSnapshotLayout();
+    void BuildSetpointLayout();
+
+    // Parameter acquired in the snapshot, and the channels that have it
+    struct SnapshotParam
+    {
+        std::string           name;
+        std::vector<uint16_t> channels;
+    };
+
+    template <typename T>
+    static void addSnapshotParam(std::vector<SnapshotParam>& list, const T& p, std::size_t channel);
+
+    static int findSnapshotParam(const std::vector<SnapshotParam>& list, const std::string& param);
+
+    template <typename T>
+    static void addSetpointParam(std::vector<SetpointParam>& list, const T& p, bool isFloat, int channel);
+
+    static const SetpointParam* findSetpointParam(const std::vector<SetpointParam>& list, const std::string& param);
 
     int                         handle;
+    Stats                       stats;
     std::size_t                 slot;
     std::string                 model;
     std::string                 description;
@@ -83,6 +168,16 @@ private:
     std::vector<BoardParameterBdStatus> boardParameterBdStatuses;
 
     std::vector<Channel> channels;
+
+    std::vector<SnapshotParam> chFloatParams;
+    std::vector<SnapshotParam> chWordParams;
+    std::vector<SnapshotParam> bdFloatParams;
+    std::vector<SnapshotParam> bdWordParams;
+
+    std::vector<SetpointParam> chSetpointParams;
+    std::vector<SetpointParam> bdSetpointParams;
+
+    BoardSnapshot snapshot;
 };
 
 #endif
@@ -0,0 +1,214 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : board_history.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Ring of the last acquired values of all the channels of a board
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <algorithm>
+#include <cmath>
+#include "board_history.h"
+
+namespace
+{
+    // Statistics of the 'n' samples of a ring, starting at 'first'. 'dt' are
+    // the times of the samples relative to their mean, and 'dt2' the sum of
+    // their squares. The inner loops run over the channels, on contiguous
+    // arrays, so they can be vectorized.
+    void windowStats(const std::vector<float>& ring, std::size_t depth, std::size_t numChannels,
+        std::size_t first, std::size_t n, const std::vector<double>& dt, double dt2, BoardHistory::Stats& s)
+    {
+        std::size_t m = n ? numChannels : 0;
+
+        s.min.assign(m, 0);
+        s.max.assign(m, 0);
+        s.mean.assign(m, 0);
+        s.rms.assign(m, 0);
+        s.slope.assign(m, 0);
+
+        // With no channels the ring is empty, and it can't be indexed
+        if ( ( !n ) || ( !numChannels ) )
+            return;
+
+        const float *row = &ring[first * numChannels];
+        std::copy(row, row + numChannels, s.min.begin());
+        std::copy(row, row + numChannels, s.max.begin());
+
+        for (std::size_t k(0); k < n; ++k)
+        {
+            row = &ring[( ( first + k ) % depth ) * numChannels];
+            double t = dt[k];
+
+            for (std::size_t c(0); c < numChannels; ++c)
+            {
+                double x = row[c];
+                s.min[c]    = std::min(s.min[c], x);
+                s.max[c]    = std::max(s.max[c], x);
+                s.mean[c]  += x;
+                s.rms[c]   += x * x;
+                s.slope[c] += t * x;
+            }
+        }
+
+        for (std::size_t c(0); c < numChannels; ++c)
+        {
+            s.mean[c]  /= n;
+            s.rms[c]    = std::sqrt(s.rms[c] / n);
+            s.slope[c]  = ( dt2 > 0 ) ? s.slope[c] / dt2 : 0;
+        }
+    }
+}
+
+History BoardHistory::create(std::size_t depth, std::size_t numChannels, int vMon, int iMon, int status)
+{
+    return std::make_shared<BoardHistory>(depth, numChannels, vMon, iMon, status);
+}
+
+BoardHistory::BoardHistory(std::size_t depth, std::size_t numChannels, int vMon, int iMon, int status)
+:
+    depth(depth),
+    numChannels(numChannels),
+    vMonIndex(vMon),
+    iMonIndex(iMon),
+    statusIndex(status),
+    next(0),
+    count(0),
+    vMon(depth * numChannels),
+    iMon(depth * numChannels),
+    status(depth * numChannels),
+    stamps(depth)
+{
+}
+
+void BoardHistory::push(const BoardSnapshotData& d)
+{
+    if ( ( !depth ) || ( !d.valid ) || ( d.numChannels != numChannels ) )
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::size_t offset = next * numChannels;
+
+    if (vMonIndex >= 0)
+        std::copy(d.chFloats.begin() + vMonIndex * numChannels, d.chFloats.begin() + ( vMonIndex + 1 ) * numChannels, vMon.begin() + offset);
+
+    if (iMonIndex >= 0)
+        std::copy(d.chFloats.begin() + iMonIndex * numChannels, d.chFloats.begin() + ( iMonIndex + 1 ) * numChannels, iMon.begin() + offset);
+
+    if (statusIndex >= 0)
+        std::copy(d.chWords.begin() + statusIndex * numChannels, d.chWords.begin() + ( statusIndex + 1 ) * numChannels, status.begin() + offset);
+
+    stamps.at(next) = d.stamp;
+
+    next  = ( next + 1 ) % depth;
+    count = std::min(count + 1, depth);
+}
+
+std::size_t BoardHistory::read(std::size_t channel, Trace& t) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::size_t n = ( channel < numChannels ) ? count : 0;
+
+    t.vMon.resize(n);
+    t.iMon.resize(n);
+    t.status.resize(n);
+    t.time.resize(n);
+
+    if (!n)
+    {
+        t.last.secPastEpoch = 0;
+        t.last.nsec         = 0;
+        return 0;
+    }
+
+    std::size_t first = ( next + depth - n ) % depth;
+    t.last = stamps.at( ( next + depth - 1 ) % depth );
+
+    for (std::size_t i(0); i < n; ++i)
+    {
+        std::size_t s = ( first + i ) % depth;
+        std::size_t v = s * numChannels + channel;
+
+        t.vMon[i]   = vMon[v];
+        t.iMon[i]   = iMon[v];
+        t.status[i] = status[v];
+        t.time[i]   = epicsTimeDiffInSeconds(&stamps[s], &t.last);
+    }
+
+    return n;
+}
+
+std::size_t BoardHistory::readAll(std::size_t samples, Block& b) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::size_t n = std::min(samples, count);
+
+    b.vMon.resize(n * numChannels);
+    b.iMon.resize(n * numChannels);
+    b.status.resize(n * numChannels);
+    b.stamps.resize(n);
+
+    std::size_t first = ( next + depth - n ) % depth;
+
+    for (std::size_t i(0); i < n; ++i)
+    {
+        std::size_t s = ( first + i ) % depth;
+        std::size_t from = s * numChannels;
+        std::size_t to   = i * numChannels;
+
+        std::copy(vMon.begin()   + from, vMon.begin()   + from + numChannels, b.vMon.begin()   + to);
+        std::copy(iMon.begin()   + from, iMon.begin()   + from + numChannels, b.iMon.begin()   + to);
+        std::copy(status.begin() + from, status.begin() + from + numChannels, b.status.begin() + to);
+        b.stamps[i] = stamps[s];
+    }
+
+    return n;
+}
+
+std::size_t BoardHistory::stats(std::size_t samples, Stats& v, Stats& i) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::size_t n = std::min(samples, count);
+    std::size_t first = ( next + depth - n ) % depth;
+
+    // Sample times, relative to their mean, for the slope
+    std::vector<double> dt(n);
+    double mean(0), dt2(0);
+
+    for (std::size_t k(0); k < n; ++k)
+    {
+        dt[k] = epicsTimeDiffInSeconds(&stamps[( first + k ) % depth], &stamps[first]);
+        mean += dt[k];
+    }
+
+    if (n)
+        mean /= n;
+
+    for (std::size_t k(0); k < n; ++k)
+    {
+        dt[k] -= mean;
+        dt2   += dt[k] * dt[k];
+    }
+
+    windowStats(vMon, depth, numChannels, first, n, dt, dt2, v);
+    windowStats(iMon, depth, numChannels, first, n, dt, dt2, i);
+
+    return n;
+}
@@ -0,0 +1,117 @@
+#ifndef BOARD_HISTORY_H
+#define BOARD_HISTORY_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : board_history.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Ring of the last acquired values of all the channels of a board
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <epicsTypes.h>
+#include <epicsTime.h>
+#include "board_snapshot.h"
+
+class BoardHistory;
+
+typedef std::shared_ptr<BoardHistory> History;
+
+// Fixed-size ring with the VMon, IMon and Status values of all the channels
+// of a board, for the last 'depth' acquisitions. The values are stored as
+// [sample][channel] contiguous arrays, so adding a sample is a single copy
+// per parameter. Only valid acquisitions are added.
+class BoardHistory
+{
+public:
+    // History of a channel, oldest sample first. The times are in seconds,
+    // relative to the newest sample, which was acquired at 'last'.
+    struct Trace
+    {
+        std::vector<epicsFloat64> vMon;
+        std::vector<epicsFloat64> iMon;
+        std::vector<epicsInt32>   status;
+        std::vector<epicsFloat64> time;
+        epicsTimeStamp            last;
+    };
+
+    // Last samples of all the channels, oldest first, as [sample][channel]
+    // arrays, with the time at which each sample was acquired
+    struct Block
+    {
+        std::vector<epicsFloat64>   vMon;
+        std::vector<epicsFloat64>   iMon;
+        std::vector<epicsInt32>     status;
+        std::vector<epicsTimeStamp> stamps;
+    };
+
+    // Statistics of a parameter over the last samples, per channel. The
+    // slope is the least squares fit of the values against time, in units
+    // per second.
+    struct Stats
+    {
+        std::vector<epicsFloat64> min;
+        std::vector<epicsFloat64> max;
+        std::vector<epicsFloat64> mean;
+        std::vector<epicsFloat64> rms;
+        std::vector<epicsFloat64> slope;
+    };
+
+    // 'vMon', 'iMon' and 'status' are the positions of those parameters in
+    // the board snapshot, or -1 if the board doesn't have them.
+    static History create(std::size_t depth, std::size_t numChannels, int vMon, int iMon, int status);
+
+    BoardHistory(std::size_t depth, std::size_t numChannels, int vMon, int iMon, int status);
+
+    // Add the values of a snapshot
+    void push(const BoardSnapshotData& d);
+
+    // Get the history of a channel. Returns the number of samples.
+    std::size_t read(std::size_t channel, Trace& t) const;
+
+    // Get the last 'samples' samples of all the channels. Returns the number
+    // of samples, which is lower if the history has less.
+    std::size_t readAll(std::size_t samples, Block& b) const;
+
+    // Get the statistics of VMon and IMon over the last 'samples' samples of
+    // all the channels. Returns the number of samples used, which is lower
+    // if the history has less. The arrays are empty if there are none.
+    std::size_t stats(std::size_t samples, Stats& v, Stats& i) const;
+
+    std::size_t getDepth()       const { return depth;       };
+    std::size_t getNumChannels() const { return numChannels; };
+
+private:
+    std::size_t depth;
+    std::size_t numChannels;
+    int         vMonIndex;
+    int         iMonIndex;
+    int         statusIndex;
+
+    mutable std::mutex          mutex;
+    std::size_t                 next;  // Position of the next sample
+    std::size_t                 count; // Number of samples
+    std::vector<float>          vMon;
+    std::vector<float>          iMon;
+    std::vector<uint32_t>       status;
+    std::vector<epicsTimeStamp> stamps;
+};
+
+#endif
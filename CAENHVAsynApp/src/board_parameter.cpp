@@ -23,9 +23,10 @@
 
 // Base class for all parameter types
 template<typename T>
-BoardParameterBase<T>::BoardParameterBase(int h, std::size_t s, const std::string&  p, uint32_t m)
+BoardParameterBase<T>::BoardParameterBase(int h, const Stats& st, std::size_t s, const std::string&  p, uint32_t m)
 :
     handle(h),
+    stats(st),
     slot(s),
     param(p),
     mode(m)
@@ -64,7 +65,7 @@ T BoardParameterBase<T>::getVal() const
     T temp;
 
     uint16_t tempSlot = slot;
-    if ( CAENHV_GetBdParam(handle, 1, &tempSlot, param.c_str(), &temp) != CAENHV_OK )
+    if ( timedCall(stats, WrapperStats::GetBdParam, slot, [&]() { return CAENHV_GetBdParam(handle, 1, &tempSlot, param.c_str(), &temp); }) != CAENHV_OK )
            throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
 
     return temp;
@@ -77,7 +78,7 @@ void BoardParameterBase<T>::setVal(T value) const
         return;
 
     uint16_t tempSlot = slot;
-    if ( CAENHV_SetBdParam(handle, 1, &tempSlot, param.c_str(), &value) != CAENHV_OK )
+    if ( timedCall(stats, WrapperStats::SetBdParam, slot, [&]() { return CAENHV_SetBdParam(handle, 1, &tempSlot, param.c_str(), &value); }) != CAENHV_OK )
            throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
 }
 template<typename T>
@@ -92,34 +93,34 @@ void BoardParameterBase<T>::printInfo(std::ostream& stream) const
 }
 
 // Class for Numeric parameters
-BoardParameterNumeric IBoardParameterNumeric::create(int h, std::size_t s, const std::string&  p, uint32_t m)
+BoardParameterNumeric IBoardParameterNumeric::create(int h, const Stats& st, std::size_t s, const std::string&  p, uint32_t m)
 {
-    return std::make_shared<IBoardParameterNumeric>(h, s, p, m);
+    return std::make_shared<IBoardParameterNumeric>(h, st, s, p, m);
 }
 
-IBoardParameterNumeric::IBoardParameterNumeric(int h, std::size_t s, const std::string&  p, uint32_t m)
+IBoardParameterNumeric::IBoardParameterNumeric(int h, const Stats& st, std::size_t s, const std::string&  p, uint32_t m)
 :
-    BoardParameterBase<float>(h, s, p, m)
+    BoardParameterBase<float>(h, st, s, p, m)
 {
    float temp;
 
-   if ( CAENHV_GetBdParamProp(handle, slot, param.c_str(), "Minval", &temp ) != CAENHV_OK )
+   if ( timedCall(stats, WrapperStats::GetBdParamProp, slot, [&]() { return CAENHV_GetBdParamProp(handle, slot, param.c_str(), "Minval", &temp ); }) != CAENHV_OK )
        throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
 
    minVal = temp;
 
-   if ( CAENHV_GetBdParamProp(handle, slot, param.c_str(), "Maxval", &temp ) != CAENHV_OK )
+   if ( timedCall(stats, WrapperStats::GetBdParamProp, slot, [&]() { return CAENHV_GetBdParamProp(handle, slot, param.c_str(), "Maxval", &temp ); }) != CAENHV_OK )
        throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
 
    maxVal = temp;
 
    // Extract uints
    uint16_t u;
-   if ( CAENHV_GetBdParamProp(handle, slot, param.c_str(), "Unit", &u ) != CAENHV_OK )
+   if ( timedCall(stats, WrapperStats::GetBdParamProp, slot, [&]() { return CAENHV_GetBdParamProp(handle, slot, param.c_str(), "Unit", &u ); }) != CAENHV_OK )
        throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
 
    int8_t e;
-   if ( CAENHV_GetBdParamProp(handle, slot, param.c_str(), "Exp", &e ) != CAENHV_OK )
+   if ( timedCall(stats, WrapperStats::GetBdParamProp, slot, [&]() { return CAENHV_GetBdParamProp(handle, slot, param.c_str(), "Exp", &e ); }) != CAENHV_OK )
        throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
 
    units = processUnits(u, e);
@@ -138,23 +139,23 @@ void IBoardParameterNumeric::printInfo(std::ostream& stream) const
 }
 
 // Class for OnOff parameters
-BoardParameterOnOff IBoardParameterOnOff::create(int h, std::size_t s, const std::string&  p, uint32_t m)
+BoardParameterOnOff IBoardParameterOnOff::create(int h, const Stats& st, std::size_t s, const std::string&  p, uint32_t m)
 {
-    return std::make_shared<IBoardParameterOnOff>(h, s, p, m);
+    return std::make_shared<IBoardParameterOnOff>(h, st, s, p, m);
 }
 
-IBoardParameterOnOff::IBoardParameterOnOff(int h, std::size_t s, const std::string&  p, uint32_t m)
+IBoardParameterOnOff::IBoardParameterOnOff(int h, const Stats& st, std::size_t s, const std::string&  p, uint32_t m)
 :
-    BoardParameterBase<uint32_t>(h, s, p, m)
+    BoardParameterBase<uint32_t>(h, st, s, p, m)
 {
    char temp[30];
 
-   if ( CAENHV_GetBdParamProp(handle, slot, param.c_str(), "Onstate", temp ) != CAENHV_OK )
+   if ( timedCall(stats, WrapperStats::GetBdParamProp, slot, [&]() { return CAENHV_GetBdParamProp(handle, slot, param.c_str(), "Onstate", temp ); }) != CAENHV_OK )
        throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
 
    onState = temp;
 
-   if ( CAENHV_GetBdParamProp(handle, slot, param.c_str(), "Offstate", temp ) != CAENHV_OK )
+   if ( timedCall(stats, WrapperStats::GetBdParamProp, slot, [&]() { return CAENHV_GetBdParamProp(handle, slot, param.c_str(), "Offstate", temp ); }) != CAENHV_OK )
        throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
 
     offState = temp;
@@ -172,25 +173,25 @@ void IBoardParameterOnOff::printInfo(std::ostream& stream) const
 }
 
 // Class for ChStatus parameters
-IBoardParameterChStatus::IBoardParameterChStatus(int h, std::size_t s, const std::string&  p, uint32_t m)
+IBoardParameterChStatus::IBoardParameterChStatus(int h, const Stats& st, std::size_t s, const std::string&  p, uint32_t m)
 :
-    BoardParameterBase<uint32_t>(h, s, p, m)
+    BoardParameterBase<uint32_t>(h, st, s, p, m)
 {
 }
 
-BoardParameterChStatus IBoardParameterChStatus::create(int h, std::size_t s, const std::string&  p, uint32_t m)
+BoardParameterChStatus IBoardParameterChStatus::create(int h, const Stats& st, std::size_t s, const std::string&  p, uint32_t m)
 {
-    return std::make_shared<IBoardParameterChStatus>(h, s, p, m);
+    return std::make_shared<IBoardParameterChStatus>(h, st, s, p, m);
 }
 
 // Class for BdStatus parameters
-IBoardParameterBdStatus::IBoardParameterBdStatus(int h, std::size_t s, const std::string&  p, uint32_t m)
+IBoardParameterBdStatus::IBoardParameterBdStatus(int h, const Stats& st, std::size_t s, const std::string&  p, uint32_t m)
 :
-    BoardParameterBase<uint32_t>(h, s, p, m)
+    BoardParameterBase<uint32_t>(h, st, s, p, m)
 {
 }
 
-BoardParameterBdStatus IBoardParameterBdStatus::create(int h, std::size_t s, const std::string&  p, uint32_t m)
+BoardParameterBdStatus IBoardParameterBdStatus::create(int h, const Stats& st, std::size_t s, const std::string&  p, uint32_t m)
 {
-    return std::make_shared<IBoardParameterBdStatus>(h, s, p, m);
+    return std::make_shared<IBoardParameterBdStatus>(h, st, s, p, m);
 }
\ No newline at end of file
@@ -60,10 +60,12 @@ template<typename T>
 class BoardParameterBase
 {
 public:
-    BoardParameterBase(int h, std::size_t s, const std::string&  p, uint32_t m);
+    BoardParameterBase(int h, const Stats& st, std::size_t s, const std::string&  p, uint32_t m);
     virtual ~BoardParameterBase() {};
 
     std::string getMode()            { return modeStr;         };
+    std::size_t getSlot()            { return slot;            };
+    std::string getParam()           { return param;           };
     std::string getEpicsParamName()  { return epicsParamName;  };
     std::string getEpicsRecordName() { return epicsRecordName; };
     std::string getEpicsDesc()       { return epicsDesc;       };
@@ -75,6 +77,7 @@ public:
 
 protected:
     int         handle;
+    Stats       stats;
     std::size_t slot;
     std::string param;
     uint32_t    mode;
@@ -88,11 +91,11 @@ protected:
 class IBoardParameterNumeric : public BoardParameterBase<float>
 {
 public:
-    IBoardParameterNumeric(int h, std::size_t s, const std::string&  p, uint32_t m);
+    IBoardParameterNumeric(int h, const Stats& st, std::size_t s, const std::string&  p, uint32_t m);
     ~IBoardParameterNumeric() {};
 
     // Factory method
-    static BoardParameterNumeric create(int h, std::size_t s, const std::string&  p, uint32_t m);
+    static BoardParameterNumeric create(int h, const Stats& st, std::size_t s, const std::string&  p, uint32_t m);
 
     float       getMinVal() const { return minVal; };
     float       getMaxVal() const { return maxVal; };
@@ -110,11 +113,11 @@ private:
 class  IBoardParameterOnOff : public BoardParameterBase<uint32_t>
 {
 public:
-    IBoardParameterOnOff(int h, std::size_t s, const std::string&  p, uint32_t m);
+    IBoardParameterOnOff(int h, const Stats& st, std::size_t s, const std::string&  p, uint32_t m);
     ~IBoardParameterOnOff() {};
 
     // Factory method
-    static BoardParameterOnOff create(int h, std::size_t s, const std::string&  p, uint32_t m);
+    static BoardParameterOnOff create(int h, const Stats& st, std::size_t s, const std::string&  p, uint32_t m);
 
     const std::string& getOnState()  const { return onState;  };
     const std::string& getOffState() const { return offState; };
@@ -130,22 +133,22 @@ private:
 class IBoardParameterChStatus : public BoardParameterBase<uint32_t>
 {
 public:
-    IBoardParameterChStatus(int h, std::size_t s, const std::string&  p, uint32_t m);
+    IBoardParameterChStatus(int h, const Stats& st, std::size_t s, const std::string&  p, uint32_t m);
     virtual ~IBoardParameterChStatus() {};
 
     // Factory method
-    static BoardParameterChStatus create(int h, std::size_t s, const std::string&  p, uint32_t m);
+    static BoardParameterChStatus create(int h, const Stats& st, std::size_t s, const std::string&  p, uint32_t m);
 };
 
 // Class for BdStatus parameters
 class IBoardParameterBdStatus : public BoardParameterBase<uint32_t>
 {
 public:
-    IBoardParameterBdStatus(int h, std::size_t s, const std::string&  p, uint32_t m);
+    IBoardParameterBdStatus(int h, const Stats& st, std::size_t s, const std::string&  p, uint32_t m);
     virtual ~IBoardParameterBdStatus() {};
 
     // Factory method
-    static BoardParameterBdStatus create(int h, std::size_t s, const std::string&  p, uint32_t m);
+    static BoardParameterBdStatus create(int h, const Stats& st, std::size_t s, const std::string&  p, uint32_t m);
 };
 
 #endif
@@ -0,0 +1,124 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : board_snapshot.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Lock-free snapshot of the values acquired from a board
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include "board_snapshot.h"
+
+void BoardSnapshotData::resize(std::size_t nChFloats, std::size_t nChWords, std::size_t nBdFloats, std::size_t nBdWords, std::size_t nChannels)
+{
+    numChannels = nChannels;
+    chFloats.assign(nChFloats * nChannels, 0);
+    chWords.assign(nChWords * nChannels, 0);
+    bdFloats.assign(nBdFloats, 0);
+    bdWords.assign(nBdWords, 0);
+}
+
+BoardSnapshot::BoardSnapshot()
+:
+    current(0)
+{
+}
+
+void BoardSnapshot::resize(std::size_t nChFloats, std::size_t nChWords, std::size_t nBdFloats, std::size_t nBdWords, std::size_t nChannels)
+{
+    for (std::size_t i(0); i < 2; ++i)
+        buffers[i].data.resize(nChFloats, nChWords, nBdFloats, nBdWords, nChannels);
+}
+
+void BoardSnapshot::publish(const BoardSnapshotData& d)
+{
+    // Write on the buffer that is not being currently published
+    unsigned idx = 1 - current.load(std::memory_order_relaxed);
+    Buffer& b = buffers[idx];
+
+    // Mark the buffer as being written
+    unsigned s = b.seq.load(std::memory_order_relaxed);
+    b.seq.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // The sizes are fixed, so the vectors are never reallocated here
+    b.data.stamp    = d.stamp;
+    b.data.duration = d.duration;
+    b.data.valid    = d.valid;
+    std::copy(d.chFloats.begin(), d.chFloats.end(), b.data.chFloats.begin());
+    std::copy(d.chWords.begin(),  d.chWords.end(),  b.data.chWords.begin());
+    std::copy(d.bdFloats.begin(), d.bdFloats.end(), b.data.bdFloats.begin());
+    std::copy(d.bdWords.begin(),  d.bdWords.end(),  b.data.bdWords.begin());
+
+    // Mark the buffer as consistent, and make it the current one
+    b.seq.store(s + 2, std::memory_order_release);
+    current.store(idx, std::memory_order_release);
+}
+
+void BoardSnapshot::read(BoardSnapshotData& d) const
+{
+    readConsistent( [&d](const BoardSnapshotData& s)
+    {
+        d.stamp       = s.stamp;
+        d.duration    = s.duration;
+        d.valid       = s.valid;
+        d.numChannels = s.numChannels;
+        d.chFloats.assign(s.chFloats.begin(), s.chFloats.end());
+        d.chWords.assign(s.chWords.begin(),   s.chWords.end());
+        d.bdFloats.assign(s.bdFloats.begin(), s.bdFloats.end());
+        d.bdWords.assign(s.bdWords.begin(),   s.bdWords.end());
+        return s.valid;
+    } );
+}
+
+bool BoardSnapshot::readChFloat(std::size_t p, std::size_t c, float& v, epicsTimeStamp& stamp) const
+{
+    return readConsistent( [&](const BoardSnapshotData& s)
+    {
+        v     = s.chFloats[p * s.numChannels + c];
+        stamp = s.stamp;
+        return s.valid;
+    } );
+}
+
+bool BoardSnapshot::readChWord(std::size_t p, std::size_t c, uint32_t& v, epicsTimeStamp& stamp) const
+{
+    return readConsistent( [&](const BoardSnapshotData& s)
+    {
+        v     = s.chWords[p * s.numChannels + c];
+        stamp = s.stamp;
+        return s.valid;
+    } );
+}
+
+bool BoardSnapshot::readBdFloat(std::size_t p, float& v, epicsTimeStamp& stamp) const
+{
+    return readConsistent( [&](const BoardSnapshotData& s)
+    {
+        v     = s.bdFloats[p];
+        stamp = s.stamp;
+        return s.valid;
+    } );
+}
+
+bool BoardSnapshot::readBdWord(std::size_t p, uint32_t& v, epicsTimeStamp& stamp) const
+{
+    return readConsistent( [&](const BoardSnapshotData& s)
+    {
+        v     = s.bdWords[p];
+        stamp = s.stamp;
+        return s.valid;
+    } );
+}
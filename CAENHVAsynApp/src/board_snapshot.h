@@ -0,0 +1,109 @@
+#ifndef BOARD_SNAPSHOT_H
+#define BOARD_SNAPSHOT_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : board_snapshot.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Lock-free snapshot of the values acquired from a board
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <stdint.h>
+#include <epicsTime.h>
+
+// Values of all the readable parameters of a board, acquired together.
+// Channel values are stored as [parameter][channel] contiguous arrays.
+struct BoardSnapshotData
+{
+    BoardSnapshotData() : duration(0), valid(false), numChannels(0) { stamp.secPastEpoch = 0; stamp.nsec = 0; };
+
+    void resize(std::size_t nChFloats, std::size_t nChWords, std::size_t nBdFloats, std::size_t nBdWords, std::size_t nChannels);
+
+    epicsTimeStamp        stamp;     // Time at which the acquisition started
+    double                duration;  // Time the acquisition took, in seconds
+    bool                  valid;     // False if the acquisition failed
+    std::size_t           numChannels;
+    std::vector<float>    chFloats;  // Numeric channel parameters
+    std::vector<uint32_t> chWords;   // OnOff and ChStatus channel parameters
+    std::vector<float>    bdFloats;  // Numeric board parameters
+    std::vector<uint32_t> bdWords;   // OnOff, ChStatus and BdStatus board parameters
+};
+
+// Sequence-locked double buffer. There is a single writer (the acquisition
+// thread), which never waits for the readers. Readers never block either:
+// they retry if the buffer they were reading was overwritten in the mean time,
+// which can only happen if they are slower than two acquisition cycles.
+class BoardSnapshot
+{
+public:
+    BoardSnapshot();
+
+    // Must be called before any publish() or read()
+    void resize(std::size_t nChFloats, std::size_t nChWords, std::size_t nBdFloats, std::size_t nBdWords, std::size_t nChannels);
+
+    // Writer side
+    void publish(const BoardSnapshotData& d);
+
+    // Reader side: copy the whole snapshot
+    void read(BoardSnapshotData& d) const;
+
+    // Reader side: get a single value, and the time it was acquired.
+    // Return false if there is no valid value.
+    bool readChFloat(std::size_t p, std::size_t c, float&    v, epicsTimeStamp& stamp) const;
+    bool readChWord (std::size_t p, std::size_t c, uint32_t& v, epicsTimeStamp& stamp) const;
+    bool readBdFloat(std::size_t p,                float&    v, epicsTimeStamp& stamp) const;
+    bool readBdWord (std::size_t p,                uint32_t& v, epicsTimeStamp& stamp) const;
+
+private:
+    struct Buffer
+    {
+        Buffer() : seq(0) {};
+
+        std::atomic<unsigned> seq;
+        BoardSnapshotData     data;
+    };
+
+    template<typename F>
+    bool readConsistent(F f) const;
+
+    Buffer                buffers[2];
+    std::atomic<unsigned> current;
+};
+
+template<typename F>
+bool BoardSnapshot::readConsistent(F f) const
+{
+    while (true)
+    {
+        const Buffer& b = buffers[current.load(std::memory_order_acquire)];
+
+        unsigned s1 = b.seq.load(std::memory_order_acquire);
+        if (s1 & 1)
+            continue;
+
+        bool ok = f(b.data);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (b.seq.load(std::memory_order_relaxed) == s1)
+            return ok;
+    }
+}
+
+#endif
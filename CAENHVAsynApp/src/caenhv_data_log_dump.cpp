@@ -0,0 +1,172 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : caenhv_data_log_dump.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Prints the records, or a summary, of a data log file written by the
+ * driver.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <getopt.h>
+#include "data_log.h"
+
+namespace
+{
+    // Seconds between the Unix and the EPICS epochs
+    const uint32_t epicsEpoch = 631152000u;
+
+    void usage(const char* name)
+    {
+        std::cout << "Usage: " << name << " [options] FILE" << std::endl;
+        std::cout << "  -s, --summary             Only print the header and the parameters" << std::endl;
+        std::cout << "  -S, --slot SLOT           Only print the records of a slot" << std::endl;
+        std::cout << "  -p, --param NAME          Only print the records of a parameter" << std::endl;
+        std::cout << "  -h, --help                Show this message" << std::endl;
+    }
+
+    std::string formatTime(uint32_t secPastEpoch, uint32_t nsec)
+    {
+        time_t t = static_cast<time_t>(secPastEpoch) + epicsEpoch;
+        struct tm tm;
+        char buf[32];
+        strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", localtime_r(&t, &tm));
+
+        char frac[16];
+        snprintf(frac, sizeof(frac), ".%06u", nsec / 1000);
+
+        return std::string(buf) + frac;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    bool        summaryOnly(false);
+    long        slot(-1);
+    std::string param;
+
+    static struct option longOptions[] =
+    {
+        { "summary", no_argument,       0, 's' },
+        { "slot",    required_argument, 0, 'S' },
+        { "param",   required_argument, 0, 'p' },
+        { "help",    no_argument,       0, 'h' },
+        { 0,         0,                 0, 0   }
+    };
+
+    int c;
+    while ( ( c = getopt_long(argc, argv, "sS:p:h", longOptions, NULL) ) != -1 )
+    {
+        switch (c)
+        {
+            case 's':
+                summaryOnly = true;
+                break;
+            case 'S':
+                slot = strtol(optarg, NULL, 0);
+                break;
+            case 'p':
+                param = optarg;
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (optind != argc - 1)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    DataLogReader reader;
+    if (!reader.open(argv[optind]))
+    {
+        std::cerr << "'" << argv[optind] << "' is not a data log file" << std::endl;
+        return 1;
+    }
+
+    const std::vector<DataLogParam>& params = reader.getParams();
+    std::size_t n = reader.getNumRecords();
+
+    if (summaryOnly)
+    {
+        std::cout << "Records: " << n << " of " << reader.getCapacity() << ", written: " << reader.getWritten() << std::endl;
+        std::cout << std::setw(6) << "Id" << std::setw(6) << "Slot" << "  " << std::left << std::setw(24) << "Parameter"
+                  << std::setw(8) << "Type" << std::right << std::setw(10) << "Channels" << std::endl;
+
+        for (std::size_t i(0); i < params.size(); ++i)
+        {
+            const DataLogParam& p = params.at(i);
+            std::cout << std::setw(6) << i << std::setw(6) << p.slot << "  " << std::left << std::setw(24) << p.name
+                      << std::setw(8) << ( ( p.type == DataLogParam::Float ) ? "float" : "word" ) << std::right
+                      << std::setw(10) << p.numChannels << std::endl;
+        }
+
+        return 0;
+    }
+
+    unsigned long skipped(0);
+    DataLogRecord r;
+
+    for (std::size_t i(0); i < n; ++i)
+    {
+        if (!reader.read(i, r))
+        {
+            ++skipped;
+            continue;
+        }
+
+        if ( ( r.param >= params.size() ) || ( ( slot >= 0 ) && ( r.slot != slot ) ) ||
+             ( ( !param.empty() ) && ( params.at(r.param).name != param ) ) )
+            continue;
+
+        const DataLogParam& p = params.at(r.param);
+
+        std::cout << formatTime(r.secPastEpoch, r.nsec) << "  " << std::setw(2) << r.slot << "  " << std::left
+                  << std::setw(12) << p.name << std::right;
+
+        for (std::vector<uint32_t>::const_iterator it = r.values.begin(); it != r.values.end(); ++it)
+        {
+            if (p.type == DataLogParam::Float)
+            {
+                float f;
+                memcpy(&f, &(*it), sizeof(f));
+                std::cout << " " << f;
+            }
+            else
+            {
+                std::cout << " 0x" << std::hex << *it << std::dec;
+            }
+        }
+
+        std::cout << std::endl;
+    }
+
+    if (skipped)
+        std::cerr << skipped << " records were being written, and were skipped" << std::endl;
+
+    return 0;
+}
@@ -21,18 +21,19 @@
 
 #include "channel.h"
 
-IChannel::IChannel(int h, std::size_t s, std::size_t c)
+IChannel::IChannel(int h, const Stats& st, std::size_t s, std::size_t c)
 :
     handle(h),
+    stats(st),
     slot(s),
     channel(c)
 {
     GetChannelParams();
 }
 
-Channel IChannel::create(int h, std::size_t s, std::size_t c)
+Channel IChannel::create(int h, const Stats& st, std::size_t s, std::size_t c)
 {
-    return std::make_shared<IChannel>(h, s, c);
+    return std::make_shared<IChannel>(h, st, s, c);
 }
 
 void IChannel::printInfo(std::ostream& stream) const
@@ -66,7 +67,7 @@ void IChannel::GetChannelParams()
 
     char *ParNameList = (char *)NULL;
     int ParNumber(0);
-    CAENHVRESULT r = CAENHV_GetChParamInfo(handle, slot, channel, &ParNameList, &ParNumber);
+    CAENHVRESULT r = timedCall(stats, WrapperStats::GetChParamInfo, slot, [&]() { return CAENHV_GetChParamInfo(handle, slot, channel, &ParNameList, &ParNumber); });
 
     std::stringstream retMessage;
     retMessage << "CAENHV_GetChParamInfo (slot = " << slot << ") : " << CAENHV_GetError(handle) << " (num. " << r << ")";
@@ -93,20 +94,20 @@ void IChannel::GetChannelParams()
 
         uint32_t type, mode;
 
-        if ( CAENHV_GetChParamProp(handle, slot, channel, p[i], "Type", &type) != CAENHV_OK )
+        if ( timedCall(stats, WrapperStats::GetChParamProp, slot, [&]() { return CAENHV_GetChParamProp(handle, slot, channel, p[i], "Type", &type); }) != CAENHV_OK )
             throw std::runtime_error("CAENHV_GetChParamProp failed: " + std::string(CAENHV_GetError(handle)));
 
-        if (CAENHV_GetChParamProp(handle, slot, channel, p[i], "Mode", &mode) != CAENHV_OK )
+        if (timedCall(stats, WrapperStats::GetChParamProp, slot, [&]() { return CAENHV_GetChParamProp(handle, slot, channel, p[i], "Mode", &mode); }) != CAENHV_OK )
             throw std::runtime_error("CAENHV_GetChParamProp failed: " + std::string(CAENHV_GetError(handle)));
 
         if (type == PARAM_TYPE_NUMERIC)
-            channelParameterNumerics.push_back( IChannelParameterNumeric::create(handle, slot, channel, p[i], mode) );
+            channelParameterNumerics.push_back( IChannelParameterNumeric::create(handle, stats, slot, channel, p[i], mode) );
         else if (type == PARAM_TYPE_ONOFF)
-            channelParameterOnOffs.push_back( IChannelParameterOnOff::create(handle, slot, channel, p[i], mode) );
+            channelParameterOnOffs.push_back( IChannelParameterOnOff::create(handle, stats, slot, channel, p[i], mode) );
         else if (type == PARAM_TYPE_CHSTATUS)
-            channelParameterChStatuses.push_back( IChannelParameterChStatus::create(handle, slot, channel, p[i], mode) );
+            channelParameterChStatuses.push_back( IChannelParameterChStatus::create(handle, stats, slot, channel, p[i], mode) );
         else if (type == PARAM_TYPE_BINARY)
-            channelParameterBinaries.push_back( IChannelParameterBinary::create(handle, slot, channel, p[i], mode) );
+            channelParameterBinaries.push_back( IChannelParameterBinary::create(handle, stats, slot, channel, p[i], mode) );
         else
             //throw std::runtime_error("Parameter type not  supported!");
             std::cerr << "Error found when creating a Board Parameter object for pamater '" << p[i] << "'. Unsupported type = " << type << std::endl;
@@ -49,11 +49,11 @@ typedef std::shared_ptr<IChannel> Channel;
 class IChannel
 {
 public:
-    IChannel(int h, std::size_t s, std::size_t c);
+    IChannel(int h, const Stats& st, std::size_t s, std::size_t c);
     ~IChannel() {};
 
     // Factory method
-    static Channel create(int h, std::size_t s, std::size_t c);
+    static Channel create(int h, const Stats& st, std::size_t s, std::size_t c);
 
     void printInfo(std::ostream& stream) const;
 
@@ -62,11 +62,14 @@ public:
     std::vector<ChannelParameterChStatus> getChannelParameterChStatuses() { return channelParameterChStatuses; };
     std::vector<ChannelParameterBinary>   getChannelParameterBinaries()   { return channelParameterBinaries;   };
 
+    std::size_t getChannel() const { return channel; };
+
 private:
 
     void GetChannelParams();
 
     int                         handle;
+    Stats                       stats;
     std::size_t                 slot;
     std::size_t                 channel;
 
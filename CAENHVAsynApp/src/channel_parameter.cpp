@@ -23,9 +23,10 @@
 
 // Base class for all parameter types
 template<typename T>
-ChannelParameterBase<T>::ChannelParameterBase(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
+ChannelParameterBase<T>::ChannelParameterBase(int h, const Stats& st, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
 :
     handle(h),
+    stats(st),
     slot(s),
     channel(c),
     param(p),
@@ -68,7 +69,7 @@ T ChannelParameterBase<T>::getVal() const
     T temp;
 
     uint16_t temp_chs = channel;
-    if ( CAENHV_GetChParam(handle, slot, param.c_str(), 1, &temp_chs, &temp) != CAENHV_OK )
+    if ( timedCall(stats, WrapperStats::GetChParam, slot, [&]() { return CAENHV_GetChParam(handle, slot, param.c_str(), 1, &temp_chs, &temp); }) != CAENHV_OK )
            throw std::runtime_error("CAENHV_GetChParam failed: " + std::string(CAENHV_GetError(handle)));
 
     return temp;
@@ -81,7 +82,7 @@ void ChannelParameterBase<T>::setVal(T value) const
         return;
 
     uint16_t temp_chs = channel;
-    if ( CAENHV_SetChParam(handle, slot, param.c_str(), 1, &temp_chs, &value) != CAENHV_OK )
+    if ( timedCall(stats, WrapperStats::SetChParam, slot, [&]() { return CAENHV_SetChParam(handle, slot, param.c_str(), 1, &temp_chs, &value); }) != CAENHV_OK )
            throw std::runtime_error("CAENHV_SetChParam failed: " + std::string(CAENHV_GetError(handle)));
 }
 
@@ -97,34 +98,34 @@ void ChannelParameterBase<T>::printInfo(std::ostream& stream) const
 }
 
 // Class for Numeric parameters
-ChannelParameterNumeric IChannelParameterNumeric::create(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
+ChannelParameterNumeric IChannelParameterNumeric::create(int h, const Stats& st, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
 {
-    return std::make_shared<IChannelParameterNumeric>(h, s, c, p, m);
+    return std::make_shared<IChannelParameterNumeric>(h, st, s, c, p, m);
 }
 
-IChannelParameterNumeric::IChannelParameterNumeric(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
+IChannelParameterNumeric::IChannelParameterNumeric(int h, const Stats& st, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
 :
-    ChannelParameterBase<float>(h, s, c, p, m)
+    ChannelParameterBase<float>(h, st, s, c, p, m)
 {
    float temp;
 
-   if ( CAENHV_GetChParamProp(handle, slot, channel, param.c_str(), "Minval", &temp ) != CAENHV_OK )
+   if ( timedCall(stats, WrapperStats::GetChParamProp, slot, [&]() { return CAENHV_GetChParamProp(handle, slot, channel, param.c_str(), "Minval", &temp ); }) != CAENHV_OK )
        throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
 
    minVal = temp;
 
-   if ( CAENHV_GetChParamProp(handle, slot, channel, param.c_str(), "Maxval", &temp ) != CAENHV_OK )
+   if ( timedCall(stats, WrapperStats::GetChParamProp, slot, [&]() { return CAENHV_GetChParamProp(handle, slot, channel, param.c_str(), "Maxval", &temp ); }) != CAENHV_OK )
        throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
 
    maxVal = temp;
 
    // Extract uints
    uint16_t u;
-   if ( CAENHV_GetChParamProp(handle, slot, channel, param.c_str(), "Unit", &u ) != CAENHV_OK )
+   if ( timedCall(stats, WrapperStats::GetChParamProp, slot, [&]() { return CAENHV_GetChParamProp(handle, slot, channel, param.c_str(), "Unit", &u ); }) != CAENHV_OK )
        throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
 
    int8_t e;
-   if ( CAENHV_GetChParamProp(handle, slot, channel, param.c_str(), "Exp", &e ) != CAENHV_OK )
+   if ( timedCall(stats, WrapperStats::GetChParamProp, slot, [&]() { return CAENHV_GetChParamProp(handle, slot, channel, param.c_str(), "Exp", &e ); }) != CAENHV_OK )
        throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
 
      units = processUnits(u, e);
@@ -144,23 +145,23 @@ void IChannelParameterNumeric::printInfo(std::ostream& stream) const
 }
 
 // Class for OnOff parameters
-ChannelParameterOnOff IChannelParameterOnOff::create(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
+ChannelParameterOnOff IChannelParameterOnOff::create(int h, const Stats& st, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
 {
-    return std::make_shared<IChannelParameterOnOff>(h, s, c, p, m);
+    return std::make_shared<IChannelParameterOnOff>(h, st, s, c, p, m);
 }
 
-IChannelParameterOnOff::IChannelParameterOnOff(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
+IChannelParameterOnOff::IChannelParameterOnOff(int h, const Stats& st, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
 :
-    ChannelParameterBase<uint32_t>(h, s, c, p, m)
+    ChannelParameterBase<uint32_t>(h, st, s, c, p, m)
 {
    char temp[30];
 
-   if ( CAENHV_GetChParamProp(handle, slot, channel, param.c_str(), "Onstate", temp ) != CAENHV_OK )
+   if ( timedCall(stats, WrapperStats::GetChParamProp, slot, [&]() { return CAENHV_GetChParamProp(handle, slot, channel, param.c_str(), "Onstate", temp ); }) != CAENHV_OK )
        throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
 
    onState = temp;
 
-   if ( CAENHV_GetChParamProp(handle, slot, channel, param.c_str(), "Offstate", temp ) != CAENHV_OK )
+   if ( timedCall(stats, WrapperStats::GetChParamProp, slot, [&]() { return CAENHV_GetChParamProp(handle, slot, channel, param.c_str(), "Offstate", temp ); }) != CAENHV_OK )
        throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
 
     offState = temp;
@@ -180,15 +181,15 @@ void IChannelParameterOnOff::printInfo(std::ostream& stream) const
 }
 
 // Class for ChStatus parameters
-IChannelParameterChStatus::IChannelParameterChStatus(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
+IChannelParameterChStatus::IChannelParameterChStatus(int h, const Stats& st, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
 :
-    ChannelParameterBase<uint32_t>(h, s, c, p, m)
+    ChannelParameterBase<uint32_t>(h, st, s, c, p, m)
 {
 }
 
-ChannelParameterChStatus IChannelParameterChStatus::create(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
+ChannelParameterChStatus IChannelParameterChStatus::create(int h, const Stats& st, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
 {
-    return std::make_shared<IChannelParameterChStatus>(h, s, c, p, m);
+    return std::make_shared<IChannelParameterChStatus>(h, st, s, c, p, m);
 }
 
 void IChannelParameterChStatus::printInfo(std::ostream& stream) const
@@ -202,15 +203,15 @@ void IChannelParameterChStatus::printInfo(std::ostream& stream) const
 }
 
 // Class for Binary parameters
-IChannelParameterBinary::IChannelParameterBinary(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
+IChannelParameterBinary::IChannelParameterBinary(int h, const Stats& st, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
 :
-    ChannelParameterBase<int32_t>(h, s, c, p, m)
+    ChannelParameterBase<int32_t>(h, st, s, c, p, m)
 {
 }
 
-ChannelParameterBinary IChannelParameterBinary::create(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
+ChannelParameterBinary IChannelParameterBinary::create(int h, const Stats& st, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
 {
-    return std::make_shared<IChannelParameterBinary>(h, s, c, p, m);
+    return std::make_shared<IChannelParameterBinary>(h, st, s, c, p, m);
 }
 
 void IChannelParameterBinary::printInfo(std::ostream& stream) const
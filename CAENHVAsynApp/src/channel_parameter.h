@@ -57,10 +57,13 @@ template<typename T>
 class ChannelParameterBase
 {
 public:
-    ChannelParameterBase(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
+    ChannelParameterBase(int h, const Stats& st, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
     virtual ~ChannelParameterBase() {};
 
     std::string getMode()            { return modeStr;    };
+    std::size_t getSlot()            { return slot;            };
+    std::size_t getChannel()         { return channel;         };
+    std::string getParam()           { return param;      };
     std::string getEpicsParamName()  { return epicsParamName;  };
     std::string getEpicsRecordName() { return epicsRecordName; };
     std::string getEpicsDesc()       { return epicsDesc;       };
@@ -72,6 +75,7 @@ public:
 
 protected:
     int         handle;
+    Stats       stats;
     std::size_t slot;
     std::size_t channel;
     std::string param;
@@ -87,11 +91,11 @@ protected:
 class IChannelParameterNumeric : public ChannelParameterBase<float>
 {
 public:
-    IChannelParameterNumeric(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
+    IChannelParameterNumeric(int h, const Stats& st, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
     ~IChannelParameterNumeric() {};
 
     // Factory method
-    static ChannelParameterNumeric create(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
+    static ChannelParameterNumeric create(int h, const Stats& st, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
 
     float       getMinVal() const { return minVal; };
     float       getMaxVal() const { return maxVal; };
@@ -109,11 +113,11 @@ private:
 class IChannelParameterOnOff : public ChannelParameterBase<uint32_t>
 {
 public:
-    IChannelParameterOnOff(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
+    IChannelParameterOnOff(int h, const Stats& st, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
     ~IChannelParameterOnOff() {};
 
     // Factory method
-    static ChannelParameterOnOff create(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
+    static ChannelParameterOnOff create(int h, const Stats& st, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
 
     std::string getOnState()  const { return onState;  };
     std::string getOffState() const { return offState; };
@@ -129,11 +133,11 @@ private:
 class IChannelParameterChStatus : public ChannelParameterBase<uint32_t>
 {
 public:
-    IChannelParameterChStatus(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
+    IChannelParameterChStatus(int h, const Stats& st, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
     ~IChannelParameterChStatus() {};
 
     // Factory method
-    static ChannelParameterChStatus create(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
+    static ChannelParameterChStatus create(int h, const Stats& st, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
 
     virtual void printInfo(std::ostream& stream) const;
 };
@@ -142,11 +146,11 @@ public:
 class IChannelParameterBinary : public ChannelParameterBase<int32_t>
 {
 public:
-    IChannelParameterBinary(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
+    IChannelParameterBinary(int h, const Stats& st, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
     ~IChannelParameterBinary() {};
 
     // Factory method
-    static ChannelParameterBinary create(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
+    static ChannelParameterBinary create(int h, const Stats& st, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
 
     virtual void printInfo(std::ostream& stream) const;
 };
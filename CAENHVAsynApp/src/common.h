@@ -38,6 +38,7 @@
 #include <arpa/inet.h>
 #include <iostream>
 #include "CAENHVWrapper.h"
+#include "wrapper_stats.h"
 
 
 void printMessage(const std::string& f, const std::string& s);
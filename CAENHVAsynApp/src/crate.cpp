@@ -27,7 +27,7 @@ void ICrate::GetPropList()
 
     unsigned short NumProp;
     char *PropNameList;
-    CAENHVRESULT r =  CAENHV_GetSysPropList(handle, &NumProp, &PropNameList);
+    CAENHVRESULT r =  timedCall(stats, WrapperStats::GetSysPropList, WrapperStats::NoSlot, [&]() { return CAENHV_GetSysPropList(handle, &NumProp, &PropNameList); });
 
     std::stringstream retMessage;
     retMessage << "CAENHV_GetSysPropList: " << CAENHV_GetError(handle) << " (num. " << r << ")";
@@ -45,36 +45,36 @@ void ICrate::GetPropList()
         // Get Property info
         unsigned PropMode;
         unsigned PropType;
-        if ( CAENHV_GetSysPropInfo(handle, p, &PropMode, &PropType) == CAENHV_OK )
+        if ( timedCall(stats, WrapperStats::GetSysPropInfo, WrapperStats::NoSlot, [&]() { return CAENHV_GetSysPropInfo(handle, p, &PropMode, &PropType); }) == CAENHV_OK )
         {
             switch( PropType )
             {
                 case SYSPROP_TYPE_STR:
-                    systemPropertyStrings.push_back(ISystemPropertyString::create(handle, p, PropMode));
+                    systemPropertyStrings.push_back(ISystemPropertyString::create(handle, stats, p, PropMode));
                     break;
 
                 case SYSPROP_TYPE_REAL:
-                    systemPropertyFloats.push_back(ISystemPropertyFloat::create(handle, p, PropMode));
+                    systemPropertyFloats.push_back(ISystemPropertyFloat::create(handle, stats, p, PropMode));
                     break;
 
                 case SYSPROP_TYPE_UINT2:
-                    systemPropertyIntegers.push_back(ISystemPropertyIntegerTemplate<uint16_t>::create(handle, p, PropMode));
+                    systemPropertyIntegers.push_back(ISystemPropertyIntegerTemplate<uint16_t>::create(handle, stats, p, PropMode));
                     break;
 
                 case SYSPROP_TYPE_UINT4:
-                    systemPropertyIntegers.push_back(ISystemPropertyIntegerTemplate<uint32_t>::create(handle, p, PropMode));
+                    systemPropertyIntegers.push_back(ISystemPropertyIntegerTemplate<uint32_t>::create(handle, stats, p, PropMode));
                     break;
 
                 case SYSPROP_TYPE_INT2:
-                    systemPropertyIntegers.push_back(ISystemPropertyIntegerTemplate<int16_t>::create(handle, p, PropMode));
+                    systemPropertyIntegers.push_back(ISystemPropertyIntegerTemplate<int16_t>::create(handle, stats, p, PropMode));
                     break;
 
                 case SYSPROP_TYPE_INT4:
-                    systemPropertyIntegers.push_back(ISystemPropertyIntegerTemplate<int32_t>::create(handle, p, PropMode));
+                    systemPropertyIntegers.push_back(ISystemPropertyIntegerTemplate<int32_t>::create(handle, stats, p, PropMode));
                     break;
 
                 case SYSPROP_TYPE_BOOLEAN:
-                    systemPropertyIntegers.push_back(ISystemPropertyIntegerTemplate<uint8_t>::create(handle, p, PropMode));
+                    systemPropertyIntegers.push_back(ISystemPropertyIntegerTemplate<uint8_t>::create(handle, stats, p, PropMode));
                     break;
             }
 
@@ -97,7 +97,7 @@ void ICrate::GetCrateMap()
     unsigned char *FmwRelMinList;
     unsigned char *FmwRelMaxList;
 
-    CAENHVRESULT r = CAENHV_GetCrateMap(handle, &NrOfSlot, &NrOfChList, &ModelList, &DescriptionList, &SerNumList, &FmwRelMinList, &FmwRelMaxList);
+    CAENHVRESULT r = timedCall(stats, WrapperStats::GetCrateMap, WrapperStats::NoSlot, [&]() { return CAENHV_GetCrateMap(handle, &NrOfSlot, &NrOfChList, &ModelList, &DescriptionList, &SerNumList, &FmwRelMinList, &FmwRelMaxList); });
 
     std::stringstream retMessage;
     retMessage << "CAENHV_GetCrateMap: " << CAENHV_GetError(handle) << " (num. " << r << ")";
@@ -109,7 +109,7 @@ void ICrate::GetCrateMap()
 
 
     numSlots = NrOfSlot;
-    char *m = ModelList, *d = ModelList;
+    char *m = ModelList, *d = DescriptionList;
 
     for (std::size_t i(0); i < NrOfSlot; ++i, m += strlen(m) + 1, d += strlen(d) + 1)
     {
@@ -126,7 +126,7 @@ void ICrate::GetCrateMap()
             fw << unsigned(FmwRelMaxList[i]) << "." << unsigned(FmwRelMinList[i]);
 
             // Create a new Slot object and add it to the vector
-            boards.push_back( IBoard::create(handle, i, m, d, NrOfChList[i], sn.str(), fw.str()) );
+            boards.push_back( IBoard::create(handle, stats, i, m, d, NrOfChList[i], sn.str(), fw.str()) );
         }
     }
 
@@ -141,7 +141,7 @@ void ICrate::GetCrateMap()
 
 ICrate::ICrate(int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password)
 :
-  handle(-1), systemType_(systemType), ipAddr_(ipAddr), userName_(userName), password_(password)
+  handle(-1), stats(std::make_shared<WrapperStats>()), systemType_(systemType), ipAddr_(ipAddr), userName_(userName), password_(password)
 {
     handle = InitSystem();
     GetPropList();
@@ -162,12 +162,13 @@ int ICrate::InitSystem()
     int h;
     std::string functionName("initSystem");
 
-    CAENHVRESULT r = CAENHV_InitSystem( static_cast<CAENHV_SYSTEM_TYPE_t>(this->systemType_),
-                                        LINKTYPE_TCPIP,
-                                        const_cast<void*>( static_cast<const void*>( this->ipAddr_.c_str() ) ),
-                                        this->userName_.c_str(),
-                                        this->password_.c_str(),
-                                        &h );
+    CAENHVRESULT r = timedCall(stats, WrapperStats::InitSystem, WrapperStats::NoSlot, [&]() {
+        return CAENHV_InitSystem( static_cast<CAENHV_SYSTEM_TYPE_t>(this->systemType_),
+                                  LINKTYPE_TCPIP,
+                                  const_cast<void*>( static_cast<const void*>( this->ipAddr_.c_str() ) ),
+                                  this->userName_.c_str(),
+                                  this->password_.c_str(),
+                                  &h ); });
 
     std::stringstream retMessage;
     retMessage << "CAENHV_InitSystem: " << CAENHV_GetError(h) << " (num. " << r << ")";
@@ -190,13 +191,39 @@ int ICrate::InitSystem()
 void ICrate::ReinitSystem() {
 
     if (this->validHandle_) {
-        CAENHV_DeinitSystem(this->handle);
+        timedCall(this->stats, WrapperStats::DeinitSystem, WrapperStats::NoSlot, [&]() { return CAENHV_DeinitSystem(this->handle); });
         this->validHandle_ = false;
     }
     this->handle = this->InitSystem();
 
 }
 
+/**
+ * @brief Turns off all the channels in the crate.
+ * A single multi-channel CAENHV_SetChParam call is sent per board. All the
+ * boards are tried even if some of them fail, and the failures are reported
+ * at the end.
+ */
+void ICrate::allChannelsOff() const
+{
+    std::stringstream errors;
+
+    for (std::vector<Board>::const_iterator it = boards.begin(); it != boards.end(); ++it)
+    {
+        try
+        {
+            (*it)->allChannelsOff();
+        }
+        catch (const std::runtime_error& e)
+        {
+            errors << "Slot " << (*it)->getSlot() << ": " << e.what() << ". ";
+        }
+    }
+
+    if (!errors.str().empty())
+        throw std::runtime_error(errors.str());
+}
+
 void ICrate::printInfo(std::ostream& stream) const
 {
     stream << "=========================" << std::endl;;
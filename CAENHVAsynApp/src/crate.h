@@ -64,12 +64,22 @@ public:
     void printCrateMap(std::ostream& stream) const;
     void ReinitSystem();
 
+    // Turn off all the channels in the crate, using one wrapper call per board
+    void allChannelsOff() const;
+
     std::vector<SystemPropertyInteger> getSystemPropertyIntegers() { return systemPropertyIntegers; };
     std::vector<SystemPropertyFloat>   getSystemPropertyFloats()   { return systemPropertyFloats;   };
     std::vector<SystemPropertyString>  getSystemPropertyStrings()  { return systemPropertyStrings;  };
 
     std::vector<Board> getBoards() { return boards; };
 
+    // Handle used by all the crate, board and channel objects
+    int getHandle() const { return handle; };
+    // Latency statistics of the wrapper calls, kept across reinitializations
+    Stats getStats() const { return stats; };
+    const std::string& getIpAddr() const { return ipAddr_; };
+    bool isConnected() const { return validHandle_; };
+
 private:
 
     int  InitSystem();
@@ -80,6 +90,7 @@ private:
     void printProperties(std::ostream& stream, const std::string& type, const T& pv) const;
 
     int handle;
+    Stats stats;
     int systemType_;
     bool validHandle_ = false;
     std::string ipAddr_, userName_, password_;
@@ -0,0 +1,317 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : data_log.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Memory-mapped binary log of the acquired channel values
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <algorithm>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "data_log.h"
+
+namespace
+{
+    const char        logMagic[4]      = { 'C', 'H', 'V', 'L' };
+    const uint32_t    logVersion       = 1;
+    const std::size_t logFixedHeader   = 40; // Up to and including the number of records written
+    const std::size_t logWrittenOffset = 32;
+    const std::size_t logParamSize     = 40;
+    const std::size_t logParamName     = 24;
+    const std::size_t logRecordHeader  = 32;
+
+    // Sizes are multiple of 8 bytes, so the 64-bit counters are aligned
+    std::size_t align8(std::size_t n)
+    {
+        return ( n + 7 ) & ~static_cast<std::size_t>(7);
+    }
+
+    template <typename T>
+    void put(char* p, T v)
+    {
+        memcpy(p, &v, sizeof(T));
+    }
+
+    template <typename T>
+    T get(const char* p)
+    {
+        T v;
+        memcpy(&v, p, sizeof(T));
+        return v;
+    }
+}
+
+DataLogWriter::DataLogWriter()
+:
+    fd(-1),
+    base(NULL),
+    length(0),
+    headerSize(0),
+    recordSize(0),
+    capacity(0),
+    maxValues(0),
+    written(0)
+{
+}
+
+DataLogWriter::~DataLogWriter()
+{
+    close();
+}
+
+void DataLogWriter::open(const std::string& fileName, std::size_t size, const std::vector<DataLogParam>& p)
+{
+    close();
+
+    params    = p;
+    maxValues = 1;
+    for (std::vector<DataLogParam>::const_iterator it = params.begin(); it != params.end(); ++it)
+        maxValues = std::max<std::size_t>(maxValues, it->numChannels);
+
+    headerSize = align8(logFixedHeader + params.size() * logParamSize);
+    recordSize = align8(logRecordHeader + maxValues * sizeof(uint32_t));
+    capacity   = ( size > headerSize ) ? ( size - headerSize ) / recordSize : 0;
+    length     = headerSize + capacity * recordSize;
+    written    = 0;
+
+    if (!capacity)
+        throw std::runtime_error("The size of the data log is too small");
+
+    fd = ::open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        throw std::runtime_error("Can not create '" + fileName + "': " + strerror(errno));
+
+    // The whole file is allocated now, so appending never fails for lack of space
+    int e = posix_fallocate(fd, 0, length);
+    if (e)
+    {
+        ::close(fd);
+        fd = -1;
+        throw std::runtime_error("Can not allocate '" + fileName + "': " + strerror(e));
+    }
+
+    void* m = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (m == MAP_FAILED)
+    {
+        e = errno;
+        ::close(fd);
+        fd = -1;
+        throw std::runtime_error("Can not map '" + fileName + "': " + strerror(e));
+    }
+
+    base = static_cast<char*>(m);
+
+    memcpy(base, logMagic, sizeof(logMagic));
+    put<uint32_t>(base + 4,  logVersion);
+    put<uint32_t>(base + 8,  headerSize);
+    put<uint32_t>(base + 12, recordSize);
+    put<uint32_t>(base + 16, capacity);
+    put<uint32_t>(base + 20, maxValues);
+    put<uint32_t>(base + 24, params.size());
+    put<uint32_t>(base + 28, 0);
+    put<uint64_t>(base + logWrittenOffset, 0);
+
+    char* entry = base + logFixedHeader;
+    for (std::vector<DataLogParam>::const_iterator it = params.begin(); it != params.end(); ++it, entry += logParamSize)
+    {
+        put<uint32_t>(entry,      it->slot);
+        put<uint32_t>(entry + 4,  it->type);
+        put<uint32_t>(entry + 8,  it->numChannels);
+        put<uint32_t>(entry + 12, 0);
+        memset(entry + 16, 0, logParamName);
+        strncpy(entry + 16, it->name.c_str(), logParamName - 1);
+    }
+}
+
+void DataLogWriter::append(uint32_t secPastEpoch, uint32_t nsec, uint32_t param, const void* values, std::size_t n)
+{
+    if ( ( !base ) || ( param >= params.size() ) )
+        return;
+
+    char*     r = base + headerSize + ( written % capacity ) * recordSize;
+    uint64_t* sequence = reinterpret_cast<uint64_t*>(r);
+
+    // The sequence number is cleared while the record is written, so a
+    // reader of a live file can tell it is incomplete
+    __atomic_store_n(sequence, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    n = std::min(n, maxValues);
+
+    put<uint32_t>(r + 8,  secPastEpoch);
+    put<uint32_t>(r + 12, nsec);
+    put<uint32_t>(r + 16, params.at(param).slot);
+    put<uint32_t>(r + 20, param);
+    put<uint32_t>(r + 24, n);
+    put<uint32_t>(r + 28, 0);
+    memcpy(r + logRecordHeader, values, n * sizeof(uint32_t));
+
+    __atomic_store_n(sequence, written + 1, __ATOMIC_RELEASE);
+
+    ++written;
+    __atomic_store_n(reinterpret_cast<uint64_t*>(base + logWrittenOffset), written, __ATOMIC_RELEASE);
+}
+
+void DataLogWriter::close()
+{
+    if (base)
+    {
+        msync(base, length, MS_ASYNC);
+        munmap(base, length);
+        base = NULL;
+    }
+
+    if (fd >= 0)
+    {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+DataLogReader::DataLogReader()
+:
+    fd(-1),
+    base(NULL),
+    length(0),
+    headerSize(0),
+    recordSize(0),
+    capacity(0),
+    written(0)
+{
+}
+
+DataLogReader::~DataLogReader()
+{
+    close();
+}
+
+bool DataLogReader::open(const std::string& fileName)
+{
+    close();
+
+    fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if ( ( fstat(fd, &st) ) || ( static_cast<std::size_t>(st.st_size) < logFixedHeader ) )
+    {
+        close();
+        return false;
+    }
+
+    length = st.st_size;
+
+    void* m = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+    if (m == MAP_FAILED)
+    {
+        base = NULL;
+        close();
+        return false;
+    }
+
+    base = static_cast<const char*>(m);
+
+    if ( ( memcmp(base, logMagic, sizeof(logMagic)) ) || ( get<uint32_t>(base + 4) != logVersion ) )
+    {
+        close();
+        return false;
+    }
+
+    headerSize = get<uint32_t>(base + 8);
+    recordSize = get<uint32_t>(base + 12);
+    capacity   = get<uint32_t>(base + 16);
+
+    std::size_t numParams = get<uint32_t>(base + 24);
+
+    if ( ( headerSize < logFixedHeader + numParams * logParamSize ) || ( recordSize < logRecordHeader ) ||
+         ( headerSize + capacity * recordSize > length ) )
+    {
+        close();
+        return false;
+    }
+
+    written = __atomic_load_n(reinterpret_cast<const uint64_t*>(base + logWrittenOffset), __ATOMIC_ACQUIRE);
+
+    const char* e = base + logFixedHeader;
+    for (std::size_t i(0); i < numParams; ++i, e += logParamSize)
+    {
+        DataLogParam p;
+        p.slot        = get<uint32_t>(e);
+        p.type        = get<uint32_t>(e + 4);
+        p.numChannels = get<uint32_t>(e + 8);
+        p.name        = std::string(e + 16, strnlen(e + 16, logParamName));
+        params.push_back(p);
+    }
+
+    return true;
+}
+
+void DataLogReader::close()
+{
+    if (base)
+    {
+        munmap(const_cast<char*>(base), length);
+        base = NULL;
+    }
+
+    if (fd >= 0)
+    {
+        ::close(fd);
+        fd = -1;
+    }
+
+    params.clear();
+    written = 0;
+}
+
+std::size_t DataLogReader::getNumRecords() const
+{
+    return std::min<uint64_t>(written, capacity);
+}
+
+bool DataLogReader::read(std::size_t i, DataLogRecord& r) const
+{
+    std::size_t n = getNumRecords();
+    if (i >= n)
+        return false;
+
+    uint64_t    s = written - n + i;
+    const char* p = base + headerSize + ( s % capacity ) * recordSize;
+    const uint64_t* sequence = reinterpret_cast<const uint64_t*>(p);
+
+    r.sequence = __atomic_load_n(sequence, __ATOMIC_ACQUIRE);
+    if (r.sequence != s + 1)
+        return false;
+
+    r.secPastEpoch = get<uint32_t>(p + 8);
+    r.nsec         = get<uint32_t>(p + 12);
+    r.slot         = get<uint32_t>(p + 16);
+    r.param        = get<uint32_t>(p + 20);
+
+    std::size_t count = std::min<std::size_t>(get<uint32_t>(p + 24), ( recordSize - logRecordHeader ) / sizeof(uint32_t));
+    r.values.resize(count);
+    memcpy(r.values.data(), p + logRecordHeader, count * sizeof(uint32_t));
+
+    // The record may have been overwritten while it was copied
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return ( __atomic_load_n(sequence, __ATOMIC_RELAXED) == s + 1 );
+}
@@ -0,0 +1,149 @@
+#ifndef DATA_LOG_H
+#define DATA_LOG_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : data_log.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Memory-mapped binary log of the acquired channel values
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <stdint.h>
+
+// A data log file is preallocated, and starts with a header:
+//   char[4]  magic ("CHVL")
+//   uint32   version
+//   uint32   header size, in bytes
+//   uint32   record size, in bytes
+//   uint32   number of records the file can hold
+//   uint32   maximum number of values in a record
+//   uint32   number of parameters
+//   uint32   reserved
+//   uint64   number of records written
+// followed by one entry per parameter:
+//   uint32   slot
+//   uint32   type (0: float, 1: 32-bit word)
+//   uint32   number of channels
+//   uint32   reserved
+//   char[24] parameter name, NUL terminated
+// The records start at the end of the header, and the n-th record written
+// is at position (n % number of records), so the oldest records are
+// overwritten when the file is full. Each record has a fixed size:
+//   uint64   sequence number (n + 1), written last
+//   uint32   acquisition time, seconds past the EPICS epoch
+//   uint32   acquisition time, nanoseconds
+//   uint32   slot
+//   uint32   parameter (its position in the parameter list)
+//   uint32   number of values
+//   uint32   reserved
+//   values, one per channel, as float or uint32 depending on the parameter
+// All the values are in the byte order of the host which wrote the file.
+
+// A parameter in the log: a channel parameter of a board
+struct DataLogParam
+{
+    enum Type { Float = 0, Word = 1 };
+
+    uint32_t    slot;
+    uint32_t    type;
+    uint32_t    numChannels;
+    std::string name;
+};
+
+// A record read back from a data log. The values are raw 32-bit words, to
+// be reinterpreted as floats for the Float parameters.
+struct DataLogRecord
+{
+    uint64_t              sequence;
+    uint32_t              secPastEpoch;
+    uint32_t              nsec;
+    uint32_t              slot;
+    uint32_t              param;
+    std::vector<uint32_t> values;
+};
+
+// Appends records to a data log. It is not thread safe: the records must be
+// appended from a single thread.
+class DataLogWriter
+{
+public:
+    DataLogWriter();
+    ~DataLogWriter();
+
+    // Creates the file, of about 'size' bytes, for these parameters, and maps
+    // it in memory. Throws a std::runtime_error on errors.
+    void open(const std::string& fileName, std::size_t size, const std::vector<DataLogParam>& params);
+
+    // Appends a record with the 'n' values of a parameter. Extra values are
+    // dropped.
+    void append(uint32_t secPastEpoch, uint32_t nsec, uint32_t param, const void* values, std::size_t n);
+
+    void close();
+
+    bool        isOpen()      const { return ( base != NULL ); };
+    uint64_t    getWritten()  const { return written;          };
+    std::size_t getCapacity() const { return capacity;         };
+
+private:
+    int                       fd;
+    char*                     base;
+    std::size_t               length;
+    std::size_t               headerSize;
+    std::size_t               recordSize;
+    std::size_t               capacity;
+    std::size_t               maxValues;
+    uint64_t                  written;
+    std::vector<DataLogParam> params;
+};
+
+class DataLogReader
+{
+public:
+    DataLogReader();
+    ~DataLogReader();
+
+    // Maps the file in memory and reads the header. Returns false on
+    // errors, or if the file is not a data log.
+    bool open(const std::string& fileName);
+    void close();
+
+    const std::vector<DataLogParam>& getParams() const { return params; };
+    uint64_t    getWritten()  const { return written;  };
+    std::size_t getCapacity() const { return capacity; };
+
+    // Number of records in the file
+    std::size_t getNumRecords() const;
+
+    // Reads the i-th record in the file, oldest first. Returns false if it
+    // is incomplete, or was overwritten since the file was opened.
+    bool read(std::size_t i, DataLogRecord& r) const;
+
+private:
+    int                       fd;
+    const char*               base;
+    std::size_t               length;
+    std::size_t               headerSize;
+    std::size_t               recordSize;
+    std::size_t               capacity;
+    uint64_t                  written;
+    std::vector<DataLogParam> params;
+};
+
+#endif
@@ -29,10 +29,38 @@ static void connMonC(void *drvPvt)
     pPvt->connMon();
 }
 
+// Acquisition task
+static void acqLoopC(void *drvPvt)
+{
+    CAENHVAsyn *pPvt = (CAENHVAsyn *)drvPvt;
+
+    pPvt->acqLoop();
+}
+
+// Driver statistics task
+static void statsLoopC(void *drvPvt)
+{
+    CAENHVAsyn *pPvt = (CAENHVAsyn *)drvPvt;
+
+    pPvt->statsLoop();
+}
+
 // Default value for the EPICS record prefix is an empty string,
 // which means that the autogeration is disabled.
 std::string CAENHVAsyn::epicsPrefix;
 std::string CAENHVAsyn::crateInfoFilePath = "/tmp/";
+// By default, the auto-generated input records take their timestamp from
+// the driver, which is the time the value was read from the crate.
+int CAENHVAsyn::timeStampEvent = -2;
+double CAENHVAsyn::defaultAcqPeriod = 1.0;
+double CAENHVAsyn::wrapperTimeout = 5.0;
+int CAENHVAsyn::historyDepth = 600;
+int CAENHVAsyn::tripSamples = 60;
+int CAENHVAsyn::tripPostSamples = 5;
+std::string CAENHVAsyn::tripDirectory;
+int CAENHVAsyn::statsWindow = 60;
+std::string CAENHVAsyn::dataLogDirectory;
+int CAENHVAsyn::dataLogSize = 256;
 
 template <typename T>
 void CAENHVAsyn::createParamFloat(T p, std::map<int, T>& list)
@@ -67,6 +95,7 @@ void CAENHVAsyn::createParamFloat(T p, std::map<int, T>& list)
         if ( (!mode.compare("RW")) || (!mode.compare("RO")) )
         {
             dbParamsLocal << ",SCAN=1 second";
+            dbParamsLocal << ",TSE=" << CAENHVAsyn::timeStampEvent;
             dbParamsLocal << ",R=" << recordName << ":Rd";
             dbLoadRecords("db/ai.template", dbParamsLocal.str().c_str());
         }
@@ -114,6 +143,7 @@ void CAENHVAsyn::createParamFloat(SystemPropertyFloat p, std::map<int, SystemPro
         if ( (!mode.compare("RW")) || (!mode.compare("RO")) )
         {
             dbParamsLocal << ",SCAN=1 second";
+            dbParamsLocal << ",TSE=" << CAENHVAsyn::timeStampEvent;
             dbParamsLocal << ",R=" << recordName << ":Rd";
             dbLoadRecords("db/ai.template", dbParamsLocal.str().c_str());
         }
@@ -161,6 +191,7 @@ void CAENHVAsyn::createParamBinary(T p, std::map<int, T>& list)
         if ( (!mode.compare("RW")) || (!mode.compare("RO")) )
         {
             dbParamsLocal << ",SCAN=1 second";
+            dbParamsLocal << ",TSE=" << CAENHVAsyn::timeStampEvent;
             dbParamsLocal << ",R=" << recordName << ":Rd";
             dbLoadRecords("db/bi.template", dbParamsLocal.str().c_str());
         }
@@ -205,6 +236,7 @@ void CAENHVAsyn::createParamMBinary(T p, std::map<int, T>& list, const statusRec
                 dbParamsLocal2.str("");
                 dbParamsLocal2 <<  dbParamsLocal.str();
                 dbParamsLocal2 << ",SCAN=1 second";
+                dbParamsLocal2 << ",TSE=" << CAENHVAsyn::timeStampEvent;
                 dbParamsLocal2 << ",MASK=" << it->first;
                 dbParamsLocal2 << ",DESC=" << it->second.second;
                 dbParamsLocal2 << ",R="    << recordName << it->second.first << ":Rd";
@@ -258,6 +290,7 @@ void CAENHVAsyn::createParamInteger(T p, std::map<int, T>& list)
         {
             dbParamsLocal << ",R=" << recordName << ":Rd";
             dbParamsLocal << ",SCAN=1 second";
+            dbParamsLocal << ",TSE=" << CAENHVAsyn::timeStampEvent;
             dbLoadRecords("db/longin.template", dbParamsLocal.str().c_str());
         }
 
@@ -298,6 +331,7 @@ void CAENHVAsyn::createParamString(T p, std::map<int, T>& list)
         {
             dbParamsLocal << ",R=" << recordName << ":Rd";
             dbParamsLocal << ",SCAN=1 second";
+            dbParamsLocal << ",TSE=" << CAENHVAsyn::timeStampEvent;
             dbLoadRecords("db/stringin.template", dbParamsLocal.str().c_str());
         }
 
@@ -317,14 +351,28 @@ CAENHVAsyn::CAENHVAsyn(const std::string& portName, int systemType, const std::s
         NUM_PARAMS,
         asynInt32Mask | asynDrvUserMask | asynInt16ArrayMask | asynInt32ArrayMask | asynOctetMask | \
         asynFloat64ArrayMask | asynUInt32DigitalMask | asynFloat64Mask,                             // Interface Mask
-        asynInt16ArrayMask | asynInt32ArrayMask | asynInt32Mask | asynUInt32DigitalMask,            // Interrupt Mask
+        asynInt16ArrayMask | asynInt32ArrayMask | asynInt32Mask | asynUInt32DigitalMask | \
+        asynFloat64ArrayMask | asynFloat64Mask | asynOctetMask,                                     // Interrupt Mask
         ASYN_MULTIDEVICE | ASYN_CANBLOCK,                                                           // asynFlags
         1,                                                                                          // Autoconnect
         0,                                                                                          // Default priority
         0),                                                                                         // Default stack size
     driverName_("CAENHVAsyn"),
-    portName_(portName)
+    portName_(portName),
+    scheduler(portName + "_sched"),
+    acqPeriod(defaultAcqPeriod),
+    acqWakeUp(epicsEventMustCreate(epicsEventEmpty)),
+    cacheHits(0),
+    cacheMisses(0),
+    missedDeadlines(0),
+    reconnects(0),
+    pollCycleTime(0),
+    lastReadTime(0),
+    numParams(0)
 {
+    for (int i = 0; i < NumIoMethods; ++i)
+        ioCount[i] = 0;
+
     // Check parameters
     if ( portName_.empty() )
         throw std::runtime_error("The port name must be defined");
@@ -446,6 +494,96 @@ CAENHVAsyn::CAENHVAsyn(const std::string& portName, int systemType, const std::s
             this->driverName_.c_str(), this->portName_.c_str(), (int)param_status);
     }
 
+    param_status = this->createAcquisitionParams();
+    if (param_status != asynSuccess) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
+            "Driver '%s', Port '%s': createAcquisitionParams failed. Status code %d\n", \
+            this->driverName_.c_str(), this->portName_.c_str(), (int)param_status);
+    }
+
+    this->createSnapshotMap();
+
+    param_status = this->createBoardArrayParams();
+    if (param_status != asynSuccess) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
+            "Driver '%s', Port '%s': createBoardArrayParams failed. Status code %d\n", \
+            this->driverName_.c_str(), this->portName_.c_str(), (int)param_status);
+    }
+
+    param_status = this->createSummaryParams();
+    if (param_status != asynSuccess) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
+            "Driver '%s', Port '%s': createSummaryParams failed. Status code %d\n", \
+            this->driverName_.c_str(), this->portName_.c_str(), (int)param_status);
+    }
+
+    param_status = this->createHistoryParams();
+    if (param_status != asynSuccess) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
+            "Driver '%s', Port '%s': createHistoryParams failed. Status code %d\n", \
+            this->driverName_.c_str(), this->portName_.c_str(), (int)param_status);
+    }
+
+    param_status = this->createTripParams();
+    if (param_status != asynSuccess) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
+            "Driver '%s', Port '%s': createTripParams failed. Status code %d\n", \
+            this->driverName_.c_str(), this->portName_.c_str(), (int)param_status);
+    }
+
+    param_status = this->createStatsParams();
+    if (param_status != asynSuccess) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
+            "Driver '%s', Port '%s': createStatsParams failed. Status code %d\n", \
+            this->driverName_.c_str(), this->portName_.c_str(), (int)param_status);
+    }
+
+    param_status = this->createSchedulerParams();
+    if (param_status != asynSuccess) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
+            "Driver '%s', Port '%s': createSchedulerParams failed. Status code %d\n", \
+            this->driverName_.c_str(), this->portName_.c_str(), (int)param_status);
+    }
+
+    param_status = this->createSetpointParams();
+    if (param_status != asynSuccess) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
+            "Driver '%s', Port '%s': createSetpointParams failed. Status code %d\n", \
+            this->driverName_.c_str(), this->portName_.c_str(), (int)param_status);
+    }
+
+    param_status = this->createChNameParams();
+    if (param_status != asynSuccess) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
+            "Driver '%s', Port '%s': createChNameParams failed. Status code %d\n", \
+            this->driverName_.c_str(), this->portName_.c_str(), (int)param_status);
+    }
+
+    param_status = this->createAllOffParams();
+    if (param_status != asynSuccess) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
+            "Driver '%s', Port '%s': createAllOffParams failed. Status code %d\n", \
+            this->driverName_.c_str(), this->portName_.c_str(), (int)param_status);
+    }
+
+    param_status = this->createWrapperStatsParams();
+    if (param_status != asynSuccess) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
+            "Driver '%s', Port '%s': createWrapperStatsParams failed. Status code %d\n", \
+            this->driverName_.c_str(), this->portName_.c_str(), (int)param_status);
+    }
+
+    param_status = this->createDriverStatsParams();
+    if (param_status != asynSuccess) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
+            "Driver '%s', Port '%s': createDriverStatsParams failed. Status code %d\n", \
+            this->driverName_.c_str(), this->portName_.c_str(), (int)param_status);
+    }
+
+    this->createParamStats();
+
+    this->createDataLog();
+
     // Create connection monitor thread
     bool status = (epicsThreadCreate("connMon",
             epicsThreadPriorityMedium,
@@ -458,6 +596,30 @@ CAENHVAsyn::CAENHVAsyn(const std::string& portName, int systemType, const std::s
         return;
     }
 
+    // Create acquisition thread
+    status = (epicsThreadCreate("acqLoop",
+            epicsThreadPriorityMedium,
+            epicsThreadGetStackSize(epicsThreadStackMedium),
+            (EPICSTHREADFUNC)acqLoopC,
+            this) == NULL);
+    if (status) {
+        printf("%s:%s epicsThreadCreate failure for acqLoop task\n",
+            this->driverName_.c_str(), this->driverName_.c_str());
+        return;
+    }
+
+    // Create driver statistics thread
+    status = (epicsThreadCreate("statsLoop",
+            epicsThreadPriorityLow,
+            epicsThreadGetStackSize(epicsThreadStackSmall),
+            (EPICSTHREADFUNC)statsLoopC,
+            this) == NULL);
+    if (status) {
+        printf("%s:%s epicsThreadCreate failure for statsLoop task\n",
+            this->driverName_.c_str(), this->driverName_.c_str());
+        return;
+    }
+
 }
 
 asynStatus CAENHVAsyn::createReconnParams() {
@@ -478,203 +640,2595 @@ asynStatus CAENHVAsyn::createReconnParams() {
 
 }
 
-/**
- * Resets connection if too many failed gets are detected.
- * Assumes the system is the same, so doesn't call GetPropList() or GetCrateMap()
- * ( See ICrate::ICrate() constructor )
- */
-void CAENHVAsyn::connMon() {
+asynStatus CAENHVAsyn::createAcquisitionParams() {
 
-    int fails, count_limit, allowed_fails, count = 0;
-    double monitor_thread_sleep, sleep_after_fail;
+    int status = (int)asynSuccess;
 
-    while (true) {
+    status = createParam("ACQ_DURATION", asynParamFloat64, &acq_duration_param);
+    status |= createParam("ACQ_PERIOD", asynParamFloat64, &acq_period_param);
 
-        getIntegerParam(fail_count_limit, &count_limit);
-        getIntegerParam(allowed_fails_param, &allowed_fails);
-        getDoubleParam(mon_thread_sleep_param, &monitor_thread_sleep);
-        getDoubleParam(conn_fail_sleep, &sleep_after_fail);
+    setDoubleParam(acq_duration_param, 0);
+    setDoubleParam(acq_period_param, acqPeriod.load());
 
-        // Avoid accumulating fails that have nothing to do with disconnection
-        if (count >= count_limit) {
-            epicsAtomicSetIntT(&this->failed_gets, 0);
-            count = 0;
-        }
+    // Cycle timing, for the crate and for each board. The last cycle time
+    // and the number of overruns are the DRV_POLL_* driver statistics.
+    status |= createParam("ACQ_CYCLE_MAX",     asynParamFloat64, &acq_cycle_max_param);
+    status |= createParam("ACQ_JITTER",        asynParamFloat64, &acq_jitter_param);
+    status |= createParam("ACQ_JITTER_MAX",    asynParamFloat64, &acq_jitter_max_param);
+    status |= createParam("ACQ_OVERRUN_SLOT",  asynParamInt32,   &acq_overrun_slot_param);
+    status |= createParam("ACQ_TIMING_RESET",  asynParamInt32,   &acq_timing_reset_param);
 
-        fails = epicsAtomicGetIntT(&this->failed_gets);
-        if (fails > allowed_fails) {
-            asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
-                "Driver '%s', Port '%s': reinitializing hardware connection\n", \
-                this->driverName_.c_str(), this->portName_.c_str());
-            this->lock();
-            bool error = true;
-            while (error) {
-                try {
-                    this->crate->ReinitSystem();
-                    error = false;
-                } catch (const std::runtime_error& err) {
-                    asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
-                        "Driver %s, Port %s: Failed to reinitialize hardware connection. Trying again in %f seconds.\n",
-                        this->driverName_.c_str(), this->portName_.c_str(), sleep_after_fail);
-                    epicsThreadSleep(sleep_after_fail);
-                }
-            }
-            epicsAtomicSetIntT(&this->failed_gets, 0);
-            this->unlock();
-            asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
-                "Driver '%s', Port '%s': finished reinitializing hardware connection\n", \
-                this->driverName_.c_str(), this->portName_.c_str());
+    std::vector<Board> b = crate->getBoards();
+    for (std::vector<Board>::iterator it = b.begin(); it != b.end(); ++it) {
+        std::size_t slot = (*it)->getSlot();
+
+        std::stringstream prefix;
+        prefix << "ACQ_S" << std::setfill('0') << std::setw(2) << slot;
+
+        AcqSlotTiming t = AcqSlotTiming();
+        status |= createParam((prefix.str() + "_TIME").c_str(),     asynParamFloat64, &t.time_param);
+        status |= createParam((prefix.str() + "_MAX").c_str(),      asynParamFloat64, &t.max_param);
+        status |= createParam((prefix.str() + "_OVERRUNS").c_str(), asynParamInt32,   &t.overruns_param);
+        acqSlotTiming.push_back(t);
+
+        if (!epicsPrefix.empty()) {
+            std::stringstream dbParamsLocal;
+            dbParamsLocal << "P="     << CAENHVAsyn::epicsPrefix;
+            dbParamsLocal << ",R=S"   << std::setfill('0') << std::setw(2) << slot << ":";
+            dbParamsLocal << ",SLOT=" << prefix.str();
+            dbParamsLocal << ",PORT=" << portName_;
+            dbLoadRecords("db/acqSlotTiming.template", dbParamsLocal.str().c_str());
         }
-
-        epicsThreadSleep(monitor_thread_sleep);
-        ++count;
-
     }
 
-}
-
-////////////////////////////////////////////
-// Methods overridden from asynPortDriver //
-////////////////////////////////////////////
-asynStatus CAENHVAsyn::readInt32(asynUser *pasynUser, epicsInt32 *value)
-{
-    static std::string method("readInt32");
-    int function(pasynUser->reason);
-    int status(0);
+    setDoubleParam(acq_jitter_param, 0);
+    setIntegerParam(acq_overrun_slot_param, -1);
+    resetAcqTiming();
 
-    int addr;
-    this->getAddress(pasynUser, &addr);
+    return (asynStatus)status;
 
-    const char *name;
-    getParamName(addr, function, &name);
+}
 
-    // Iterators
-    std::map< int, SystemPropertyInteger >::iterator spIt;
+/**
+ * Finds the location of each board and channel parameter in the board
+ * snapshots. Parameters not found here (e.g. write-only parameters) are
+ * always read directly from the crate.
+ */
+void CAENHVAsyn::createSnapshotMap() {
 
-    // Check if the function is found in out lists
-    bool found = false;
+    std::map<std::size_t, Board> boards;
+    std::vector<Board> b = crate->getBoards();
+    for (std::vector<Board>::iterator it = b.begin(); it != b.end(); ++it)
+        boards[(*it)->getSlot()] = *it;
+
+    for (std::map<int, ChannelParameterNumeric>::iterator it = channelParameterNumericList.begin(); it != channelParameterNumericList.end(); ++it) {
+        Board board = boards[it->second->getSlot()];
+        int i = board->getChFloatIndex(it->second->getParam());
+        if (i >= 0) {
+            SnapshotEntry e = { board, SnapshotEntry::ChFloat, (std::size_t)i, it->second->getChannel() };
+            snapshotParamList.insert( std::make_pair(it->first, e) );
+        }
+    }
 
-    // Look for the function number in the parameter lists
-    if (function == fail_count_limit || function == allowed_fails_param) {
-        found = true;
-        status = getIntegerParam(function, value);
-    } else {
-        try
-        {
-            if ( ( spIt = systemPropertyIntegerList.find(function) ) != systemPropertyIntegerList.end() )
-            {
-                *value = spIt->second->getVal();
-                found = true;
-            }
+    for (std::map<int, ChannelParameterOnOff>::iterator it = channelParameterOnOffList.begin(); it != channelParameterOnOffList.end(); ++it) {
+        Board board = boards[it->second->getSlot()];
+        int i = board->getChWordIndex(it->second->getParam());
+        if (i >= 0) {
+            SnapshotEntry e = { board, SnapshotEntry::ChWord, (std::size_t)i, it->second->getChannel() };
+            snapshotParamList.insert( std::make_pair(it->first, e) );
         }
-        catch(std::runtime_error& e)
-        {
-            status = -1;
-            epicsAtomicIncrIntT(&this->failed_gets);
-            asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                        "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
-                        this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, e.what());
+    }
+
+    for (std::map<int, ChannelParameterChStatus>::iterator it = channelParameterChStatusList.begin(); it != channelParameterChStatusList.end(); ++it) {
+        Board board = boards[it->second->getSlot()];
+        int i = board->getChWordIndex(it->second->getParam());
+        if (i >= 0) {
+            SnapshotEntry e = { board, SnapshotEntry::ChWord, (std::size_t)i, it->second->getChannel() };
+            snapshotParamList.insert( std::make_pair(it->first, e) );
         }
     }
 
-    // If the function was not found, fall back to the base method
-    if (!found)
-        status = asynPortDriver::readInt32(pasynUser, value);
+    for (std::map<int, BoardParameterNumeric>::iterator it = boardParameterNumericList.begin(); it != boardParameterNumericList.end(); ++it) {
+        Board board = boards[it->second->getSlot()];
+        int i = board->getBdFloatIndex(it->second->getParam());
+        if (i >= 0) {
+            SnapshotEntry e = { board, SnapshotEntry::BdFloat, (std::size_t)i, 0 };
+            snapshotParamList.insert( std::make_pair(it->first, e) );
+        }
+    }
 
-    // Log status and return
-    if (0 == status)
-    {
-        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : read '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, *value);
+    for (std::map<int, BoardParameterOnOff>::iterator it = boardParameterOnOffList.begin(); it != boardParameterOnOffList.end(); ++it) {
+        Board board = boards[it->second->getSlot()];
+        int i = board->getBdWordIndex(it->second->getParam());
+        if (i >= 0) {
+            SnapshotEntry e = { board, SnapshotEntry::BdWord, (std::size_t)i, 0 };
+            snapshotParamList.insert( std::make_pair(it->first, e) );
+        }
+    }
 
-        return asynSuccess;
+    for (std::map<int, BoardParameterChStatus>::iterator it = boardParameterChStatusList.begin(); it != boardParameterChStatusList.end(); ++it) {
+        Board board = boards[it->second->getSlot()];
+        int i = board->getBdWordIndex(it->second->getParam());
+        if (i >= 0) {
+            SnapshotEntry e = { board, SnapshotEntry::BdWord, (std::size_t)i, 0 };
+            snapshotParamList.insert( std::make_pair(it->first, e) );
+        }
     }
-    else
-    {
-        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while reading, status '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, status);
 
-        return asynError;
+    for (std::map<int, BoardParameterBdStatus>::iterator it = boardParameterBdStatusList.begin(); it != boardParameterBdStatusList.end(); ++it) {
+        Board board = boards[it->second->getSlot()];
+        int i = board->getBdWordIndex(it->second->getParam());
+        if (i >= 0) {
+            SnapshotEntry e = { board, SnapshotEntry::BdWord, (std::size_t)i, 0 };
+            snapshotParamList.insert( std::make_pair(it->first, e) );
+        }
     }
+
 }
 
-asynStatus CAENHVAsyn::writeInt32(asynUser *pasynUser, epicsInt32 value)
-{
-    static std::string method("writeInt32");
-    int function(pasynUser->reason);
-    int status(0);
+/**
+ * Creates, for each board and each numeric channel parameter in its snapshot
+ * (VMon, IMon, V0Set, ...), an array parameter with the values of all the
+ * channels of the board, and the same for the ChStatus channel parameters.
+ * Also creates an Int32 parameter with the raw word of each BdStatus board
+ * parameter. They are all published after each acquisition, from the same
+ * snapshot.
+ */
+asynStatus CAENHVAsyn::createBoardArrayParams() {
 
-    int addr;
-    this->getAddress(pasynUser, &addr);
+    int status = 0;
 
-    const char *name;
-    getParamName(addr, function, &name);
+    std::vector<Board> b = crate->getBoards();
+    for (std::vector<Board>::iterator it = b.begin(); it != b.end(); ++it) {
+        std::size_t slot = (*it)->getSlot();
 
-    // Iterators
-    std::map< int, SystemPropertyInteger >::iterator spIt;
+        for (std::size_t i = 0; i < (*it)->getNumChFloats(); ++i) {
+            std::string param = (*it)->getChFloatName(i);
 
-    // Check if the function is found in out lists
-    bool found = false;
+            std::stringstream paramName;
+            paramName << "S" << std::setfill('0') << std::setw(2) << slot << "_" << processParamName(param) << "_ARRAY";
 
-    // Look for the function number in the parameter lists
-    if (function == fail_count_limit || function == allowed_fails_param) {
-        found = true;
-        status = setIntegerParam(function, value);
-    } else {
-        try
-        {
-            if ( ( spIt = systemPropertyIntegerList.find(function) ) != systemPropertyIntegerList.end() )
-            {
-                spIt->second->setVal(value);
-                found = true;
+            int index;
+            status |= createParam(paramName.str().c_str(), asynParamFloat64Array, &index);
+
+            BoardArrayEntry e = { *it, i };
+            boardFloatArrayList.insert( std::make_pair(index, e) );
+
+            if (!epicsPrefix.empty()) {
+                // Units of the parameter, from any of the channels which have it
+                std::string units;
+                for (std::map<int, ChannelParameterNumeric>::iterator pIt = channelParameterNumericList.begin(); pIt != channelParameterNumericList.end(); ++pIt) {
+                    if ( ( pIt->second->getSlot() == slot ) && ( !pIt->second->getParam().compare(param) ) ) {
+                        units = pIt->second->getUnits();
+                        break;
+                    }
+                }
+
+                std::stringstream dbParamsLocal;
+                dbParamsLocal << "P="     << CAENHVAsyn::epicsPrefix;
+                dbParamsLocal << ",R=S"   << std::setfill('0') << std::setw(2) << slot << ":" << processParamName(param) << ":Array";
+                dbParamsLocal << ",PORT=" << portName_;
+                dbParamsLocal << ",PARAM=" << paramName.str();
+                dbParamsLocal << ",DESC='Slot " << slot << ", " << param << ", all channels'";
+                dbParamsLocal << ",DTYP=asynFloat64ArrayIn";
+                dbParamsLocal << ",FTVL=DOUBLE";
+                dbParamsLocal << ",NELM=" << (*it)->getNumChannels();
+                dbParamsLocal << ",EGU="  << units;
+                dbParamsLocal << ",TSE="  << CAENHVAsyn::timeStampEvent;
+                dbLoadRecords("db/boardArray.template", dbParamsLocal.str().c_str());
             }
         }
-        catch(std::runtime_error& e)
-        {
-            status = -1;
-            epicsAtomicIncrIntT(&this->failed_gets);
-            asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                        "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
-                        this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, e.what());
-        }
-    }
 
-    // If the function was not found, fall back to the base method
-    if (!found)
-        status = asynPortDriver::writeInt32(pasynUser, value);
+        // Status words of all the channels, for the ChStatus channel parameters
+        for (std::size_t i = 0; i < (*it)->getNumChWords(); ++i) {
+            std::string param = (*it)->getChWordName(i);
 
-    // Log status and return
-    if (0 == status)
-    {
-        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : set to '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, value);
+            bool isStatus = false;
+            for (std::map<int, ChannelParameterChStatus>::iterator pIt = channelParameterChStatusList.begin(); pIt != channelParameterChStatusList.end(); ++pIt) {
+                if ( ( pIt->second->getSlot() == slot ) && ( !pIt->second->getParam().compare(param) ) ) {
+                    isStatus = true;
+                    break;
+                }
+            }
 
-        return asynSuccess;
-    }
-    else
-    {
-        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while writting '%d', status '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, value, status);
+            if (!isStatus)
+                continue;
+
+            std::stringstream paramName;
+            paramName << "S" << std::setfill('0') << std::setw(2) << slot << "_" << processParamName(param) << "_ARRAY";
+
+            int index;
+            status |= createParam(paramName.str().c_str(), asynParamInt32Array, &index);
+
+            BoardArrayEntry e = { *it, i };
+            boardStatusArrayList.insert( std::make_pair(index, e) );
+
+            if (!epicsPrefix.empty()) {
+                std::stringstream dbParamsLocal;
+                dbParamsLocal << "P="     << CAENHVAsyn::epicsPrefix;
+                dbParamsLocal << ",R=S"   << std::setfill('0') << std::setw(2) << slot << ":" << processParamName(param) << ":Array";
+                dbParamsLocal << ",PORT=" << portName_;
+                dbParamsLocal << ",PARAM=" << paramName.str();
+                dbParamsLocal << ",DESC='Slot " << slot << ", " << param << ", all channels'";
+                dbParamsLocal << ",DTYP=asynInt32ArrayIn";
+                dbParamsLocal << ",FTVL=LONG";
+                dbParamsLocal << ",NELM=" << (*it)->getNumChannels();
+                dbParamsLocal << ",TSE="  << CAENHVAsyn::timeStampEvent;
+                dbLoadRecords("db/boardArray.template", dbParamsLocal.str().c_str());
+            }
+        }
 
-        return asynError;
+        // Raw status words of the board, for the BdStatus board parameters
+        for (std::map<int, BoardParameterBdStatus>::iterator pIt = boardParameterBdStatusList.begin(); pIt != boardParameterBdStatusList.end(); ++pIt) {
+            if (pIt->second->getSlot() != slot)
+                continue;
+
+            std::string param = pIt->second->getParam();
+            int i = (*it)->getBdWordIndex(param);
+            if (i < 0)
+                continue;
+
+            std::stringstream paramName;
+            paramName << "S" << std::setfill('0') << std::setw(2) << slot << "_" << processParamName(param) << "_WORD";
+
+            int index;
+            status |= createParam(paramName.str().c_str(), asynParamInt32, &index);
+
+            BoardArrayEntry e = { *it, (std::size_t)i };
+            boardStatusWordList.insert( std::make_pair(index, e) );
+
+            if (!epicsPrefix.empty()) {
+                std::stringstream dbParamsLocal;
+                dbParamsLocal << "P="     << CAENHVAsyn::epicsPrefix;
+                dbParamsLocal << ",R=S"   << std::setfill('0') << std::setw(2) << slot << ":" << processParamName(param) << ":Word";
+                dbParamsLocal << ",PORT=" << portName_;
+                dbParamsLocal << ",PARAM=" << paramName.str();
+                dbParamsLocal << ",DESC='Slot " << slot << ", " << param << " word'";
+                dbParamsLocal << ",TSE="  << CAENHVAsyn::timeStampEvent;
+                dbLoadRecords("db/boardWord.template", dbParamsLocal.str().c_str());
+            }
+        }
     }
-}
 
-asynStatus CAENHVAsyn::readFloat64(asynUser *pasynUser, epicsFloat64 *value)
-{
-    static std::string method("readFloat64");
-    int function(pasynUser->reason);
-    int status(0);
+    return (asynStatus)status;
 
-    int addr;
-    this->getAddress(pasynUser, &addr);
+}
 
-    const char *name;
-    getParamName(addr, function, &name);
+/**
+ * Publishes the arrays of a board from its latest snapshot, with the time
+ * of the acquisition. Nothing is published if the acquisition failed.
+ */
+void CAENHVAsyn::publishBoardArrays(const Board& board, const BoardSnapshotData& d) {
+
+    if (!d.valid)
+        return;
+
+    std::vector<epicsFloat64> values(d.numChannels);
+    std::vector<epicsInt32>   words(d.numChannels);
+
+    this->lock();
+
+    setTimeStamp(&d.stamp);
+
+    for (std::map<int, BoardArrayEntry>::const_iterator it = boardFloatArrayList.begin(); it != boardFloatArrayList.end(); ++it) {
+        if (it->second.board != board)
+            continue;
+
+        std::vector<float>::const_iterator first = d.chFloats.begin() + it->second.index * d.numChannels;
+        std::copy(first, first + d.numChannels, values.begin());
+        doCallbacksFloat64Array(values.data(), values.size(), it->first, 0);
+    }
+
+    for (std::map<int, BoardArrayEntry>::const_iterator it = boardStatusArrayList.begin(); it != boardStatusArrayList.end(); ++it) {
+        if (it->second.board != board)
+            continue;
+
+        std::vector<uint32_t>::const_iterator first = d.chWords.begin() + it->second.index * d.numChannels;
+        std::copy(first, first + d.numChannels, words.begin());
+        doCallbacksInt32Array(words.data(), words.size(), it->first, 0);
+    }
+
+    for (std::map<int, BoardArrayEntry>::const_iterator it = boardStatusWordList.begin(); it != boardStatusWordList.end(); ++it) {
+        if (it->second.board == board)
+            setIntegerParam(it->first, d.bdWords.at(it->second.index));
+    }
+
+    callParamCallbacks();
+
+    this->unlock();
+
+}
+
+/**
+ * Creates the crate summary parameters, and the summed current and power of
+ * each board.
+ */
+asynStatus CAENHVAsyn::createSummaryParams() {
+
+    int status = 0;
+
+    status |= createParam("SUM_POWER",         asynParamFloat64, &sum_power_param);
+    status |= createParam("SUM_CH_ON",         asynParamInt32,   &sum_on_param);
+    status |= createParam("SUM_CH_RAMPING",    asynParamInt32,   &sum_ramping_param);
+    status |= createParam("SUM_CH_TRIPPED",    asynParamInt32,   &sum_tripped_param);
+    status |= createParam("SUM_MAX_TEMP",      asynParamFloat64, &sum_max_temp_param);
+    status |= createParam("SUM_MAX_TEMP_SLOT", asynParamInt32,   &sum_max_temp_slot_param);
+
+    sumPower   = 0;
+    sumOn      = 0;
+    sumRamping = 0;
+    sumTripped = 0;
+
+    setDoubleParam(sum_power_param,          0);
+    setIntegerParam(sum_on_param,            0);
+    setIntegerParam(sum_ramping_param,       0);
+    setIntegerParam(sum_tripped_param,       0);
+    setDoubleParam(sum_max_temp_param,       0);
+    setIntegerParam(sum_max_temp_slot_param, -1);
+
+    std::vector<Board> b = crate->getBoards();
+    for (std::vector<Board>::iterator it = b.begin(); it != b.end(); ++it) {
+        std::size_t slot = (*it)->getSlot();
+
+        std::stringstream prefix;
+        prefix << "S" << std::setfill('0') << std::setw(2) << slot << "_SUM";
+
+        BoardSummary s = BoardSummary();
+        s.slot         = slot;
+        s.vmonIndex    = (*it)->getChFloatIndex("VMon");
+        s.imonIndex    = (*it)->getChFloatIndex("IMon");
+        s.statusIndex  = (*it)->getChWordIndex("Status");
+        s.tempIndex    = (*it)->getBdFloatIndex("Temp");
+        s.currentScale = 1e-6;
+
+        // The IMon units depend on the board model
+        std::string units = (*it)->getIMonUnits();
+
+        if (units == "A")
+            s.currentScale = 1;
+        else if (units == "mA")
+            s.currentScale = 1e-3;
+        else if (units == "nA")
+            s.currentScale = 1e-9;
+
+        status |= createParam((prefix.str() + "_IMON").c_str(),  asynParamFloat64, &s.current_param);
+        status |= createParam((prefix.str() + "_POWER").c_str(), asynParamFloat64, &s.power_param);
+
+        setDoubleParam(s.current_param, 0);
+        setDoubleParam(s.power_param,   0);
+
+        summaryList.push_back(s);
+
+        if (!epicsPrefix.empty()) {
+            std::stringstream dbParamsLocal;
+            dbParamsLocal << "P="     << CAENHVAsyn::epicsPrefix;
+            dbParamsLocal << ",R=S"   << std::setfill('0') << std::setw(2) << slot << ":";
+            dbParamsLocal << ",SUM="  << prefix.str();
+            dbParamsLocal << ",IEGU=" << units;
+            dbParamsLocal << ",PORT=" << portName_;
+            dbLoadRecords("db/boardSummary.template", dbParamsLocal.str().c_str());
+        }
+    }
+
+    return (asynStatus)status;
+
+}
+
+/**
+ * Updates the crate summary with a valid acquisition of the i-th board, and
+ * publishes it with the time of that acquisition. Only the channels of that
+ * board are scanned: their previous contributions are subtracted from the
+ * crate totals and the new ones added. A board whose acquisition failed
+ * keeps its last contributions. The worst temperature is taken over the
+ * last values of all the boards, as a maximum can not be updated by
+ * subtraction. Called by the acquisition thread.
+ */
+void CAENHVAsyn::updateSummary(std::size_t i, const BoardSnapshotData& d) {
+
+    if ( ( i >= summaryList.size() ) || ( !d.valid ) )
+        return;
+
+    BoardSummary& s = summaryList.at(i);
+    std::size_t n = d.numChannels;
+
+    double     power(0), current(0);
+    epicsInt32 on(0), ramping(0), tripped(0);
+
+    if (s.imonIndex >= 0) {
+        const float *iMon = &d.chFloats[s.imonIndex * n];
+        for (std::size_t c(0); c < n; ++c)
+            current += iMon[c];
+
+        if (s.vmonIndex >= 0) {
+            const float *vMon = &d.chFloats[s.vmonIndex * n];
+            for (std::size_t c(0); c < n; ++c)
+                power += static_cast<double>(vMon[c]) * iMon[c];
+            power *= s.currentScale;
+        }
+    }
+
+    if (s.statusIndex >= 0) {
+        const uint32_t *status = &d.chWords[s.statusIndex * n];
+        for (std::size_t c(0); c < n; ++c) {
+            on      += ( status[c] & chStatusOnMask )   ? 1 : 0;
+            ramping += ( status[c] & chStatusRampMask ) ? 1 : 0;
+            tripped += ( status[c] & chStatusTripMask ) ? 1 : 0;
+        }
+    }
+
+    if (s.valid) {
+        sumPower   -= s.power;
+        sumOn      -= s.on;
+        sumRamping -= s.ramping;
+        sumTripped -= s.tripped;
+    }
+
+    sumPower   += power;
+    sumOn      += on;
+    sumRamping += ramping;
+    sumTripped += tripped;
+
+    s.power   = power;
+    s.current = current;
+    s.on      = on;
+    s.ramping = ramping;
+    s.tripped = tripped;
+    s.temp    = ( s.tempIndex >= 0 ) ? d.bdFloats.at(s.tempIndex) : 0;
+    s.valid   = true;
+
+    // Worst board temperature
+    int    maxSlot(-1);
+    double maxTemp(0);
+    for (std::vector<BoardSummary>::const_iterator it = summaryList.begin(); it != summaryList.end(); ++it) {
+        if ( it->valid && ( it->tempIndex >= 0 ) && ( ( maxSlot < 0 ) || ( it->temp > maxTemp ) ) ) {
+            maxTemp = it->temp;
+            maxSlot = it->slot;
+        }
+    }
+
+    this->lock();
+
+    setTimeStamp(&d.stamp);
+    setDoubleParam(s.current_param,          current);
+    setDoubleParam(s.power_param,            power);
+    setDoubleParam(sum_power_param,          sumPower);
+    setIntegerParam(sum_on_param,            sumOn);
+    setIntegerParam(sum_ramping_param,       sumRamping);
+    setIntegerParam(sum_tripped_param,       sumTripped);
+    setDoubleParam(sum_max_temp_param,       maxTemp);
+    setIntegerParam(sum_max_temp_slot_param, maxSlot);
+    callParamCallbacks();
+
+    this->unlock();
+
+}
+
+/**
+ * Creates the data log file, '<dataLogDirectory>/<port>.chvlog', with all
+ * the channel parameters of the boards. Each acquisition of a board adds one
+ * record per parameter.
+ */
+void CAENHVAsyn::createDataLog() {
+
+    if ( dataLogDirectory.empty() || ( dataLogSize <= 0 ) )
+        return;
+
+    std::vector<DataLogParam> params;
+
+    std::vector<Board> b = crate->getBoards();
+    for (std::vector<Board>::iterator it = b.begin(); it != b.end(); ++it) {
+        dataLogFirstParam.push_back(params.size());
+
+        DataLogParam p;
+        p.slot        = (*it)->getSlot();
+        p.numChannels = (*it)->getNumChannels();
+
+        p.type = DataLogParam::Float;
+        for (std::size_t i(0); i < (*it)->getNumChFloats(); ++i) {
+            p.name = (*it)->getChFloatName(i);
+            params.push_back(p);
+        }
+
+        p.type = DataLogParam::Word;
+        for (std::size_t i(0); i < (*it)->getNumChWords(); ++i) {
+            p.name = (*it)->getChWordName(i);
+            params.push_back(p);
+        }
+    }
+
+    std::string fileName = dataLogDirectory + "/" + portName_ + ".chvlog";
+
+    try {
+        dataLog.open(fileName, static_cast<std::size_t>(dataLogSize) << 20, params);
+    } catch (const std::runtime_error& e) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+            "Driver '%s', Port '%s': the data log is disabled: '%s'\n", \
+            this->driverName_.c_str(), this->portName_.c_str(), e.what());
+    }
+
+}
+
+/**
+ * Adds a valid acquisition of the i-th board to the data log, one record per
+ * channel parameter. Called by the acquisition thread.
+ */
+void CAENHVAsyn::logAcquisition(std::size_t i, const BoardSnapshotData& d) {
+
+    if ( ( !dataLog.isOpen() ) || ( !d.valid ) || ( i >= dataLogFirstParam.size() ) )
+        return;
+
+    std::size_t n      = d.numChannels;
+    std::size_t id     = dataLogFirstParam.at(i);
+    std::size_t floats = n ? d.chFloats.size() / n : 0;
+    std::size_t words  = n ? d.chWords.size()  / n : 0;
+
+    for (std::size_t k(0); k < floats; ++k)
+        dataLog.append(d.stamp.secPastEpoch, d.stamp.nsec, id++, &d.chFloats[k * n], n);
+
+    for (std::size_t k(0); k < words; ++k)
+        dataLog.append(d.stamp.secPastEpoch, d.stamp.nsec, id++, &d.chWords[k * n], n);
+
+}
+
+/**
+ * Creates the history of each board, with the VMon, IMon and Status values
+ * of all its channels for the last 'historyDepth' acquisitions, and the
+ * parameters to read it, one channel at a time.
+ */
+asynStatus CAENHVAsyn::createHistoryParams() {
+
+    int status = 0;
+
+    if (historyDepth <= 0)
+        return asynSuccess;
+
+    std::vector<Board> b = crate->getBoards();
+    for (std::vector<Board>::iterator it = b.begin(); it != b.end(); ++it) {
+        std::size_t slot = (*it)->getSlot();
+
+        std::stringstream prefix;
+        prefix << "S" << std::setfill('0') << std::setw(2) << slot << "_HIST";
+
+        HistoryEntry h;
+        h.history = BoardHistory::create(historyDepth, (*it)->getNumChannels(),
+            (*it)->getChFloatIndex("VMon"), (*it)->getChFloatIndex("IMon"), (*it)->getChWordIndex("Status"));
+
+        status |= createParam((prefix.str() + "_CHANNEL").c_str(), asynParamInt32,        &h.channel_param);
+        status |= createParam((prefix.str() + "_VMON").c_str(),    asynParamFloat64Array, &h.vmon_param);
+        status |= createParam((prefix.str() + "_IMON").c_str(),    asynParamFloat64Array, &h.imon_param);
+        status |= createParam((prefix.str() + "_STATUS").c_str(),  asynParamInt32Array,   &h.status_param);
+        status |= createParam((prefix.str() + "_TIME").c_str(),    asynParamFloat64Array, &h.time_param);
+
+        h.trace.last.secPastEpoch = 0;
+        h.trace.last.nsec         = 0;
+        setIntegerParam(h.channel_param, 0);
+
+        historyList.push_back(h);
+
+        if (!epicsPrefix.empty()) {
+            std::stringstream dbParamsLocal;
+            dbParamsLocal << "P="     << CAENHVAsyn::epicsPrefix;
+            dbParamsLocal << ",R=S"   << std::setfill('0') << std::setw(2) << slot << ":";
+            dbParamsLocal << ",HIST=" << prefix.str();
+            dbParamsLocal << ",NELM=" << historyDepth;
+            dbParamsLocal << ",IEGU=" << (*it)->getIMonUnits();
+            dbParamsLocal << ",PORT=" << portName_;
+            dbLoadRecords("db/history.template", dbParamsLocal.str().c_str());
+        }
+    }
+
+    return (asynStatus)status;
+
+}
+
+/**
+ * If 'function' is the history channel parameter of a board, reads the
+ * history of that channel and publishes it, with the time of its newest
+ * sample. The arrays are read together, so they are always consistent.
+ *
+ * @return false if 'function' is not a history channel parameter.
+ */
+bool CAENHVAsyn::selectHistoryChannel(int function, epicsInt32 channel) {
+
+    for (std::vector<HistoryEntry>::iterator it = historyList.begin(); it != historyList.end(); ++it) {
+        if (it->channel_param != function)
+            continue;
+
+        // An invalid channel gives empty arrays
+        it->history->read(static_cast<std::size_t>(channel), it->trace);
+
+        setIntegerParam(function, channel);
+        setTimeStamp(&it->trace.last);
+        doCallbacksFloat64Array(it->trace.vMon.data(),   it->trace.vMon.size(),   it->vmon_param,   0);
+        doCallbacksFloat64Array(it->trace.iMon.data(),   it->trace.iMon.size(),   it->imon_param,   0);
+        doCallbacksInt32Array  (it->trace.status.data(), it->trace.status.size(), it->status_param, 0);
+        doCallbacksFloat64Array(it->trace.time.data(),   it->trace.time.size(),   it->time_param,   0);
+
+        return true;
+    }
+
+    return false;
+
+}
+
+const CAENHVAsyn::HistoryEntry* CAENHVAsyn::findHistory(int function) const {
+
+    for (std::vector<HistoryEntry>::const_iterator it = historyList.begin(); it != historyList.end(); ++it)
+        if ( ( function == it->vmon_param ) || ( function == it->imon_param ) || ( function == it->status_param ) || ( function == it->time_param ) )
+            return &(*it);
+
+    return NULL;
+
+}
+
+/**
+ * Creates the trip snapshot parameters of each board. The trip snapshots
+ * are taken from the history, so they are disabled with it.
+ */
+asynStatus CAENHVAsyn::createTripParams() {
+
+    int status = 0;
+
+    if ( historyList.empty() || ( tripSamples <= 0 ) )
+        return asynSuccess;
+
+    std::size_t samples = std::min(tripSamples, historyDepth);
+
+    std::vector<Board> b = crate->getBoards();
+    for (std::vector<Board>::iterator it = b.begin(); it != b.end(); ++it) {
+        std::size_t slot = (*it)->getSlot();
+
+        std::stringstream prefix;
+        prefix << "S" << std::setfill('0') << std::setw(2) << slot << "_TRIP";
+
+        TripEntry t;
+        t.statusIndex   = (*it)->getChWordIndex("Status");
+        t.bdStatusIndex = (*it)->getBdWordIndex("BdStatus");
+        t.tempIndex     = (*it)->getBdFloatIndex("Temp");
+        t.primed        = false;
+        t.armed         = true;
+        t.pending       = -1;
+        t.count         = 0;
+        t.next.slot     = slot;
+
+        status |= createParam((prefix.str() + "_VMON").c_str(),     asynParamFloat64Array, &t.vmon_param);
+        status |= createParam((prefix.str() + "_IMON").c_str(),     asynParamFloat64Array, &t.imon_param);
+        status |= createParam((prefix.str() + "_STATUS").c_str(),   asynParamInt32Array,   &t.status_param);
+        status |= createParam((prefix.str() + "_TIME").c_str(),     asynParamFloat64Array, &t.time_param);
+        status |= createParam((prefix.str() + "_CHANNEL").c_str(),  asynParamInt32,        &t.channel_param);
+        status |= createParam((prefix.str() + "_BITS").c_str(),     asynParamInt32,        &t.bits_param);
+        status |= createParam((prefix.str() + "_BDSTATUS").c_str(), asynParamInt32,        &t.bdstatus_param);
+        status |= createParam((prefix.str() + "_TEMP").c_str(),     asynParamFloat64,      &t.temp_param);
+        status |= createParam((prefix.str() + "_COUNT").c_str(),    asynParamInt32,        &t.count_param);
+        status |= createParam((prefix.str() + "_ARM").c_str(),      asynParamInt32,        &t.arm_param);
+
+        setIntegerParam(t.channel_param,  -1);
+        setIntegerParam(t.bits_param,     0);
+        setIntegerParam(t.bdstatus_param, 0);
+        setDoubleParam(t.temp_param,      0);
+        setIntegerParam(t.count_param,    0);
+        setIntegerParam(t.arm_param,      1);
+
+        tripList.push_back(t);
+
+        if (!epicsPrefix.empty()) {
+            std::stringstream dbParamsLocal;
+            dbParamsLocal << "P="     << CAENHVAsyn::epicsPrefix;
+            dbParamsLocal << ",R=S"   << std::setfill('0') << std::setw(2) << slot << ":";
+            dbParamsLocal << ",TRIP=" << prefix.str();
+            dbParamsLocal << ",NSAM=" << samples;
+            dbParamsLocal << ",NELM=" << samples * (*it)->getNumChannels();
+            dbParamsLocal << ",IEGU=" << (*it)->getIMonUnits();
+            dbParamsLocal << ",PORT=" << portName_;
+            dbLoadRecords("db/trip.template", dbParamsLocal.str().c_str());
+        }
+    }
+
+    return (asynStatus)status;
+
+}
+
+/**
+ * Looks for trip bits rising on any channel of the i-th board, and freezes
+ * its trip snapshot when it is due. Called by the acquisition thread, after
+ * the acquisition was added to the history. The status of the channels at
+ * the first valid acquisition is taken as the reference, so channels which
+ * were already tripped when the IOC started are not reported.
+ */
+void CAENHVAsyn::checkTrips(std::size_t i, const BoardSnapshotData& d) {
+
+    if ( ( i >= tripList.size() ) || ( !d.valid ) )
+        return;
+
+    TripEntry& t = tripList.at(i);
+
+    if (t.statusIndex < 0)
+        return;
+
+    std::vector<uint32_t>::const_iterator status = d.chWords.begin() + t.statusIndex * d.numChannels;
+
+    if (!t.primed) {
+        t.lastStatus.assign(status, status + d.numChannels);
+        t.primed = true;
+        return;
+    }
+
+    // First channel with a trip bit rising in this acquisition
+    int channel = -1;
+    uint32_t bits = 0;
+    for (std::size_t c = 0; c < d.numChannels; ++c) {
+        uint32_t rising = status[c] & ~t.lastStatus[c] & chStatusTripMask;
+        if ( rising && ( channel < 0 ) ) {
+            channel = c;
+            bits    = rising;
+        }
+    }
+
+    t.lastStatus.assign(status, status + d.numChannels);
+
+    if ( ( channel < 0 ) && ( t.pending < 0 ) )
+        return;
+
+    this->lock();
+
+    if (channel >= 0) {
+        setIntegerParam(t.count_param, ++t.count);
+
+        asynPrint(pasynUserSelf, ASYN_TRACE_WARNING, \
+            "Driver '%s', Port '%s': trip on slot %zu, channel %d, status bits 0x%04x\n", \
+            this->driverName_.c_str(), this->portName_.c_str(), t.next.slot, channel, bits);
+
+        if ( t.armed && ( t.pending < 0 ) ) {
+            t.next.channel  = channel;
+            t.next.bits     = bits;
+            t.next.trigger  = d.stamp;
+            t.next.bdStatus = ( t.bdStatusIndex >= 0 ) ? d.bdWords.at(t.bdStatusIndex) : 0;
+            t.next.temp     = ( t.tempIndex >= 0 ) ? d.bdFloats.at(t.tempIndex) : 0;
+            t.pending       = tripPostSamples;
+        }
+    }
+
+    bool frozen = false;
+    if (t.pending == 0) {
+        freezeTrip(t);
+        t.pending = -1;
+        frozen    = true;
+    } else if (t.pending > 0) {
+        --t.pending;
+    }
+
+    callParamCallbacks();
+
+    this->unlock();
+
+    // The file is written without holding the port lock
+    if ( frozen && ( !tripDirectory.empty() ) ) {
+        char stamp[32];
+        epicsTimeToStrftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &t.snapshot.trigger);
+
+        std::stringstream fileName;
+        fileName << tripDirectory << "/" << portName_ << "_S" << std::setfill('0') << std::setw(2) << t.snapshot.slot << "_" << stamp << ".trip";
+
+        try {
+            t.snapshot.write(fileName.str());
+        } catch (const std::runtime_error& e) {
+            asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                "Driver '%s', Port '%s': failed to write the trip snapshot: '%s'\n", \
+                this->driverName_.c_str(), this->portName_.c_str(), e.what());
+        }
+    }
+
+}
+
+/**
+ * Freezes the history of a board in its trip snapshot, publishes it, and
+ * disarms the capture. Must be called with the port locked.
+ */
+void CAENHVAsyn::freezeTrip(TripEntry& t) {
+
+    const HistoryEntry& h = historyList.at(&t - &tripList.front());
+
+    t.next.numChannels = h.history->getNumChannels();
+    t.next.numSamples  = h.history->readAll(std::min(tripSamples, historyDepth), t.next.block);
+
+    t.next.time.resize(t.next.numSamples);
+    for (std::size_t s = 0; s < t.next.numSamples; ++s)
+        t.next.time[s] = epicsTimeDiffInSeconds(&t.next.block.stamps[s], &t.next.trigger);
+
+    std::swap(t.snapshot, t.next);
+    t.next.slot = t.snapshot.slot;
+    t.armed     = false;
+
+    setTimeStamp(&t.snapshot.trigger);
+    setIntegerParam(t.channel_param,  t.snapshot.channel);
+    setIntegerParam(t.bits_param,     t.snapshot.bits);
+    setIntegerParam(t.bdstatus_param, t.snapshot.bdStatus);
+    setDoubleParam(t.temp_param,      t.snapshot.temp);
+    setIntegerParam(t.arm_param,      0);
+
+    doCallbacksFloat64Array(t.snapshot.block.vMon.data(),   t.snapshot.block.vMon.size(),   t.vmon_param,   0);
+    doCallbacksFloat64Array(t.snapshot.block.iMon.data(),   t.snapshot.block.iMon.size(),   t.imon_param,   0);
+    doCallbacksInt32Array  (t.snapshot.block.status.data(), t.snapshot.block.status.size(), t.status_param, 0);
+    doCallbacksFloat64Array(t.snapshot.time.data(),         t.snapshot.time.size(),         t.time_param,   0);
+
+}
+
+/**
+ * If 'function' is the trip arm parameter of a board, arms (non-zero) or
+ * disarms (zero) its trip capture. A capture already in progress is not
+ * affected.
+ *
+ * @return false if 'function' is not a trip arm parameter.
+ */
+bool CAENHVAsyn::armTripCapture(int function, epicsInt32 value) {
+
+    for (std::vector<TripEntry>::iterator it = tripList.begin(); it != tripList.end(); ++it) {
+        if (it->arm_param != function)
+            continue;
+
+        it->armed = ( value != 0 );
+        setIntegerParam(function, it->armed);
+        callParamCallbacks();
+
+        return true;
+    }
+
+    return false;
+
+}
+
+/**
+ * Creates the parameters with the windowed statistics of VMon and IMon of
+ * each board. The statistics are computed from the history, so they are
+ * disabled with it.
+ */
+asynStatus CAENHVAsyn::createStatsParams() {
+
+    int status = 0;
+
+    if ( historyList.empty() || ( statsWindow <= 0 ) )
+        return asynSuccess;
+
+    std::vector<Board> b = crate->getBoards();
+    for (std::vector<Board>::iterator it = b.begin(); it != b.end(); ++it) {
+        std::size_t slot = (*it)->getSlot();
+
+        StatsEntry e;
+        e.stamp.secPastEpoch = 0;
+        e.stamp.nsec         = 0;
+
+        const char* monitors[] = { "VMon", "IMon" };
+        const char* names[]    = { "VMON", "IMON" };
+        std::string egus[]     = { "V",    (*it)->getIMonUnits() };
+        StatsParams* params[]  = { &e.vmon_params, &e.imon_params };
+
+        for (std::size_t m(0); m < 2; ++m) {
+            std::stringstream prefix;
+            prefix << "S" << std::setfill('0') << std::setw(2) << slot << "_STATS_" << names[m];
+
+            status |= createParam((prefix.str() + "_MIN").c_str(),   asynParamFloat64Array, &params[m]->min_param);
+            status |= createParam((prefix.str() + "_MAX").c_str(),   asynParamFloat64Array, &params[m]->max_param);
+            status |= createParam((prefix.str() + "_MEAN").c_str(),  asynParamFloat64Array, &params[m]->mean_param);
+            status |= createParam((prefix.str() + "_RMS").c_str(),   asynParamFloat64Array, &params[m]->rms_param);
+            status |= createParam((prefix.str() + "_SLOPE").c_str(), asynParamFloat64Array, &params[m]->slope_param);
+
+            if (!epicsPrefix.empty()) {
+                std::stringstream dbParamsLocal;
+                dbParamsLocal << "P="      << CAENHVAsyn::epicsPrefix;
+                dbParamsLocal << ",R=S"    << std::setfill('0') << std::setw(2) << slot << ":" << monitors[m] << ":";
+                dbParamsLocal << ",STATS=" << prefix.str();
+                dbParamsLocal << ",NELM="  << (*it)->getNumChannels();
+                dbParamsLocal << ",EGU="   << egus[m];
+                dbParamsLocal << ",PORT="  << portName_;
+                dbLoadRecords("db/stats.template", dbParamsLocal.str().c_str());
+            }
+        }
+
+        statsList.push_back(e);
+    }
+
+    return (asynStatus)status;
+
+}
+
+/**
+ * Computes the windowed statistics of the i-th board, after a valid
+ * acquisition was added to its history, and publishes them with the time of
+ * that acquisition. Called by the acquisition thread.
+ */
+void CAENHVAsyn::updateStats(std::size_t i, const BoardSnapshotData& d) {
+
+    if ( ( i >= statsList.size() ) || ( !d.valid ) )
+        return;
+
+    StatsEntry& e = statsList.at(i);
+
+    // The statistics are computed without holding the port lock
+    historyList.at(i).history->stats(statsWindow, e.nextVMon, e.nextIMon);
+
+    this->lock();
+
+    std::swap(e.vMon, e.nextVMon);
+    std::swap(e.iMon, e.nextIMon);
+    e.stamp = d.stamp;
+
+    setTimeStamp(&e.stamp);
+    publishStats(e.vmon_params, e.vMon);
+    publishStats(e.imon_params, e.iMon);
+
+    this->unlock();
+
+}
+
+void CAENHVAsyn::publishStats(const StatsParams& p, BoardHistory::Stats& s) {
+
+    doCallbacksFloat64Array(s.min.data(),   s.min.size(),   p.min_param,   0);
+    doCallbacksFloat64Array(s.max.data(),   s.max.size(),   p.max_param,   0);
+    doCallbacksFloat64Array(s.mean.data(),  s.mean.size(),  p.mean_param,  0);
+    doCallbacksFloat64Array(s.rms.data(),   s.rms.size(),   p.rms_param,   0);
+    doCallbacksFloat64Array(s.slope.data(), s.slope.size(), p.slope_param, 0);
+
+}
+
+/**
+ * Looks for the windowed statistics array served by 'function'.
+ *
+ * @return the statistics entry of the board, or NULL if 'function' is not a
+ *         statistics parameter. 'v' is set to the array.
+ */
+const CAENHVAsyn::StatsEntry* CAENHVAsyn::findStats(int function, const std::vector<epicsFloat64>** v) const {
+
+    for (std::vector<StatsEntry>::const_iterator it = statsList.begin(); it != statsList.end(); ++it) {
+        const StatsParams* params[]        = { &it->vmon_params, &it->imon_params };
+        const BoardHistory::Stats* stats[] = { &it->vMon,        &it->iMon        };
+
+        for (std::size_t m(0); m < 2; ++m) {
+            const StatsParams& p = *params[m];
+            const BoardHistory::Stats& s = *stats[m];
+
+            if (function == p.min_param)
+                *v = &s.min;
+            else if (function == p.max_param)
+                *v = &s.max;
+            else if (function == p.mean_param)
+                *v = &s.mean;
+            else if (function == p.rms_param)
+                *v = &s.rms;
+            else if (function == p.slope_param)
+                *v = &s.slope;
+            else
+                continue;
+
+            return &(*it);
+        }
+    }
+
+    return NULL;
+
+}
+
+const CAENHVAsyn::TripEntry* CAENHVAsyn::findTrip(int function) const {
+
+    for (std::vector<TripEntry>::const_iterator it = tripList.begin(); it != tripList.end(); ++it)
+        if ( ( function == it->vmon_param ) || ( function == it->imon_param ) || ( function == it->status_param ) || ( function == it->time_param ) )
+            return &(*it);
+
+    return NULL;
+
+}
+
+/**
+ * A snapshot is considered too old if it wasn't refreshed during the last
+ * 3 acquisition periods (plus 1 second, to account for the time the
+ * acquisition itself takes).
+ */
+bool CAENHVAsyn::isStale(const epicsTimeStamp& stamp) const {
+
+    double period = acqPeriod.load();
+    if (period <= 0)
+        return true;
+
+    epicsTimeStamp now;
+    epicsTimeGetCurrent(&now);
+
+    return ( epicsTimeDiffInSeconds(&now, &stamp) > ( 3 * period + 1 ) );
+
+}
+
+/**
+ * Gets the value of a parameter from the board snapshots, without making any
+ * wrapper call and without waiting for the acquisition thread.
+ *
+ * @return false if the parameter is not in the snapshots, or if its value
+ * is not valid or too old. In that case it must be read from the crate.
+ */
+bool CAENHVAsyn::readSnapshot(asynUser *pasynUser, int function, epicsFloat64 *value) {
+
+    std::map<int, SnapshotEntry>::const_iterator it = snapshotParamList.find(function);
+    if (it == snapshotParamList.end())
+        return false;
+
+    const SnapshotEntry& e = it->second;
+    float v;
+    epicsTimeStamp stamp;
+    bool valid;
+
+    if (e.kind == SnapshotEntry::ChFloat)
+        valid = e.board->getSnapshot().readChFloat(e.index, e.channel, v, stamp);
+    else if (e.kind == SnapshotEntry::BdFloat)
+        valid = e.board->getSnapshot().readBdFloat(e.index, v, stamp);
+    else
+        return false;
+
+    if ( (!valid) || isStale(stamp) ) {
+        ++cacheMisses;
+        return false;
+    }
+
+    ++cacheHits;
+    *value = v;
+    pasynUser->timestamp = stamp;
+
+    return true;
+
+}
+
+bool CAENHVAsyn::readSnapshot(asynUser *pasynUser, int function, epicsUInt32 *value) {
+
+    std::map<int, SnapshotEntry>::const_iterator it = snapshotParamList.find(function);
+    if (it == snapshotParamList.end())
+        return false;
+
+    const SnapshotEntry& e = it->second;
+    uint32_t v;
+    epicsTimeStamp stamp;
+    bool valid;
+
+    if (e.kind == SnapshotEntry::ChWord)
+        valid = e.board->getSnapshot().readChWord(e.index, e.channel, v, stamp);
+    else if (e.kind == SnapshotEntry::BdWord)
+        valid = e.board->getSnapshot().readBdWord(e.index, v, stamp);
+    else
+        return false;
+
+    if ( (!valid) || isStale(stamp) ) {
+        ++cacheMisses;
+        return false;
+    }
+
+    ++cacheHits;
+    *value = v;
+    pasynUser->timestamp = stamp;
+
+    return true;
+
+}
+
+asynStatus CAENHVAsyn::createSchedulerParams() {
+
+    int status = (int)asynSuccess;
+
+    for (int i = 0; i < WrapperScheduler::NumPriorities; ++i) {
+        std::string prefix = std::string("SCHED_") + WrapperScheduler::getPriorityName((WrapperScheduler::Priority)i);
+        status |= createParam((prefix + "_DEPTH").c_str(),     asynParamInt32,   &sched_depth_param[i]);
+        status |= createParam((prefix + "_LAST_WAIT").c_str(), asynParamFloat64, &sched_last_wait_param[i]);
+        status |= createParam((prefix + "_MAX_WAIT").c_str(),  asynParamFloat64, &sched_max_wait_param[i]);
+    }
+    status |= createParam("SCHED_RESET_STATS", asynParamInt32, &sched_reset_param);
+    status |= createParam("WRAPPER_TIMEOUT", asynParamFloat64, &wrapper_timeout_param);
+    status |= createParam("WRAPPER_TIMEOUTS", asynParamInt32, &wrapper_timeouts_param);
+    status |= createParam("WRAPPER_QUARANTINED", asynParamInt32, &wrapper_quarantined_param);
+
+    scheduler.setTimeout(wrapperTimeout);
+    setDoubleParam(wrapper_timeout_param, wrapperTimeout);
+
+    return (asynStatus)status;
+
+}
+
+/**
+ * Copies the current scheduler statistics into the parameter library, if
+ * 'function' is one of the scheduler parameters.
+ * Queue depths are reported in number of requests, and wait times in ms.
+ * The number of wrapper calls timed out so far, and whether the scheduler
+ * is quarantined, are reported here as well.
+ *
+ * @return true if 'function' is a scheduler parameter
+ */
+bool CAENHVAsyn::updateSchedulerParams(int function) {
+
+    bool found = ( function == wrapper_timeouts_param || function == wrapper_quarantined_param );
+    for (int i = 0; i < WrapperScheduler::NumPriorities; ++i) {
+        if (function == sched_depth_param[i] || function == sched_last_wait_param[i] || function == sched_max_wait_param[i]) {
+            found = true;
+            break;
+        }
+    }
+
+    if (!found)
+        return false;
+
+    for (int i = 0; i < WrapperScheduler::NumPriorities; ++i) {
+        WrapperScheduler::Priority p = (WrapperScheduler::Priority)i;
+        setIntegerParam(sched_depth_param[i],     scheduler.getQueueDepth(p));
+        setDoubleParam(sched_last_wait_param[i],  scheduler.getLastWait(p) * 1000.0);
+        setDoubleParam(sched_max_wait_param[i],   scheduler.getMaxWait(p)  * 1000.0);
+    }
+    setIntegerParam(wrapper_timeouts_param,    scheduler.getTimeouts());
+    setIntegerParam(wrapper_quarantined_param, scheduler.isQuarantined());
+
+    return true;
+
+}
+
+/**
+ * Creates the parameters reporting the latency of the wrapper calls done on
+ * this crate: one set per wrapper function, one per board, and one for the
+ * calls not related to a board.
+ * If the auto-generation of PVs is enabled, the records for the boards are
+ * generated here. The records for the functions are in wrapperStats.db.
+ */
+asynStatus CAENHVAsyn::createWrapperStatsParams() {
+
+    int status = (int)asynSuccess;
+
+    wrapperStats = crate->getStats();
+
+    for (int i = 0; i < WrapperStats::NumFunctions; ++i) {
+        std::string prefix = "WSTAT_" + processParamName(WrapperStats::getFunctionName((WrapperStats::Function)i));
+        status |= createWrapperStatsParams(prefix, false, i);
+    }
+
+    status |= createWrapperStatsParams("WSTAT_CRATE", true, WrapperStats::NoSlot);
+
+    std::vector<Board> b = crate->getBoards();
+    for (std::vector<Board>::iterator it = b.begin(); it != b.end(); ++it) {
+        std::size_t slot = (*it)->getSlot();
+
+        std::stringstream prefix;
+        prefix << "WSTAT_S" << std::setfill('0') << std::setw(2) << slot;
+        status |= createWrapperStatsParams(prefix.str(), true, slot);
+
+        if (!epicsPrefix.empty()) {
+            std::stringstream dbParamsLocal;
+            dbParamsLocal << "P="     << CAENHVAsyn::epicsPrefix;
+            dbParamsLocal << ",R=S"   << std::setfill('0') << std::setw(2) << slot << ":";
+            dbParamsLocal << ",NAME=Wrapper";
+            dbParamsLocal << ",STAT=" << prefix.str();
+            dbParamsLocal << ",DESC=Slot " << slot;
+            dbParamsLocal << ",PORT=" << portName_;
+            dbLoadRecords("db/wrapperStats.template", dbParamsLocal.str().c_str());
+        }
+    }
+
+    status |= createParam("WSTAT_RESET", asynParamInt32, &wrapper_stats_reset_param);
+
+    return (asynStatus)status;
+
+}
+
+asynStatus CAENHVAsyn::createWrapperStatsParams(const std::string& prefix, bool perSlot, std::size_t index) {
+
+    int status = (int)asynSuccess;
+    int param;
+
+    status |= createParam((prefix + "_HIST").c_str(), asynParamInt32Array, &param);
+    wrapperStatsParamList[param] = { WrapperStatsEntry::Hist, perSlot, index };
+
+    status |= createParam((prefix + "_COUNT").c_str(), asynParamInt32, &param);
+    wrapperStatsParamList[param] = { WrapperStatsEntry::Count, perSlot, index };
+
+    status |= createParam((prefix + "_MEAN").c_str(), asynParamFloat64, &param);
+    wrapperStatsParamList[param] = { WrapperStatsEntry::Mean, perSlot, index };
+
+    status |= createParam((prefix + "_P99").c_str(), asynParamFloat64, &param);
+    wrapperStatsParamList[param] = { WrapperStatsEntry::P99, perSlot, index };
+
+    return (asynStatus)status;
+
+}
+
+WrapperStats::Summary CAENHVAsyn::getWrapperStats(const WrapperStatsEntry& e) const {
+
+    if (e.perSlot)
+        return wrapperStats->getSlot(e.index);
+    else
+        return wrapperStats->getFunction((WrapperStats::Function)e.index);
+
+}
+
+/**
+ * Copies the current wrapper call statistics into the parameter library, if
+ * 'function' is one of the count, mean or p99 parameters. Times are reported
+ * in ms. The histograms are read directly in readInt32Array.
+ *
+ * @return true if 'function' is a wrapper statistics parameter
+ */
+bool CAENHVAsyn::updateWrapperStatsParams(int function) {
+
+    std::map<int, WrapperStatsEntry>::const_iterator it = wrapperStatsParamList.find(function);
+    if ( ( it == wrapperStatsParamList.end() ) || ( it->second.kind == WrapperStatsEntry::Hist ) )
+        return false;
+
+    WrapperStats::Summary s = getWrapperStats(it->second);
+
+    if (it->second.kind == WrapperStatsEntry::Count)
+        setIntegerParam(function, s.count);
+    else if (it->second.kind == WrapperStatsEntry::Mean)
+        setDoubleParam(function, s.mean * 1000.0);
+    else
+        setDoubleParam(function, s.p99 * 1000.0);
+
+    return true;
+
+}
+
+const char* CAENHVAsyn::getIoMethodName(IoMethod m) {
+
+    switch (m) {
+        case ReadInt32:          return "READ_INT32";
+        case WriteInt32:         return "WRITE_INT32";
+        case ReadFloat64:        return "READ_FLOAT64";
+        case WriteFloat64:       return "WRITE_FLOAT64";
+        case ReadUInt32Digital:  return "READ_UINT32_DIGITAL";
+        case WriteUInt32Digital: return "WRITE_UINT32_DIGITAL";
+        case ReadOctet:          return "READ_OCTET";
+        case WriteOctet:         return "WRITE_OCTET";
+        default:                 return "UNKNOWN";
+    }
+
+}
+
+asynStatus CAENHVAsyn::createDriverStatsParams() {
+
+    int status = (int)asynSuccess;
+
+    for (int i = 0; i < NumIoMethods; ++i) {
+        std::string name = std::string("DRV_") + getIoMethodName((IoMethod)i) + "_RATE";
+        status |= createParam(name.c_str(), asynParamFloat64, &io_rate_param[i]);
+        setDoubleParam(io_rate_param[i], 0);
+    }
+    status |= createParam("DRV_CACHE_HIT_RATIO", asynParamFloat64, &cache_hit_ratio_param);
+    status |= createParam("DRV_POLL_CYCLE_TIME", asynParamFloat64, &poll_cycle_time_param);
+    status |= createParam("DRV_POLL_MISSED", asynParamInt32, &poll_missed_param);
+    status |= createParam("DRV_QUEUE_DEPTH", asynParamInt32, &queue_depth_param);
+    status |= createParam("DRV_FAILED_GETS", asynParamInt32, &failed_gets_param);
+    status |= createParam("DRV_RECONNECTS", asynParamInt32, &reconnects_param);
+    status |= createParam("DRV_LAST_READ_AGE", asynParamFloat64, &last_read_age_param);
+
+    setDoubleParam(cache_hit_ratio_param, 0);
+    setDoubleParam(poll_cycle_time_param, 0);
+    setIntegerParam(poll_missed_param, 0);
+    setIntegerParam(queue_depth_param, 0);
+    setIntegerParam(failed_gets_param, 0);
+    setIntegerParam(reconnects_param, 0);
+    setDoubleParam(last_read_age_param, 0);
+
+    return (asynStatus)status;
+
+}
+
+/**
+ * Updates the throughput and health counters once per second.
+ * Rates are computed over the last update interval. The cache hit ratio is
+ * the percentage of the reads of acquired parameters served from the board
+ * snapshots during that interval. The poll cycle time is in ms, and the time
+ * since the last successful read in seconds (-1 if there was none yet).
+ */
+void CAENHVAsyn::statsLoop() {
+
+    const double period = 1.0;
+
+    unsigned long lastIoCount[NumIoMethods];
+    for (int i = 0; i < NumIoMethods; ++i)
+        lastIoCount[i] = ioCount[i].load();
+
+    unsigned long lastHits   = cacheHits.load();
+    unsigned long lastMisses = cacheMisses.load();
+
+    epicsTimeStamp last;
+    epicsTimeGetCurrent(&last);
+
+    while (true) {
+
+        epicsThreadSleep(period);
+
+        epicsTimeStamp now;
+        epicsTimeGetCurrent(&now);
+        double elapsed = epicsTimeDiffInSeconds(&now, &last);
+        last = now;
+
+        if (elapsed <= 0)
+            continue;
+
+        this->lock();
+
+        for (int i = 0; i < NumIoMethods; ++i) {
+            unsigned long c = ioCount[i].load();
+            setDoubleParam(io_rate_param[i], ( c - lastIoCount[i] ) / elapsed);
+            lastIoCount[i] = c;
+        }
+
+        unsigned long hits   = cacheHits.load();
+        unsigned long misses = cacheMisses.load();
+        unsigned long total  = ( hits - lastHits ) + ( misses - lastMisses );
+        if (total)
+            setDoubleParam(cache_hit_ratio_param, 100.0 * ( hits - lastHits ) / total);
+        lastHits   = hits;
+        lastMisses = misses;
+
+        int depth = 0;
+        for (int i = 0; i < WrapperScheduler::NumPriorities; ++i)
+            depth += scheduler.getQueueDepth((WrapperScheduler::Priority)i);
+
+        double lastRead = lastReadTime.load();
+        double nowSeconds = now.secPastEpoch + now.nsec * 1e-9;
+
+        setDoubleParam(poll_cycle_time_param, pollCycleTime.load() * 1000.0);
+        setIntegerParam(poll_missed_param, missedDeadlines.load());
+        setIntegerParam(queue_depth_param, depth);
+        setIntegerParam(failed_gets_param, epicsAtomicGetIntT(&this->failed_gets));
+        setIntegerParam(reconnects_param, reconnects.load());
+        setDoubleParam(last_read_age_param, ( lastRead > 0 ) ? ( nowSeconds - lastRead ) : -1);
+
+        callParamCallbacks();
+
+        this->unlock();
+
+    }
+
+}
+
+const char* CAENHVAsyn::getTraceParamName(asynUser *pasynUser, int function) {
+
+    int addr;
+    const char *name;
+
+    if ( ( getAddress(pasynUser, &addr) != asynSuccess ) || ( getParamName(addr, function, &name) != asynSuccess ) )
+        return "unknown";
+
+    return name;
+
+}
+
+/**
+ * Creates the access statistics of all the parameters. Must be called after
+ * all the parameters are created.
+ */
+void CAENHVAsyn::createParamStats() {
+
+    const char *name;
+    for (numParams = 0; getParamName(numParams, &name) == asynSuccess; ++numParams);
+
+    paramStats.reset(new ParamStats[numParams]());
+
+}
+
+void CAENHVAsyn::updateParamStats(asynUser *pasynUser, int function, bool ok) {
+
+    if ( ( function < 0 ) || ( function >= numParams ) )
+        return;
+
+    ParamStats& s = paramStats[function];
+
+    if (!ok) {
+        ++s.errors;
+        return;
+    }
+
+    // Values read from the crate carry the time they were acquired
+    epicsTimeStamp stamp = pasynUser->timestamp;
+    if (stamp.secPastEpoch == 0)
+        epicsTimeGetCurrent(&stamp);
+
+    s.lastUpdate.store(stamp.secPastEpoch + stamp.nsec * 1e-9);
+
+}
+
+/**
+ * Driver report. It only uses driver-side statistics and cached values, and
+ * never calls the CAEN HV Wrapper library, so it is safe to run at any time.
+ *  - Level 0: connection state and counters.
+ *  - Level 1: adds per-board wrapper call latency, last acquisition and parameter counts.
+ *  - Level 2: adds per-parameter last value, age and error count.
+ *  - Level 3 and above: adds the asynPortDriver report.
+ */
+void CAENHVAsyn::report(FILE *fp, int details) {
+
+    epicsTimeStamp now;
+    epicsTimeGetCurrent(&now);
+    double nowSeconds = now.secPastEpoch + now.nsec * 1e-9;
+    double lastRead = lastReadTime.load();
+
+    unsigned long reads = 0, writes = 0;
+    for (int i = 0; i < NumIoMethods; ++i) {
+        if (i == ReadInt32 || i == ReadFloat64 || i == ReadUInt32Digital || i == ReadOctet)
+            reads += ioCount[i].load();
+        else
+            writes += ioCount[i].load();
+    }
+
+    unsigned long hits = cacheHits.load(), misses = cacheMisses.load();
+
+    std::size_t depth = 0;
+    for (int i = 0; i < WrapperScheduler::NumPriorities; ++i)
+        depth += scheduler.getQueueDepth((WrapperScheduler::Priority)i);
+
+    fprintf(fp, "%s port '%s', crate '%s', handle %d\n",
+        this->driverName_.c_str(), this->portName_.c_str(), crate->getIpAddr().c_str(), crate->getHandle());
+    fprintf(fp, "  Connection       : %s%s\n",
+        crate->isConnected() ? "connected" : "disconnected", scheduler.isQuarantined() ? ", quarantined" : "");
+    fprintf(fp, "  Failed gets      : %d\n", epicsAtomicGetIntT(&this->failed_gets));
+    fprintf(fp, "  Reconnects       : %lu\n", reconnects.load());
+    fprintf(fp, "  Wrapper timeouts : %lu (deadline %.3f s)\n", (unsigned long)scheduler.getTimeouts(), scheduler.getTimeout());
+    fprintf(fp, "  Queue depth      : %zu\n", depth);
+    fprintf(fp, "  Asyn calls       : %lu reads, %lu writes\n", reads, writes);
+    fprintf(fp, "  Snapshot cache   : %lu hits, %lu misses\n", hits, misses);
+    fprintf(fp, "  Acquisition      : period %.3f s, last cycle %.3f ms, %lu missed deadlines\n",
+        acqPeriod.load(), pollCycleTime.load() * 1000.0, missedDeadlines.load());
+    if (lastRead > 0)
+        fprintf(fp, "  Last read        : %.3f s ago\n", nowSeconds - lastRead);
+    else
+        fprintf(fp, "  Last read        : never\n");
+
+    if (dataLog.isOpen())
+        fprintf(fp, "  Data log         : %llu records, %zu kept\n",
+            (unsigned long long)dataLog.getWritten(), dataLog.getCapacity());
+
+    if (details >= 1)
+        reportBoards(fp);
+
+    if (details >= 2)
+        reportParams(fp);
+
+    if (details >= 3)
+        asynPortDriver::report(fp, details);
+
+}
+
+void CAENHVAsyn::reportBoards(FILE *fp) {
+
+    std::vector<Board> b = crate->getBoards();
+
+    fprintf(fp, "  Boards:\n");
+    fprintf(fp, "    %-4s %-10s %4s %7s %10s %10s %10s %12s %s\n",
+        "Slot", "Model", "Chs", "Params", "Calls", "Mean (ms)", "P99 (ms)", "Acq. (ms)", "Acq. status");
+
+    for (std::vector<Board>::iterator it = b.begin(); it != b.end(); ++it) {
+        std::size_t params = (*it)->getBoardParameterNumerics().size() + (*it)->getBoardParameterOnOffs().size() +
+                             (*it)->getBoardParameterChStatuses().size() + (*it)->getBoardParameterBdStatuses().size();
+
+        std::vector<Channel> c = (*it)->getChannels();
+        for (std::vector<Channel>::iterator chIt = c.begin(); chIt != c.end(); ++chIt)
+            params += (*chIt)->getChannelParameterNumerics().size() + (*chIt)->getChannelParameterOnOffs().size() +
+                      (*chIt)->getChannelParameterChStatuses().size() + (*chIt)->getChannelParameterBinaries().size();
+
+        WrapperStats::Summary s = wrapperStats->getSlot((*it)->getSlot());
+
+        BoardSnapshotData d;
+        (*it)->getSnapshot().read(d);
+
+        const char *acqStatus;
+        if (d.stamp.secPastEpoch == 0)
+            acqStatus = "none";
+        else if (!d.valid)
+            acqStatus = "failed";
+        else if (isStale(d.stamp))
+            acqStatus = "stale";
+        else
+            acqStatus = "ok";
+
+        fprintf(fp, "    %-4zu %-10s %4zu %7zu %10u %10.3f %10.3f %12.3f %s\n",
+            (*it)->getSlot(), (*it)->getModel().c_str(), (*it)->getNumChannels(), params,
+            s.count, s.mean * 1000.0, s.p99 * 1000.0, d.duration * 1000.0, acqStatus);
+    }
+
+}
+
+void CAENHVAsyn::reportParams(FILE *fp) {
+
+    epicsTimeStamp now;
+    epicsTimeGetCurrent(&now);
+    double nowSeconds = now.secPastEpoch + now.nsec * 1e-9;
+
+    fprintf(fp, "  Parameters:\n");
+    fprintf(fp, "    %-5s %-40s %-20s %12s %8s\n", "Index", "Name", "Value", "Age (s)", "Errors");
+
+    for (int i = 0; i < numParams; ++i) {
+        const char *name;
+        if (getParamName(i, &name) != asynSuccess)
+            continue;
+
+        // The value cached in the parameter library
+        char value[64] = "undefined";
+        asynParamType type;
+        if (getParamType(i, &type) == asynSuccess) {
+            if (type == asynParamInt32) {
+                epicsInt32 v;
+                if (getIntegerParam(i, &v) == asynSuccess)
+                    snprintf(value, sizeof(value), "%d", v);
+            } else if (type == asynParamFloat64) {
+                epicsFloat64 v;
+                if (getDoubleParam(i, &v) == asynSuccess)
+                    snprintf(value, sizeof(value), "%g", v);
+            } else if (type == asynParamUInt32Digital) {
+                epicsUInt32 v;
+                if (getUIntDigitalParam(i, &v, 0xFFFFFFFF) == asynSuccess)
+                    snprintf(value, sizeof(value), "0x%08x", v);
+            } else if (type == asynParamOctet) {
+                getStringParam(i, sizeof(value), value);
+            } else {
+                snprintf(value, sizeof(value), "(array)");
+            }
+        }
+
+        double last = paramStats[i].lastUpdate.load();
+        char age[32] = "-";
+        if (last > 0)
+            snprintf(age, sizeof(age), "%.3f", nowSeconds - last);
+
+        fprintf(fp, "    %-5d %-40s %-20s %12s %8lu\n", i, name, value, age, paramStats[i].errors.load());
+    }
+
+}
+
+asynStatus CAENHVAsyn::createAllOffParams() {
+
+    int status = (int)asynSuccess;
+
+    status = createParam("ALL_OFF", asynParamInt32, &all_off_param);
+    status |= createParam("ALL_OFF_TIME", asynParamFloat64, &all_off_time_param);
+
+    setDoubleParam(all_off_time_param, 0);
+
+    return (asynStatus)status;
+
+}
+
+/**
+ * Turns off all the channels in the crate, as fast as possible.
+ * One multi-channel 'Pw' write is sent per board, with safety priority, so
+ * that it goes ahead of any pending read. The time it took, in ms, is
+ * stored in the ALL_OFF_TIME parameter.
+ */
+void CAENHVAsyn::allChannelsOff() {
+
+    epicsTimeStamp start, end;
+    epicsTimeGetCurrent(&start);
+
+    scheduler.run(WrapperScheduler::Safety, [this]() { this->crate->allChannelsOff(); });
+
+    epicsTimeGetCurrent(&end);
+    setDoubleParam(all_off_time_param, epicsTimeDiffInSeconds(&end, &start) * 1000.0);
+
+    asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
+        "Driver '%s', Port '%s': all channels turned off in %f ms\n", \
+        this->driverName_.c_str(), this->portName_.c_str(), epicsTimeDiffInSeconds(&end, &start) * 1000.0);
+
+}
+
+asynStatus CAENHVAsyn::createSetpointParams() {
+
+    int status = (int)asynSuccess;
+
+    status = createParam("SETPOINT_FILE", asynParamOctet, &setpoint_file_param);
+    status |= createParam("SETPOINT_RESTORE", asynParamInt32, &setpoint_restore_param);
+    status |= createParam("SETPOINT_RESTORE_COUNT", asynParamInt32, &setpoint_restore_count_param);
+    status |= createParam("SETPOINT_RESTORE_FAILED", asynParamInt32, &setpoint_restore_failed_param);
+    status |= createParam("SETPOINT_RESTORE_TIME", asynParamFloat64, &setpoint_restore_time_param);
+    status |= createParam("SETPOINT_SAVE", asynParamInt32, &setpoint_save_param);
+    status |= createParam("SETPOINT_SAVE_COUNT", asynParamInt32, &setpoint_save_count_param);
+    status |= createParam("SETPOINT_SAVE_FAILED", asynParamInt32, &setpoint_save_failed_param);
+    status |= createParam("SETPOINT_SAVE_TIME", asynParamFloat64, &setpoint_save_time_param);
+
+    setStringParam(setpoint_file_param, "");
+    setIntegerParam(setpoint_restore_count_param, 0);
+    setIntegerParam(setpoint_restore_failed_param, 0);
+    setDoubleParam(setpoint_restore_time_param, 0);
+    setIntegerParam(setpoint_save_count_param, 0);
+    setIntegerParam(setpoint_save_failed_param, 0);
+    setDoubleParam(setpoint_save_time_param, 0);
+
+    return (asynStatus)status;
+
+}
+
+/**
+ * Applies the setpoints in a file. The setpoints with the same slot,
+ * parameter and value are written with a single multi-channel wrapper call,
+ * with operator priority. Each group which fails is reported, and the number
+ * of setpoints applied, the number which failed, and the time it took, in ms,
+ * are stored in the SETPOINT_RESTORE_* parameters.
+ */
+int CAENHVAsyn::restoreSetpoints(const std::string& fileName) {
+
+    epicsTimeStamp start, end;
+    epicsTimeGetCurrent(&start);
+
+    std::vector<Setpoint> setpoints;
+    try {
+        readSetpointFile(fileName, setpoints);
+    } catch (const std::runtime_error& e) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+            "Driver '%s', Port '%s': setpoint restore failed: %s\n", \
+            this->driverName_.c_str(), this->portName_.c_str(), e.what());
+        return -1;
+    }
+
+    std::vector<SetpointGroup> groups;
+    groupSetpoints(setpoints, groups);
+
+    std::map<std::size_t, Board> boards;
+    std::vector<Board> b = crate->getBoards();
+    for (std::vector<Board>::iterator it = b.begin(); it != b.end(); ++it)
+        boards[(*it)->getSlot()] = *it;
+
+    std::size_t applied(0), failed(0);
+    for (std::vector<SetpointGroup>::const_iterator it = groups.begin(); it != groups.end(); ++it) {
+        try {
+            std::map<std::size_t, Board>::const_iterator bIt = boards.find(it->slot);
+            if (bIt == boards.end())
+                throw std::runtime_error("there is no board in this slot");
+
+            // The job can outlive this call if it times out, so it gets copies
+            Board board = bIt->second;
+            SetpointGroup g = *it;
+            if (g.board)
+                scheduler.run(WrapperScheduler::Operator, [board, g]() { board->setBdParam(g.param, g.value); });
+            else
+                scheduler.run(WrapperScheduler::Operator, [board, g]() { board->setChParam(g.param, g.channels, g.value); });
+
+            applied += it->count;
+        } catch (const std::runtime_error& e) {
+            failed += it->count;
+
+            std::stringstream channels;
+            for (std::vector<uint16_t>::const_iterator cIt = it->channels.begin(); cIt != it->channels.end(); ++cIt)
+                channels << ( ( cIt == it->channels.begin() ) ? "" : "," ) << *cIt;
+
+            asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                "Driver '%s', Port '%s': failed to set '%s' to %g in slot %zu%s%s: %s\n", \
+                this->driverName_.c_str(), this->portName_.c_str(), it->param.c_str(), it->value, it->slot, \
+                it->board ? "" : ", channels ", channels.str().c_str(), e.what());
+        }
+    }
+
+    // Refresh the readbacks right away
+    epicsEventSignal(acqWakeUp);
+
+    epicsTimeGetCurrent(&end);
+    double ms = epicsTimeDiffInSeconds(&end, &start) * 1000.0;
+
+    setIntegerParam(setpoint_restore_count_param, applied);
+    setIntegerParam(setpoint_restore_failed_param, failed);
+    setDoubleParam(setpoint_restore_time_param, ms);
+    callParamCallbacks();
+
+    asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
+        "Driver '%s', Port '%s': %zu setpoints restored from '%s' with %zu wrapper calls in %f ms, %zu failed\n", \
+        this->driverName_.c_str(), this->portName_.c_str(), applied, fileName.c_str(), groups.size(), ms, failed);
+
+    return failed;
+
+}
+
+/**
+ * Writes the readable setpoints of all the boards to a file. Each board is
+ * read with a single job, using one multi-channel wrapper call per parameter.
+ * The file starts with comments with the time of the snapshot and, for each
+ * slot, the model, serial number and firmware release of its board, and the
+ * time at which it was read. A board which can not be read is reported, and
+ * left out of the file. Updates the number of setpoints saved, the number of
+ * boards which failed, and the time it took, in ms. Must be called with the
+ * port locked.
+ */
+int CAENHVAsyn::saveSetpoints(const std::string& fileName) {
+
+    epicsTimeStamp start, end;
+    epicsTimeGetCurrent(&start);
+
+    char stamp[40];
+    epicsTimeToStrftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S.%06f", &start);
+
+    std::vector<std::string> comments;
+    comments.push_back("CAEN HV setpoint snapshot of port '" + portName_ + "', taken " + stamp);
+    comments.push_back("Slot  Model       Serial  Firmware  Read at");
+
+    std::vector<Setpoint> setpoints;
+    std::size_t failed(0);
+
+    std::vector<Board> boards = crate->getBoards();
+    for (std::vector<Board>::const_iterator it = boards.begin(); it != boards.end(); ++it) {
+        char line[128];
+
+        try {
+            // The job can outlive this call if it times out, so it gets copies
+            Board board = *it;
+            std::shared_ptr< std::vector<Setpoint> > values = std::make_shared< std::vector<Setpoint> >();
+            epicsTimeStamp readStamp;
+
+            scheduler.run(WrapperScheduler::Operator, [board, values]() { board->readSetpoints(*values); }, &readStamp);
+
+            setpoints.insert(setpoints.end(), values->begin(), values->end());
+
+            epicsTimeToStrftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S.%06f", &readStamp);
+            snprintf(line, sizeof(line), "%4zu  %-10s  %6s  %-8s  %s", (*it)->getSlot(), (*it)->getModel().c_str(), \
+                (*it)->getSerialNumber().c_str(), (*it)->getFirmwareRelease().c_str(), stamp);
+        } catch (const std::runtime_error& e) {
+            ++failed;
+
+            snprintf(line, sizeof(line), "%4zu  %-10s  %6s  %-8s  not read", (*it)->getSlot(), (*it)->getModel().c_str(), \
+                (*it)->getSerialNumber().c_str(), (*it)->getFirmwareRelease().c_str());
+
+            asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                "Driver '%s', Port '%s': failed to read the setpoints of slot %zu: %s\n", \
+                this->driverName_.c_str(), this->portName_.c_str(), (*it)->getSlot(), e.what());
+        }
+
+        comments.push_back(line);
+    }
+
+    int ret = failed;
+    try {
+        writeSetpointFile(fileName, comments, setpoints);
+    } catch (const std::runtime_error& e) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+            "Driver '%s', Port '%s': setpoint snapshot failed: %s\n", \
+            this->driverName_.c_str(), this->portName_.c_str(), e.what());
+        ret = -1;
+    }
+
+    epicsTimeGetCurrent(&end);
+    double ms = epicsTimeDiffInSeconds(&end, &start) * 1000.0;
+
+    setIntegerParam(setpoint_save_count_param, ( ret < 0 ) ? 0 : setpoints.size());
+    setIntegerParam(setpoint_save_failed_param, failed);
+    setDoubleParam(setpoint_save_time_param, ms);
+    callParamCallbacks();
+
+    asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
+        "Driver '%s', Port '%s': %zu setpoints saved to '%s' in %f ms, %zu boards failed\n", \
+        this->driverName_.c_str(), this->portName_.c_str(), setpoints.size(), fileName.c_str(), ms, failed);
+
+    return ret;
+
+}
+
+asynStatus CAENHVAsyn::createChNameParams() {
+
+    int status = (int)asynSuccess;
+
+    std::vector<Board> b = crate->getBoards();
+    for (std::vector<Board>::iterator it = b.begin(); it != b.end(); ++it) {
+        std::size_t slot = (*it)->getSlot();
+
+        ChNameEntry e;
+        e.board = *it;
+
+        std::stringstream paramName;
+        paramName << "S" << std::setfill('0') << std::setw(2) << slot << "_CH_NAMES";
+        status |= createParam(paramName.str().c_str(), asynParamOctet, &e.names_param);
+
+        if (!epicsPrefix.empty()) {
+            std::stringstream dbParamsLocal;
+            dbParamsLocal << "P="      << CAENHVAsyn::epicsPrefix;
+            dbParamsLocal << ",PORT="  << portName_;
+            dbParamsLocal << ",PARAM=" << paramName.str();
+            dbParamsLocal << ",DESC='Slot " << slot << ", channel names'";
+            dbParamsLocal << ",NELM="  << (*it)->getNumChannels() * MAX_CH_NAME;
+            dbParamsLocal << ",R=S"    << std::setfill('0') << std::setw(2) << slot << ":ChNames:Rd";
+            dbParamsLocal << ",SCAN=I/O Intr";
+            dbParamsLocal << ",TSE="   << CAENHVAsyn::timeStampEvent;
+            dbLoadRecords("db/stringin.template", dbParamsLocal.str().c_str());
+            dbParamsLocal << ",R=S"    << std::setfill('0') << std::setw(2) << slot << ":ChNames:St";
+            dbLoadRecords("db/stringout.template", dbParamsLocal.str().c_str());
+        }
+
+        for (std::size_t c = 0; c < (*it)->getNumChannels(); ++c) {
+            std::stringstream channelParamName;
+            channelParamName << "S" << std::setfill('0') << std::setw(2) << slot << "_"
+                             << "C" << std::setfill('0') << std::setw(2) << c << "_NAME";
+
+            int index;
+            status |= createParam(channelParamName.str().c_str(), asynParamOctet, &index);
+            e.channel_params.push_back(index);
+
+            if (!epicsPrefix.empty()) {
+                std::stringstream dbParamsLocal;
+                dbParamsLocal << "P="      << CAENHVAsyn::epicsPrefix;
+                dbParamsLocal << ",R=S"    << std::setfill('0') << std::setw(2) << slot << ":"
+                              << "C" << std::setfill('0') << std::setw(2) << c << ":Name";
+                dbParamsLocal << ",PORT="  << portName_;
+                dbParamsLocal << ",PARAM=" << channelParamName.str();
+                dbParamsLocal << ",DESC='Slot " << slot << ", Ch " << c << ", name'";
+                dbParamsLocal << ",TSE="   << CAENHVAsyn::timeStampEvent;
+                dbLoadRecords("db/chName.template", dbParamsLocal.str().c_str());
+            }
+        }
+
+        chNameList.push_back(e);
+    }
+
+    status |= createParam("CH_NAME_REFRESH", asynParamInt32, &ch_name_refresh_param);
+
+    for (std::vector<ChNameEntry>::iterator it = chNameList.begin(); it != chNameList.end(); ++it)
+        refreshChNames(*it);
+
+    return (asynStatus)status;
+
+}
+
+/**
+ * Reads the names of all the channels of a board, with a single wrapper
+ * call, and publishes them. Errors are reported, and the previous names
+ * are kept. Must be called with the port locked, except from the
+ * constructor.
+ */
+void CAENHVAsyn::refreshChNames(ChNameEntry& e) {
+
+    // The job can outlive this call if it times out, so it gets copies
+    Board board = e.board;
+    std::shared_ptr< std::vector<std::string> > names = std::make_shared< std::vector<std::string> >();
+    epicsTimeStamp stamp;
+
+    try {
+        scheduler.run(WrapperScheduler::SlowPoll, [board, names]() { board->getChNames(*names); }, &stamp);
+    } catch (const std::runtime_error& err) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+            "Driver '%s', Port '%s': failed to read the channel names of slot %zu: %s\n", \
+            this->driverName_.c_str(), this->portName_.c_str(), board->getSlot(), err.what());
+        return;
+    }
+
+    e.names = *names;
+
+    std::string all;
+    for (std::size_t c = 0; ( c < e.names.size() ) && ( c < e.channel_params.size() ); ++c) {
+        setStringParam(e.channel_params.at(c), e.names.at(c).c_str());
+        all += e.names.at(c) + "\n";
+    }
+    setStringParam(e.names_param, all.c_str());
+
+    setTimeStamp(&stamp);
+    callParamCallbacks();
+
+}
+
+/**
+ * Finds the board of a channel name parameter. 'channel' is set to the
+ * channel, or to -1 for the parameter with the names of all the channels.
+ *
+ * @return the entry of the board, or NULL if 'function' is not a channel
+ * name parameter
+ */
+CAENHVAsyn::ChNameEntry* CAENHVAsyn::findChName(int function, int& channel) {
+
+    for (std::vector<ChNameEntry>::iterator it = chNameList.begin(); it != chNameList.end(); ++it) {
+        if (it->names_param == function) {
+            channel = -1;
+            return &(*it);
+        }
+
+        std::vector<int>::const_iterator cIt = std::find(it->channel_params.begin(), it->channel_params.end(), function);
+        if (cIt != it->channel_params.end()) {
+            channel = cIt - it->channel_params.begin();
+            return &(*it);
+        }
+    }
+
+    return NULL;
+
+}
+
+/**
+ * Writes the name of a channel of a board or, if 'channel' is negative, the
+ * names of its channels: 'value' has one name per line (or separated by
+ * commas), starting at channel 0, and the channels without a name in
+ * 'value' are left unchanged. Only the names which change are written, with
+ * a single job for the board and one wrapper call per distinct name. The
+ * names are read back afterwards. Throws a std::invalid_argument if 'value'
+ * has more names than channels or a name which is too long, before any
+ * wrapper call, and a std::runtime_error on errors.
+ */
+void CAENHVAsyn::writeChNames(ChNameEntry& e, int channel, const std::string& value) {
+
+    std::vector<std::string> names(e.names);
+    names.resize(e.channel_params.size());
+
+    if (channel >= 0) {
+        names.at(channel) = value;
+    } else {
+        std::vector<std::string> list;
+        std::string name;
+        for (std::string::const_iterator sIt = value.begin(); sIt != value.end(); ++sIt) {
+            if ( ( *sIt == '\n' ) || ( *sIt == ',' ) ) {
+                list.push_back(name);
+                name.clear();
+            } else {
+                name += *sIt;
+            }
+        }
+        if (!name.empty())
+            list.push_back(name);
+
+        if (list.size() > names.size())
+            throw std::invalid_argument("more names than channels in the board");
+
+        std::copy(list.begin(), list.end(), names.begin());
+    }
+
+    // Channels to rename, grouped by their new name
+    std::map< std::string, std::vector<uint16_t> > groups;
+    for (std::size_t c = 0; c < names.size(); ++c) {
+        if ( ( c < e.names.size() ) && ( names.at(c) == e.names.at(c) ) )
+            continue;
+
+        if (names.at(c).size() >= MAX_CH_NAME)
+            throw std::invalid_argument("'" + names.at(c) + "' is longer than the maximum channel name length");
+
+        groups[names.at(c)].push_back(c);
+    }
+
+    if (groups.empty())
+        return;
+
+    Board board = e.board;
+    try {
+        scheduler.run(WrapperScheduler::Operator, [board, groups]() {
+            for (std::map< std::string, std::vector<uint16_t> >::const_iterator gIt = groups.begin(); gIt != groups.end(); ++gIt)
+                board->setChName(gIt->second, gIt->first);
+        });
+    } catch (...) {
+        // Some of the names may have been written
+        refreshChNames(e);
+        throw;
+    }
+
+    refreshChNames(e);
+
+}
+
+/**
+ * Reads a value through the scheduler, with priority 'p'.
+ * The time at which the wrapper call started is used as the timestamp
+ * of the value, both for the parameter library and for the calling
+ * record (used when TSE=-2). The duration of the wrapper call, in ms,
+ * is stored in the ACQ_DURATION parameter as a measure of the uncertainty
+ * of that timestamp.
+ * The value is returned through a buffer owned by the job and not by the
+ * caller, as the job can outlive this call if the wrapper call times out.
+ */
+template <typename T>
+T CAENHVAsyn::acquire(asynUser *pasynUser, WrapperScheduler::Priority p, const std::function<T()>& f) {
+
+    epicsTimeStamp stamp;
+    double duration;
+    std::shared_ptr<T> result = std::make_shared<T>();
+
+    scheduler.run(p, [result, f]() { *result = f(); }, &stamp, &duration);
+
+    lastReadTime.store(stamp.secPastEpoch + stamp.nsec * 1e-9);
+    setTimeStamp(&stamp);
+    pasynUser->timestamp = stamp;
+    setDoubleParam(acq_duration_param, duration * 1000.0);
+
+    return *result;
+
+}
+
+/**
+ * Monitor parameters (read-only parameters, like VMon, IMon or Status) are
+ * read with higher priority than the rest of the parameters.
+ */
+WrapperScheduler::Priority CAENHVAsyn::getPollPriority(const std::string& mode) {
+
+    if (!mode.compare("RO"))
+        return WrapperScheduler::FastPoll;
+
+    return WrapperScheduler::SlowPoll;
+
+}
+
+/**
+ * Publishes the timing of an acquisition cycle, right away, so that overruns
+ * are visible as soon as they happen. Times are in ms. The cycle time and
+ * the number of overruns are the DRV_POLL_CYCLE_TIME and DRV_POLL_MISSED
+ * driver statistics, counted by the acquisition loop. The jitter is the
+ * delay between the time the cycle was due and the time it started. An
+ * overrun is attributed to the board which took the longest in the cycle.
+ */
+void CAENHVAsyn::publishAcqTiming(double period, double cycleTime, double jitter, const std::vector<double>& boardTimes) {
+
+    this->lock();
+
+    acqCycleMax  = std::max(acqCycleMax, cycleTime);
+    acqJitterMax = std::max(acqJitterMax, jitter);
+
+    setDoubleParam(poll_cycle_time_param, pollCycleTime.load() * 1000.0);
+    setIntegerParam(poll_missed_param,    missedDeadlines.load());
+    setDoubleParam(acq_cycle_max_param,  acqCycleMax * 1000.0);
+    setDoubleParam(acq_jitter_param,     jitter * 1000.0);
+    setDoubleParam(acq_jitter_max_param, acqJitterMax * 1000.0);
+
+    std::size_t slowest = 0;
+    for (std::size_t i = 0; ( i < boardTimes.size() ) && ( i < acqSlotTiming.size() ); ++i) {
+        AcqSlotTiming& t = acqSlotTiming.at(i);
+        t.max = std::max(t.max, boardTimes.at(i));
+        setDoubleParam(t.time_param, boardTimes.at(i) * 1000.0);
+        setDoubleParam(t.max_param,  t.max * 1000.0);
+
+        if (boardTimes.at(i) > boardTimes.at(slowest))
+            slowest = i;
+    }
+
+    if ( ( cycleTime > period ) && ( slowest < acqSlotTiming.size() ) ) {
+        std::size_t slot = crate->getBoards().at(slowest)->getSlot();
+        AcqSlotTiming& t = acqSlotTiming.at(slowest);
+
+        setIntegerParam(acq_overrun_slot_param, slot);
+        setIntegerParam(t.overruns_param, ++t.overruns);
+
+        asynPrint(pasynUserSelf, ASYN_TRACE_WARNING, \
+            "Driver '%s', Port '%s': acquisition cycle took %.3f s, longer than the period of %.3f s. Slowest board: slot %zu (%.3f s)\n", \
+            this->driverName_.c_str(), this->portName_.c_str(), cycleTime, period, slot, boardTimes.at(slowest));
+    }
+
+    callParamCallbacks();
+
+    this->unlock();
+
+}
+
+// Must be called with the port locked
+void CAENHVAsyn::resetAcqTiming() {
+
+    acqCycleMax  = 0;
+    acqJitterMax = 0;
+    missedDeadlines.store(0);
+
+    setDoubleParam(acq_cycle_max_param, 0);
+    setDoubleParam(acq_jitter_max_param, 0);
+
+    for (std::vector<AcqSlotTiming>::iterator it = acqSlotTiming.begin(); it != acqSlotTiming.end(); ++it) {
+        it->max      = 0;
+        it->overruns = 0;
+        setDoubleParam(it->time_param, 0);
+        setDoubleParam(it->max_param, 0);
+        setIntegerParam(it->overruns_param, 0);
+    }
+
+}
+
+/**
+ * Acquires all the readable board and channel parameters, one board at a
+ * time, and publishes them in the board snapshots. Each board is read with
+ * one wrapper call per parameter (for all its channels), with fast poll
+ * priority, so writes can still go ahead between boards.
+ * The readers never take part on this: they just get the latest snapshot.
+ */
+void CAENHVAsyn::acqLoop() {
+
+    std::vector<Board> boards = crate->getBoards();
+    std::vector<double> boardTimes(boards.size());
+    BoardSnapshotData snapshot;
+
+    // Acquisition buffer of each board, owned by its acquisition job. A job
+    // which timed out may still be writing on its buffer, so a new one is
+    // used after a failure.
+    std::vector< std::shared_ptr<BoardSnapshotData> > buffers;
+    for (std::size_t i = 0; i < boards.size(); ++i)
+        buffers.push_back(std::make_shared<BoardSnapshotData>());
+
+    // Time at which the next cycle is due. The jitter is only measured on
+    // the cycles started by the timer, and not by a write.
+    epicsTimeStamp due;
+    bool scheduled = false;
+
+    // While the scheduler is quarantined all the reads are refused, so the
+    // boards are published as invalid once, and the cycles are skipped
+    // until the connection is reinitialized.
+    bool suspended = false;
+
+    while (true) {
+
+        double period = acqPeriod.load();
+
+        // A period of zero disables the acquisition
+        if (period <= 0) {
+            epicsEventWait(acqWakeUp);
+            scheduled = false;
+            continue;
+        }
+
+        bool quarantined = scheduler.isQuarantined();
+        if (quarantined && suspended) {
+            epicsEventWaitWithTimeout(acqWakeUp, period);
+            scheduled = false;
+            continue;
+        }
+
+        if (quarantined != suspended)
+            asynPrint(pasynUserSelf, quarantined ? ASYN_TRACE_ERROR : ASYN_TRACE_FLOW, \
+                "Driver '%s', Port '%s': acquisition %s\n", \
+                this->driverName_.c_str(), this->portName_.c_str(), \
+                quarantined ? "suspended until the connection is reinitialized" : "resumed");
+        suspended = quarantined;
+
+        epicsTimeStamp cycleStart;
+        epicsTimeGetCurrent(&cycleStart);
+        double jitter = scheduled ? std::max(0.0, epicsTimeDiffInSeconds(&cycleStart, &due)) : 0;
+
+        for (std::size_t i = 0; i < boards.size(); ++i) {
+            std::vector<Board>::iterator it = boards.begin() + i;
+            epicsTimeStamp stamp = cycleStart;
+            double duration = 0;
+            bool valid = true;
+
+            // The board time includes the wait for other wrapper calls
+            epicsTimeStamp boardStart;
+            epicsTimeGetCurrent(&boardStart);
+
+            EVENT_TRACE_SCOPE("acq", "acquire", (*it)->getSlot());
+
+            // The quarantine can also start in the middle of the cycle. The
+            // calls it refuses are not failures of the crate.
+            if ( suspended || scheduler.isQuarantined() ) {
+                valid = false;
+            } else {
+                try {
+                    Board board = *it;
+                    std::shared_ptr<BoardSnapshotData> data = buffers.at(i);
+                    scheduler.run(WrapperScheduler::FastPoll, [board, data]() { board->acquire(*data); }, &stamp, &duration);
+                } catch (const WrapperSuspended&) {
+                    // Not executed, so the buffer can be used again
+                    valid = false;
+                } catch (const std::runtime_error& e) {
+                    valid = false;
+                    buffers.at(i) = std::make_shared<BoardSnapshotData>();
+                    epicsAtomicIncrIntT(&this->failed_gets);
+                    asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                        "Driver '%s', Port '%s': acquisition of slot %zu failed: '%s'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), (*it)->getSlot(), e.what());
+                }
+            }
+
+            if (valid)
+                lastReadTime.store(stamp.secPastEpoch + stamp.nsec * 1e-9);
+
+            (*it)->publish(valid ? *buffers.at(i) : snapshot, stamp, duration, valid);
+
+            (*it)->getSnapshot().read(snapshot);
+            publishBoardArrays(*it, snapshot);
+            if (i < historyList.size())
+                historyList.at(i).history->push(snapshot);
+            checkTrips(i, snapshot);
+            updateStats(i, snapshot);
+            updateSummary(i, snapshot);
+            logAcquisition(i, snapshot);
+
+            epicsTimeStamp boardEnd;
+            epicsTimeGetCurrent(&boardEnd);
+            boardTimes.at(i) = epicsTimeDiffInSeconds(&boardEnd, &boardStart);
+        }
+
+        // Wait for the next cycle. Writes wake us up earlier, so that their
+        // readbacks are refreshed right away.
+        epicsTimeStamp cycleEnd;
+        epicsTimeGetCurrent(&cycleEnd);
+        double cycleTime = epicsTimeDiffInSeconds(&cycleEnd, &cycleStart);
+        pollCycleTime.store(cycleTime);
+        if (cycleTime > period)
+            ++missedDeadlines;
+
+        publishAcqTiming(period, cycleTime, jitter, boardTimes);
+
+        due = cycleStart;
+        epicsTimeAddSeconds(&due, period);
+
+        // After an overrun the next cycle is already late
+        double wait = period - cycleTime;
+        scheduled = ( wait <= 0 ) || ( epicsEventWaitWithTimeout(acqWakeUp, wait) == epicsEventWaitTimeout );
+    }
+
+}
+
+/**
+ * Resets connection if too many failed gets are detected.
+ * Assumes the system is the same, so doesn't call GetPropList() or GetCrateMap()
+ * ( See ICrate::ICrate() constructor )
+ */
+void CAENHVAsyn::connMon() {
+
+    int fails, count_limit, allowed_fails, count = 0;
+    double monitor_thread_sleep, sleep_after_fail;
+    bool waitingHung = false;
+
+    while (true) {
+
+        getIntegerParam(fail_count_limit, &count_limit);
+        getIntegerParam(allowed_fails_param, &allowed_fails);
+        getDoubleParam(mon_thread_sleep_param, &monitor_thread_sleep);
+        getDoubleParam(conn_fail_sleep, &sleep_after_fail);
+
+        // Avoid accumulating fails that have nothing to do with disconnection
+        if (count >= count_limit) {
+            epicsAtomicSetIntT(&this->failed_gets, 0);
+            count = 0;
+        }
+
+        // A wrapper call timing out quarantines the scheduler, which
+        // triggers the reinitialization right away. It waits for the hung
+        // call to return, as the handle can not be used in the mean time.
+        fails = epicsAtomicGetIntT(&this->failed_gets);
+        if ( ( ( fails > allowed_fails ) || scheduler.isQuarantined() ) && scheduler.isHung() ) {
+            if (!waitingHung)
+                asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s': a wrapper call is hung, the reinitialization waits for it to return\n", \
+                    this->driverName_.c_str(), this->portName_.c_str());
+            waitingHung = true;
+        } else if ( ( fails > allowed_fails ) || scheduler.isQuarantined() ) {
+            waitingHung = false;
+            asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
+                "Driver '%s', Port '%s': reinitializing hardware connection\n", \
+                this->driverName_.c_str(), this->portName_.c_str());
+            EVENT_TRACE_BEGIN("lock", "connMon lock wait", 0);
+            this->lock();
+            EVENT_TRACE_END("lock", "connMon lock wait", 0);
+            EVENT_TRACE_BEGIN("conn", "reinitialize", reconnects.load());
+            // If the reinitialization hangs, it is retried after it returns
+            bool error = true;
+            while ( error && ( !scheduler.isHung() ) ) {
+                try {
+                    // Run the reinitialization through the scheduler, so that no other
+                    // wrapper call can be executed in the mean time.
+                    scheduler.run(WrapperScheduler::Safety, [this]() { this->crate->ReinitSystem(); });
+                    error = false;
+                } catch (const std::runtime_error& err) {
+                    asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+                        "Driver %s, Port %s: Failed to reinitialize hardware connection. Trying again in %f seconds.\n",
+                        this->driverName_.c_str(), this->portName_.c_str(), sleep_after_fail);
+                    // Let the other threads fail fast, instead of waiting for the lock
+                    this->unlock();
+                    epicsThreadSleep(sleep_after_fail);
+                    this->lock();
+                }
+            }
+            if (!error) {
+                epicsAtomicSetIntT(&this->failed_gets, 0);
+                scheduler.clearQuarantine();
+                ++reconnects;
+                // The names may have changed while the crate was not reachable
+                for (std::vector<ChNameEntry>::iterator it = chNameList.begin(); it != chNameList.end(); ++it)
+                    refreshChNames(*it);
+            }
+            EVENT_TRACE_END("conn", "reinitialize", reconnects.load());
+            this->unlock();
+            if (!error)
+                asynPrint(pasynUserSelf, ASYN_TRACE_FLOW, \
+                    "Driver '%s', Port '%s': finished reinitializing hardware connection\n", \
+                    this->driverName_.c_str(), this->portName_.c_str());
+        }
+
+        epicsThreadSleep(monitor_thread_sleep);
+        ++count;
+
+    }
+
+}
+
+////////////////////////////////////////////
+// Methods overridden from asynPortDriver //
+////////////////////////////////////////////
+asynStatus CAENHVAsyn::readInt32(asynUser *pasynUser, epicsInt32 *value)
+{
+    static const char method[] = "readInt32";
+    EVENT_TRACE_SCOPE("asyn", method, pasynUser->reason);
+    ++ioCount[ReadInt32];
+    int function(pasynUser->reason);
+    int status(0);
+
+    // Iterators
+    std::map< int, SystemPropertyInteger >::iterator spIt;
+
+    // Check if the function is found in out lists
+    bool found = false;
+
+    // Look for the function number in the parameter lists
+    if (function == fail_count_limit || function == allowed_fails_param) {
+        found = true;
+        status = getIntegerParam(function, value);
+    } else if (updateSchedulerParams(function) || updateWrapperStatsParams(function)) {
+        found = true;
+        status = getIntegerParam(function, value);
+    } else {
+        try
+        {
+            if ( ( spIt = systemPropertyIntegerList.find(function) ) != systemPropertyIntegerList.end() )
+            {
+                *value = acquire<epicsInt32>(pasynUser, WrapperScheduler::SlowPoll, [=]() { return spIt->second->getVal(); });
+                setIntegerParam(function, *value);
+                found = true;
+            }
+        }
+        catch(WrapperTimeout& e)
+        {
+            status = asynTimeout;
+            epicsAtomicIncrIntT(&this->failed_gets);
+            asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                        "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : timeout '%s'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), e.what());
+        }
+        catch(std::runtime_error& e)
+        {
+            status = -1;
+            epicsAtomicIncrIntT(&this->failed_gets);
+            asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                        "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), e.what());
+        }
+    }
+
+    // If the function was not found, fall back to the base method
+    if (!found)
+        status = asynPortDriver::readInt32(pasynUser, value);
+
+    // Log status and return
+    if (0 == status)
+    {
+        if (isTraced(pasynUser, ASYN_TRACEIO_DRIVER))
+            asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
+                        "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : read '%d'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), *value);
+
+        updateParamStats(pasynUser, function, true);
+
+        return asynSuccess;
+    }
+    else
+    {
+        updateParamStats(pasynUser, function, false);
+
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while reading, status '%d'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), status);
+
+        return (asynTimeout == status) ? asynTimeout : asynError;
+    }
+}
+
+asynStatus CAENHVAsyn::writeInt32(asynUser *pasynUser, epicsInt32 value)
+{
+    static const char method[] = "writeInt32";
+    EVENT_TRACE_SCOPE("asyn", method, pasynUser->reason);
+    ++ioCount[WriteInt32];
+    int function(pasynUser->reason);
+    int status(0);
+
+    // Iterators
+    std::map< int, SystemPropertyInteger >::iterator spIt;
+
+    // Check if the function is found in out lists
+    bool found = false;
+
+    // Look for the function number in the parameter lists
+    if (function == fail_count_limit || function == allowed_fails_param) {
+        found = true;
+        status = setIntegerParam(function, value);
+    } else if (function == sched_reset_param) {
+        found = true;
+        scheduler.resetStats();
+    } else if (function == wrapper_stats_reset_param) {
+        found = true;
+        wrapperStats->reset();
+    } else if (function == acq_timing_reset_param) {
+        found = true;
+        resetAcqTiming();
+    } else if (selectHistoryChannel(function, value)) {
+        found = true;
+    } else if (armTripCapture(function, value)) {
+        found = true;
+    } else if (function == setpoint_restore_param) {
+        found = true;
+        if (value) {
+            char fileName[256];
+            getStringParam(setpoint_file_param, sizeof(fileName), fileName);
+            if (restoreSetpoints(fileName))
+                status = -1;
+        }
+    } else if (function == ch_name_refresh_param) {
+        found = true;
+        if (value)
+            for (std::vector<ChNameEntry>::iterator it = chNameList.begin(); it != chNameList.end(); ++it)
+                refreshChNames(*it);
+    } else if (function == setpoint_save_param) {
+        found = true;
+        if (value) {
+            char fileName[256];
+            getStringParam(setpoint_file_param, sizeof(fileName), fileName);
+            if (saveSetpoints(fileName))
+                status = -1;
+        }
+    } else {
+        try
+        {
+            if (function == all_off_param)
+            {
+                found = true;
+                if (value)
+                    allChannelsOff();
+            }
+            else if ( ( spIt = systemPropertyIntegerList.find(function) ) != systemPropertyIntegerList.end() )
+            {
+                scheduler.run(WrapperScheduler::Operator, [=]() { spIt->second->setVal(value); });
+                found = true;
+            }
+        }
+        catch(WrapperTimeout& e)
+        {
+            status = asynTimeout;
+            epicsAtomicIncrIntT(&this->failed_gets);
+            asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                        "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : timeout '%s'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), e.what());
+        }
+        catch(std::runtime_error& e)
+        {
+            status = -1;
+            epicsAtomicIncrIntT(&this->failed_gets);
+            asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                        "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), e.what());
+        }
+    }
+
+    // If the function was not found, fall back to the base method
+    if (!found)
+        status = asynPortDriver::writeInt32(pasynUser, value);
+
+    // Log status and return
+    if (0 == status)
+    {
+        if (isTraced(pasynUser, ASYN_TRACEIO_DRIVER))
+            asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
+                        "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : set to '%d'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), value);
+
+        updateParamStats(pasynUser, function, true);
+
+        return asynSuccess;
+    }
+    else
+    {
+        updateParamStats(pasynUser, function, false);
+
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while writting '%d', status '%d'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), value, status);
+
+        return (asynTimeout == status) ? asynTimeout : asynError;
+    }
+}
+
+asynStatus CAENHVAsyn::readFloat64Array(asynUser *pasynUser, epicsFloat64 *value, size_t nElements, size_t *nIn)
+{
+    EVENT_TRACE_SCOPE("asyn", "readFloat64Array", pasynUser->reason);
+    int function(pasynUser->reason);
+
+    // Windowed statistics of a board
+    const std::vector<epicsFloat64>* sv;
+    const StatsEntry* st = findStats(function, &sv);
+    if (st) {
+        *nIn = std::min(nElements, sv->size());
+        std::copy(sv->begin(), sv->begin() + *nIn, value);
+        pasynUser->timestamp = st->stamp;
+
+        return asynSuccess;
+    }
+
+    // Trip snapshot of a board
+    const TripEntry* t = findTrip(function);
+    if (t) {
+        const std::vector<epicsFloat64>& v = ( function == t->vmon_param ) ? t->snapshot.block.vMon : ( function == t->imon_param ) ? t->snapshot.block.iMon : t->snapshot.time;
+        *nIn = std::min(nElements, v.size());
+        std::copy(v.begin(), v.begin() + *nIn, value);
+        pasynUser->timestamp = t->snapshot.trigger;
+
+        return asynSuccess;
+    }
+
+    // History of the selected channel of a board
+    const HistoryEntry* h = findHistory(function);
+    if (h) {
+        const std::vector<epicsFloat64>& v = ( function == h->vmon_param ) ? h->trace.vMon : ( function == h->imon_param ) ? h->trace.iMon : h->trace.time;
+        *nIn = std::min(nElements, v.size());
+        std::copy(v.begin(), v.begin() + *nIn, value);
+        pasynUser->timestamp = h->trace.last;
+
+        return asynSuccess;
+    }
+
+    // Per-board arrays of channel values. They are only available from the
+    // snapshots, so the batched acquisition must be enabled.
+    std::map<int, BoardArrayEntry>::const_iterator it = boardFloatArrayList.find(function);
+    if (it == boardFloatArrayList.end())
+        return asynPortDriver::readFloat64Array(pasynUser, value, nElements, nIn);
+
+    BoardSnapshotData d;
+    it->second.board->getSnapshot().read(d);
+
+    if ( (!d.valid) || isStale(d.stamp) )
+        return asynError;
+
+    std::vector<float>::const_iterator first = d.chFloats.begin() + it->second.index * d.numChannels;
+    *nIn = std::min(nElements, d.numChannels);
+    std::copy(first, first + *nIn, value);
+    pasynUser->timestamp = d.stamp;
+
+    return asynSuccess;
+}
+
+asynStatus CAENHVAsyn::readInt32Array(asynUser *pasynUser, epicsInt32 *value, size_t nElements, size_t *nIn)
+{
+    EVENT_TRACE_SCOPE("asyn", "readInt32Array", pasynUser->reason);
+    int function(pasynUser->reason);
+
+    // Trip snapshot of a board
+    const TripEntry* t = findTrip(function);
+    if ( t && ( function == t->status_param ) ) {
+        *nIn = std::min(nElements, t->snapshot.block.status.size());
+        std::copy(t->snapshot.block.status.begin(), t->snapshot.block.status.begin() + *nIn, value);
+        pasynUser->timestamp = t->snapshot.trigger;
+
+        return asynSuccess;
+    }
+
+    // History of the selected channel of a board
+    const HistoryEntry* h = findHistory(function);
+    if ( h && ( function == h->status_param ) ) {
+        *nIn = std::min(nElements, h->trace.status.size());
+        std::copy(h->trace.status.begin(), h->trace.status.begin() + *nIn, value);
+        pasynUser->timestamp = h->trace.last;
+
+        return asynSuccess;
+    }
+
+    // Per-board arrays of channel status words, from the snapshots
+    std::map<int, BoardArrayEntry>::const_iterator aIt = boardStatusArrayList.find(function);
+    if (aIt != boardStatusArrayList.end()) {
+        BoardSnapshotData d;
+        aIt->second.board->getSnapshot().read(d);
+
+        if ( (!d.valid) || isStale(d.stamp) )
+            return asynError;
+
+        std::vector<uint32_t>::const_iterator first = d.chWords.begin() + aIt->second.index * d.numChannels;
+        *nIn = std::min(nElements, d.numChannels);
+        std::copy(first, first + *nIn, value);
+        pasynUser->timestamp = d.stamp;
+
+        return asynSuccess;
+    }
+
+    // Wrapper call histograms
+    std::map<int, WrapperStatsEntry>::const_iterator it = wrapperStatsParamList.find(function);
+    if ( ( it == wrapperStatsParamList.end() ) || ( it->second.kind != WrapperStatsEntry::Hist ) )
+        return asynPortDriver::readInt32Array(pasynUser, value, nElements, nIn);
+
+    WrapperStats::Summary s = getWrapperStats(it->second);
+
+    *nIn = std::min(nElements, s.buckets.size());
+    std::copy(s.buckets.begin(), s.buckets.begin() + *nIn, value);
+
+    return asynSuccess;
+}
+
+asynStatus CAENHVAsyn::readFloat64(asynUser *pasynUser, epicsFloat64 *value)
+{
+    static const char method[] = "readFloat64";
+    EVENT_TRACE_SCOPE("asyn", method, pasynUser->reason);
+    ++ioCount[ReadFloat64];
+    int function(pasynUser->reason);
+    int status(0);
 
     // Iterators
     std::map< int, ChannelParameterNumeric >::iterator cpIt;
@@ -685,7 +3239,13 @@ asynStatus CAENHVAsyn::readFloat64(asynUser *pasynUser, epicsFloat64 *value)
     bool found = false;
 
     // Look for the function number in the parameter lists
-    if (function == mon_thread_sleep_param || function == conn_fail_sleep) {
+    if (function == mon_thread_sleep_param || function == conn_fail_sleep || function == acq_period_param || function == wrapper_timeout_param) {
+        found = true;
+        status = (int)getDoubleParam(function, value);
+    } else if (readSnapshot(pasynUser, function, value)) {
+        found = true;
+        setDoubleParam(function, *value);
+    } else if (updateSchedulerParams(function) || updateWrapperStatsParams(function)) {
         found = true;
         status = (int)getDoubleParam(function, value);
     } else {
@@ -693,27 +3253,38 @@ asynStatus CAENHVAsyn::readFloat64(asynUser *pasynUser, epicsFloat64 *value)
         {
             if ( ( cpIt = channelParameterNumericList.find(function) ) != channelParameterNumericList.end() )
             {
-                *value = cpIt->second->getVal();
+                *value = acquire<epicsFloat64>(pasynUser, getPollPriority(cpIt->second->getMode()), [=]() { return cpIt->second->getVal(); });
+                setDoubleParam(function, *value);
                 found = true;
             }
             else if ( ( bpIt = boardParameterNumericList.find(function) ) != boardParameterNumericList.end() )
             {
-                *value = bpIt->second->getVal();
+                *value = acquire<epicsFloat64>(pasynUser, getPollPriority(bpIt->second->getMode()), [=]() { return bpIt->second->getVal(); });
+                setDoubleParam(function, *value);
                 found = true;
             }
             else if ( ( spIt = systemPropertyFloatList.find(function) ) != systemPropertyFloatList.end() )
             {
-                *value = spIt->second->getVal();
+                *value = acquire<epicsFloat64>(pasynUser, WrapperScheduler::SlowPoll, [=]() { return spIt->second->getVal(); });
+                setDoubleParam(function, *value);
                 found = true;
             }
         }
+        catch(WrapperTimeout& e)
+        {
+            status = asynTimeout;
+            epicsAtomicIncrIntT(&this->failed_gets);
+            asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                        "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : timeout '%s'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), e.what());
+        }
         catch(std::runtime_error& e)
         {
             status = -1;
             epicsAtomicIncrIntT(&this->failed_gets);
             asynPrint(pasynUser, ASYN_TRACE_ERROR, \
                         "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
-                        this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, e.what());
+                        this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), e.what());
         }
     }
 
@@ -724,33 +3295,34 @@ asynStatus CAENHVAsyn::readFloat64(asynUser *pasynUser, epicsFloat64 *value)
     // Log status and return
     if (0 == status)
     {
-        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : read '%f'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, *value);
+        if (isTraced(pasynUser, ASYN_TRACEIO_DRIVER))
+            asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
+                        "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : read '%f'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), *value);
+
+        updateParamStats(pasynUser, function, true);
 
         return asynSuccess;
     }
     else
     {
+        updateParamStats(pasynUser, function, false);
+
         asynPrint(pasynUser, ASYN_TRACE_ERROR, \
                     "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while reading, status '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, status);
+                    this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), status);
 
-        return asynError;
+        return (asynTimeout == status) ? asynTimeout : asynError;
     }
 }
 
 asynStatus CAENHVAsyn::writeFloat64(asynUser *pasynUser, epicsFloat64 value)
 {
-    static std::string method("writeFloat64");
+    static const char method[] = "writeFloat64";
+    EVENT_TRACE_SCOPE("asyn", method, pasynUser->reason);
+    ++ioCount[WriteFloat64];
     int function(pasynUser->reason);
-    int status(0);
-
-    int addr;
-    this->getAddress(pasynUser, &addr);
-
-    const char *name;
-    getParamName(addr, function, &name);
+    int status(0);
 
     // Iterators
     std::map< int, ChannelParameterNumeric >::iterator cpIt;
@@ -764,35 +3336,60 @@ asynStatus CAENHVAsyn::writeFloat64(asynUser *pasynUser, epicsFloat64 value)
     if (function == mon_thread_sleep_param || function == conn_fail_sleep) {
         found = true;
         status = setDoubleParam(function, value);
+    } else if (function == wrapper_timeout_param) {
+        found = true;
+        if (value < 0)
+            value = 0;
+        scheduler.setTimeout(value);
+        status = setDoubleParam(function, value);
+    } else if (function == acq_period_param) {
+        found = true;
+        if (value < 0)
+            value = 0;
+        acqPeriod.store(value);
+        epicsEventSignal(acqWakeUp);
+        status = setDoubleParam(function, value);
     } else {
         try
         {
             if ( ( cpIt = channelParameterNumericList.find(function) ) != channelParameterNumericList.end() )
             {
-                cpIt->second->setVal(value);
+                scheduler.run(WrapperScheduler::Operator, [=]() { cpIt->second->setVal(value); });
                 found = true;
             }
             else if ( ( bpIt = boardParameterNumericList.find(function) ) != boardParameterNumericList.end() )
             {
-                bpIt->second->setVal(value);
+                scheduler.run(WrapperScheduler::Operator, [=]() { bpIt->second->setVal(value); });
                 found = true;
             }
             else if ( ( spIt = systemPropertyFloatList.find(function) ) != systemPropertyFloatList.end() )
             {
-                spIt->second->setVal(value);
+                scheduler.run(WrapperScheduler::Operator, [=]() { spIt->second->setVal(value); });
                 found = true;
             }
         }
+        catch(WrapperTimeout& e)
+        {
+            status = asynTimeout;
+            epicsAtomicIncrIntT(&this->failed_gets);
+            asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                        "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : timeout '%s'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), e.what());
+        }
         catch(std::runtime_error& e)
         {
             status = -1;
             epicsAtomicIncrIntT(&this->failed_gets);
             asynPrint(pasynUser, ASYN_TRACE_ERROR, \
                         "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
-                        this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, e.what());
+                        this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), e.what());
         }
     }
 
+    // Refresh the snapshots right away, so the readbacks follow the write
+    if ( ( 0 == status ) && snapshotParamList.count(function) )
+        epicsEventSignal(acqWakeUp);
+
     // If the function was not found, fall back to the base method
     if (!found)
         status = asynPortDriver::writeFloat64(pasynUser, value);
@@ -800,34 +3397,35 @@ asynStatus CAENHVAsyn::writeFloat64(asynUser *pasynUser, epicsFloat64 value)
     // Log status and return
     if (0 == status)
     {
-        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : set to '%f'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, value);
+        if (isTraced(pasynUser, ASYN_TRACEIO_DRIVER))
+            asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
+                        "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : set to '%f'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), value);
+
+        updateParamStats(pasynUser, function, true);
 
         return asynSuccess;
     }
     else
     {
+        updateParamStats(pasynUser, function, false);
+
         asynPrint(pasynUser, ASYN_TRACE_ERROR, \
                     "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while writting '%f', status '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, value, status);
+                    this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), value, status);
 
-        return asynError;
+        return (asynTimeout == status) ? asynTimeout : asynError;
     }
 }
 
 asynStatus CAENHVAsyn::readUInt32Digital(asynUser *pasynUser, epicsUInt32 *value, epicsUInt32 mask)
 {
-    static std::string method("readUInt32Digital");
+    static const char method[] = "readUInt32Digital";
+    EVENT_TRACE_SCOPE("asyn", method, pasynUser->reason);
+    ++ioCount[ReadUInt32Digital];
     int function(pasynUser->reason);
     int status(0);
 
-    int addr;
-    this->getAddress(pasynUser, &addr);
-
-    const char *name;
-    getParamName(addr, function, &name);
-
     // Iterators
     std::map< int, BoardParameterOnOff      >::iterator bpoIt;
     std::map< int, BoardParameterChStatus   >::iterator bpcsIt;
@@ -838,53 +3436,82 @@ asynStatus CAENHVAsyn::readUInt32Digital(asynUser *pasynUser, epicsUInt32 *value
     // Check if the function is found in out lists
     bool found = false;
 
-    // Look for the function number in the parameter lists
-    try
+    // Serve the value from the board snapshots if possible
+    epicsUInt32 snap;
+    if (readSnapshot(pasynUser, function, &snap))
     {
-        if ( ( bpoIt = boardParameterOnOffList.find(function) ) != boardParameterOnOffList.end() )
-        {
-           uint32_t temp = bpoIt->second->getVal();
-           temp &= mask;
-           *value = temp;
-           found = true;
-        }
-        else if ( ( bpcsIt = boardParameterChStatusList.find(function) ) != boardParameterChStatusList.end() )
-        {
-           uint32_t temp = bpcsIt->second->getVal();
-           temp &= mask;
-           *value = temp;
-           found = true;
-        }
-        else if ( ( bpbsIt = boardParameterBdStatusList.find(function) ) != boardParameterBdStatusList.end() )
+        setUIntDigitalParam(function, snap, 0xFFFFFFFF);
+        *value = snap & mask;
+        found = true;
+    }
+    else
+    {
+        // Look for the function number in the parameter lists
+        try
         {
-           uint32_t temp = bpbsIt->second->getVal();
-           temp &= mask;
-           *value = temp;
-           found = true;
+            if ( ( bpoIt = boardParameterOnOffList.find(function) ) != boardParameterOnOffList.end() )
+            {
+               uint32_t temp;
+               temp = acquire<uint32_t>(pasynUser, getPollPriority(bpoIt->second->getMode()), [=]() { return bpoIt->second->getVal(); });
+               setUIntDigitalParam(function, temp, 0xFFFFFFFF);
+               temp &= mask;
+               *value = temp;
+               found = true;
+            }
+            else if ( ( bpcsIt = boardParameterChStatusList.find(function) ) != boardParameterChStatusList.end() )
+            {
+               uint32_t temp;
+               temp = acquire<uint32_t>(pasynUser, getPollPriority(bpcsIt->second->getMode()), [=]() { return bpcsIt->second->getVal(); });
+               setUIntDigitalParam(function, temp, 0xFFFFFFFF);
+               temp &= mask;
+               *value = temp;
+               found = true;
+            }
+            else if ( ( bpbsIt = boardParameterBdStatusList.find(function) ) != boardParameterBdStatusList.end() )
+            {
+               uint32_t temp;
+               temp = acquire<uint32_t>(pasynUser, getPollPriority(bpbsIt->second->getMode()), [=]() { return bpbsIt->second->getVal(); });
+               setUIntDigitalParam(function, temp, 0xFFFFFFFF);
+               temp &= mask;
+               *value = temp;
+               found = true;
+            }
+            else if ( ( cpoIt = channelParameterOnOffList.find(function) ) != channelParameterOnOffList.end() )
+            {
+               uint32_t temp;
+               temp = acquire<uint32_t>(pasynUser, getPollPriority(cpoIt->second->getMode()), [=]() { return cpoIt->second->getVal(); });
+               setUIntDigitalParam(function, temp, 0xFFFFFFFF);
+               temp &= mask;
+               *value = temp;
+               found = true;
+            }
+            else if ( ( cpcsIt = channelParameterChStatusList.find(function) ) != channelParameterChStatusList.end() )
+            {
+               uint32_t temp;
+               temp = acquire<uint32_t>(pasynUser, getPollPriority(cpcsIt->second->getMode()), [=]() { return cpcsIt->second->getVal(); });
+               setUIntDigitalParam(function, temp, 0xFFFFFFFF);
+               temp &= mask;
+               *value = temp;
+               found = true;
+            }
         }
-        else if ( ( cpoIt = channelParameterOnOffList.find(function) ) != channelParameterOnOffList.end() )
+        catch(WrapperTimeout& e)
         {
-           uint32_t temp = cpoIt->second->getVal();
-           temp &= mask;
-           *value = temp;
-           found = true;
+            status = asynTimeout;
+            epicsAtomicIncrIntT(&this->failed_gets);
+            asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                        "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : timeout '%s'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), e.what());
         }
-        else if ( ( cpcsIt = channelParameterChStatusList.find(function) ) != channelParameterChStatusList.end() )
+        catch(std::runtime_error& e)
         {
-           uint32_t temp = cpcsIt->second->getVal();
-           temp &= mask;
-           *value = temp;
-           found = true;
+            status = -1;
+            epicsAtomicIncrIntT(&this->failed_gets);
+            asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                        "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), e.what());
         }
     }
-    catch(std::runtime_error& e)
-    {
-        status = -1;
-        epicsAtomicIncrIntT(&this->failed_gets);
-        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, e.what());
-    }
 
     // If the function was not found, fall back to the base method
     if (!found)
@@ -893,35 +3520,36 @@ asynStatus CAENHVAsyn::readUInt32Digital(asynUser *pasynUser, epicsUInt32 *value
     // Log status and return
     if (0 == status)
     {
-        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : read '%d', mask '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, *value, mask);
+        if (isTraced(pasynUser, ASYN_TRACEIO_DRIVER))
+            asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
+                        "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : read '%d', mask '%d'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), *value, mask);
+
+        updateParamStats(pasynUser, function, true);
 
         return asynSuccess;
     }
     else
     {
+        updateParamStats(pasynUser, function, false);
+
         asynPrint(pasynUser, ASYN_TRACE_ERROR, \
                     "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while reading, mask '%d', status '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, mask, status);
+                    this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), mask, status);
 
-        return asynError;
+        return (asynTimeout == status) ? asynTimeout : asynError;
     }
 }
 
 
 asynStatus CAENHVAsyn::writeUInt32Digital(asynUser *pasynUser, epicsUInt32 value, epicsUInt32 mask)
 {
-    static std::string method("writeUInt32Digital");
+    static const char method[] = "writeUInt32Digital";
+    EVENT_TRACE_SCOPE("asyn", method, pasynUser->reason);
+    ++ioCount[WriteUInt32Digital];
     int function(pasynUser->reason);
     int status(0);
 
-    int addr;
-    this->getAddress(pasynUser, &addr);
-
-    const char *name;
-    getParamName(addr, function, &name);
-
     epicsUInt32 val(0);
     val &= ~mask;
     val |= value;
@@ -941,39 +3569,56 @@ asynStatus CAENHVAsyn::writeUInt32Digital(asynUser *pasynUser, epicsUInt32 value
     {
         if ( ( bpoIt = boardParameterOnOffList.find(function) ) != boardParameterOnOffList.end() )
         {
-            bpoIt->second->setVal(val);
+            scheduler.run(WrapperScheduler::Operator, [=]() { bpoIt->second->setVal(val); });
             found = true;
         }
         else if ( ( bpcsIt = boardParameterChStatusList.find(function) ) != boardParameterChStatusList.end() )
         {
-            bpcsIt->second->setVal(val);
+            scheduler.run(WrapperScheduler::Operator, [=]() { bpcsIt->second->setVal(val); });
             found = true;
         }
         else if ( ( bpbsIt = boardParameterBdStatusList.find(function) ) != boardParameterBdStatusList.end() )
         {
-            bpbsIt->second->setVal(val);
+            scheduler.run(WrapperScheduler::Operator, [=]() { bpbsIt->second->setVal(val); });
             found = true;
         }
         else if ( ( cpoIt = channelParameterOnOffList.find(function) ) != channelParameterOnOffList.end() )
         {
-            cpoIt->second->setVal(val);
+            // Turning a channel OFF is a safety action, so it goes ahead of everything else
+            WrapperScheduler::Priority p = WrapperScheduler::Operator;
+            if ( ( !cpoIt->second->getParam().compare("Pw") ) && ( val == 0 ) )
+                p = WrapperScheduler::Safety;
+
+            scheduler.run(p, [=]() { cpoIt->second->setVal(val); });
             found = true;
         }
         else if ( ( cpcsIt = channelParameterChStatusList.find(function) ) != channelParameterChStatusList.end() )
         {
-            cpcsIt->second->setVal(val);
+            scheduler.run(WrapperScheduler::Operator, [=]() { cpcsIt->second->setVal(val); });
             found = true;
         }
     }
+    catch(WrapperTimeout& e)
+    {
+        status = asynTimeout;
+        epicsAtomicIncrIntT(&this->failed_gets);
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : timeout '%s'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), e.what());
+    }
     catch(std::runtime_error& e)
     {
         status = -1;
         epicsAtomicIncrIntT(&this->failed_gets);
         asynPrint(pasynUser, ASYN_TRACE_ERROR, \
                     "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, e.what());
+                    this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), e.what());
     }
 
+    // Refresh the snapshots right away, so the readbacks follow the write
+    if ( ( 0 == status ) && snapshotParamList.count(function) )
+        epicsEventSignal(acqWakeUp);
+
     // If the function was not found, fall back to the base method
     if (!found)
         status = asynPortDriver::writeUInt32Digital(pasynUser, value, mask);
@@ -981,34 +3626,35 @@ asynStatus CAENHVAsyn::writeUInt32Digital(asynUser *pasynUser, epicsUInt32 value
     // Log status and return
     if (0 == status)
     {
-        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : set to '%d', mask '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, value, mask);
+        if (isTraced(pasynUser, ASYN_TRACEIO_DRIVER))
+            asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
+                        "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : set to '%d', mask '%d'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), value, mask);
+
+        updateParamStats(pasynUser, function, true);
 
         return asynSuccess;
     }
     else
     {
+        updateParamStats(pasynUser, function, false);
+
         asynPrint(pasynUser, ASYN_TRACE_ERROR, \
                     "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while writting '%d', mask '%d', status '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, value, mask, status);
+                    this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), value, mask, status);
 
-        return asynError;
+        return (asynTimeout == status) ? asynTimeout : asynError;
     }
 }
 
 asynStatus CAENHVAsyn::readOctet(asynUser *pasynUser, char *value, size_t maxChars, size_t *nActual, int *eomReason)
 {
-    static std::string method("readOctet");
+    static const char method[] = "readOctet";
+    EVENT_TRACE_SCOPE("asyn", method, pasynUser->reason);
+    ++ioCount[ReadOctet];
     int function(pasynUser->reason);
     int status(0);
 
-    int addr;
-    this->getAddress(pasynUser, &addr);
-
-    const char *name;
-    getParamName(addr, function, &name);
-
     // Iterators
     std::map< int, SystemPropertyString >::iterator spIt;
 
@@ -1020,19 +3666,29 @@ asynStatus CAENHVAsyn::readOctet(asynUser *pasynUser, char *value, size_t maxCha
     {
         if ( ( spIt = systemPropertyStringList.find(function) ) != systemPropertyStringList.end() )
         {
-            std::string temp = spIt->second->getVal();
+            std::string temp;
+            temp = acquire<std::string>(pasynUser, WrapperScheduler::SlowPoll, [=]() { return spIt->second->getVal(); });
+            setStringParam(function, temp.c_str());
             strcpy(value, temp.c_str());
             *nActual = temp.length() + 1;
             found = true;
         }
     }
+    catch(WrapperTimeout& e)
+    {
+        status = asynTimeout;
+        epicsAtomicIncrIntT(&this->failed_gets);
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : timeout '%s'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), e.what());
+    }
     catch(std::runtime_error& e)
     {
         status = -1;
         epicsAtomicIncrIntT(&this->failed_gets);
         asynPrint(pasynUser, ASYN_TRACE_ERROR, \
                     "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, e.what());
+                    this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), e.what());
     }
 
     // If the function was not found, fall back to the base method
@@ -1042,37 +3698,42 @@ asynStatus CAENHVAsyn::readOctet(asynUser *pasynUser, char *value, size_t maxCha
     // Log status and return
     if (0 == status)
     {
-        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : read '%s', maxChars '%zu', nActual '%zu'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, value, maxChars, *nActual);
+        if (isTraced(pasynUser, ASYN_TRACEIO_DRIVER))
+            asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
+                        "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : read '%s', maxChars '%zu', nActual '%zu'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), value, maxChars, *nActual);
+
+        updateParamStats(pasynUser, function, true);
 
         return asynSuccess;
     }
     else
     {
+        updateParamStats(pasynUser, function, false);
+
         asynPrint(pasynUser, ASYN_TRACE_ERROR, \
                     "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while reading, maxChars '%zu', status '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, maxChars, status);
+                    this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), maxChars, status);
 
-        return asynError;
+        return (asynTimeout == status) ? asynTimeout : asynError;
     }
 }
 
 asynStatus CAENHVAsyn::writeOctet(asynUser *pasynUser, const char *value, size_t maxChars, size_t *nActual)
 {
-    static std::string method("writeOctet");
+    static const char method[] = "writeOctet";
+    EVENT_TRACE_SCOPE("asyn", method, pasynUser->reason);
+    ++ioCount[WriteOctet];
     int function(pasynUser->reason);
     int status(0);
 
-    int addr;
-    this->getAddress(pasynUser, &addr);
-
-    const char *name;
-    getParamName(addr, function, &name);
-
     // Iterators
     std::map< int, SystemPropertyString >::iterator spIt;
 
+    // Channel names
+    ChNameEntry* chName;
+    int channel;
+
     // Check if the function is found in out lists
     bool found = false;
 
@@ -1083,17 +3744,40 @@ asynStatus CAENHVAsyn::writeOctet(asynUser *pasynUser, const char *value, size_t
         {
             found = true;
             std::string temp(value);
-            spIt->second->setVal(temp);
+            scheduler.run(WrapperScheduler::Operator, [=]() { spIt->second->setVal(temp); });
+            *nActual = temp.size();
+        }
+        else if ( ( chName = findChName(function, channel) ) )
+        {
+            found = true;
+            std::string temp(value, strnlen(value, maxChars));
+            writeChNames(*chName, channel, temp);
             *nActual = temp.size();
         }
     }
+    catch(WrapperTimeout& e)
+    {
+        status = asynTimeout;
+        epicsAtomicIncrIntT(&this->failed_gets);
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : timeout '%s'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), e.what());
+    }
     catch(std::runtime_error& e)
     {
         status = -1;
         epicsAtomicIncrIntT(&this->failed_gets);
         asynPrint(pasynUser, ASYN_TRACE_ERROR, \
                     "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, e.what());
+                    this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), e.what());
+    }
+    catch(std::invalid_argument& e)
+    {
+        // The value was rejected before any wrapper call, so it is not a failed call
+        status = asynError;
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : invalid value '%s'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), e.what());
     }
 
     // If the function was not found, fall back to the base method
@@ -1103,19 +3787,24 @@ asynStatus CAENHVAsyn::writeOctet(asynUser *pasynUser, const char *value, size_t
     // Log status and return
     if (0 == status)
     {
-        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : set to '%s', maxChars '%zu', nActual '%zu'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, value, maxChars, *nActual);
+        if (isTraced(pasynUser, ASYN_TRACEIO_DRIVER))
+            asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
+                        "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : set to '%s', maxChars '%zu', nActual '%zu'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), value, maxChars, *nActual);
+
+        updateParamStats(pasynUser, function, true);
 
         return asynSuccess;
     }
     else
     {
+        updateParamStats(pasynUser, function, false);
+
         asynPrint(pasynUser, ASYN_TRACE_ERROR, \
                     "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while writting '%s', maxChars '%zu', status '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, value, maxChars, status);
+                    this->driverName_.c_str(), this->portName_.c_str(), method, function, getTraceParamName(pasynUser, function), value, maxChars, status);
 
-        return asynError;
+        return (asynTimeout == status) ? asynTimeout : asynError;
     }
 }
 
@@ -1180,11 +3869,332 @@ static void epicsPrefixCallFunc(const iocshArgBuf *args)
 }
 // - CAENHVAsynSetEpicsPrefix //
 
+// + CAENHVAsynSetTimeStampEvent //
+extern "C" int CAENHVAsynSetTimeStampEvent(int tse)
+{
+    CAENHVAsyn::timeStampEvent = tse;
+
+    return 0;
+}
+
+static const iocshArg timeStampEventArg0 = { "TSE", iocshArgInt };
+
+static const iocshArg * const timeStampEventArgs[] =
+{
+    &timeStampEventArg0
+};
+
+static const iocshFuncDef timeStampEventFuncDef = { "CAENHVAsynSetTimeStampEvent", 1, timeStampEventArgs };
+
+static void timeStampEventCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetTimeStampEvent(args[0].ival);
+}
+// - CAENHVAsynSetTimeStampEvent //
+
+// + CAENHVAsynSetAcqPeriod //
+extern "C" int CAENHVAsynSetAcqPeriod(double period)
+{
+    CAENHVAsyn::defaultAcqPeriod = period;
+
+    return 0;
+}
+
+static const iocshArg acqPeriodArg0 = { "Period", iocshArgDouble };
+
+static const iocshArg * const acqPeriodArgs[] =
+{
+    &acqPeriodArg0
+};
+
+static const iocshFuncDef acqPeriodFuncDef = { "CAENHVAsynSetAcqPeriod", 1, acqPeriodArgs };
+
+static void acqPeriodCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetAcqPeriod(args[0].dval);
+}
+// - CAENHVAsynSetAcqPeriod //
+
+// + CAENHVAsynSetWrapperTimeout //
+extern "C" int CAENHVAsynSetWrapperTimeout(double timeout)
+{
+    CAENHVAsyn::wrapperTimeout = timeout;
+
+    return 0;
+}
+
+static const iocshArg wrapperTimeoutArg0 = { "Timeout", iocshArgDouble };
+
+static const iocshArg * const wrapperTimeoutArgs[] =
+{
+    &wrapperTimeoutArg0
+};
+
+static const iocshFuncDef wrapperTimeoutFuncDef = { "CAENHVAsynSetWrapperTimeout", 1, wrapperTimeoutArgs };
+
+static void wrapperTimeoutCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetWrapperTimeout(args[0].dval);
+}
+// - CAENHVAsynSetWrapperTimeout //
+
+// + CAENHVAsynSetHistoryDepth //
+extern "C" int CAENHVAsynSetHistoryDepth(int depth)
+{
+    CAENHVAsyn::historyDepth = depth;
+
+    return 0;
+}
+
+static const iocshArg historyDepthArg0 = { "Depth", iocshArgInt };
+
+static const iocshArg * const historyDepthArgs[] =
+{
+    &historyDepthArg0
+};
+
+static const iocshFuncDef historyDepthFuncDef = { "CAENHVAsynSetHistoryDepth", 1, historyDepthArgs };
+
+static void historyDepthCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetHistoryDepth(args[0].ival);
+}
+// - CAENHVAsynSetHistoryDepth //
+
+// + CAENHVAsynSetTripCapture //
+extern "C" int CAENHVAsynSetTripCapture(int samples, int postSamples, const char *directory)
+{
+    CAENHVAsyn::tripSamples     = samples;
+    CAENHVAsyn::tripPostSamples = ( postSamples < 0 ) ? 0 : postSamples;
+    CAENHVAsyn::tripDirectory   = ( directory ) ? directory : "";
+
+    return 0;
+}
+
+static const iocshArg tripCaptureArg0 = { "Samples",     iocshArgInt    };
+static const iocshArg tripCaptureArg1 = { "PostSamples", iocshArgInt    };
+static const iocshArg tripCaptureArg2 = { "Directory",   iocshArgString };
+
+static const iocshArg * const tripCaptureArgs[] =
+{
+    &tripCaptureArg0,
+    &tripCaptureArg1,
+    &tripCaptureArg2
+};
+
+static const iocshFuncDef tripCaptureFuncDef = { "CAENHVAsynSetTripCapture", 3, tripCaptureArgs };
+
+static void tripCaptureCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetTripCapture(args[0].ival, args[1].ival, args[2].sval);
+}
+// - CAENHVAsynSetTripCapture //
+
+// + CAENHVAsynSetStatsWindow //
+extern "C" int CAENHVAsynSetStatsWindow(int samples)
+{
+    CAENHVAsyn::statsWindow = samples;
+
+    return 0;
+}
+
+static const iocshArg statsWindowArg0 = { "Samples", iocshArgInt };
+
+static const iocshArg * const statsWindowArgs[] =
+{
+    &statsWindowArg0
+};
+
+static const iocshFuncDef statsWindowFuncDef = { "CAENHVAsynSetStatsWindow", 1, statsWindowArgs };
+
+static void statsWindowCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetStatsWindow(args[0].ival);
+}
+// - CAENHVAsynSetStatsWindow //
+
+// + CAENHVAsynSetDataLog //
+extern "C" int CAENHVAsynSetDataLog(const char *directory, int size)
+{
+    CAENHVAsyn::dataLogDirectory = ( directory ) ? directory : "";
+    CAENHVAsyn::dataLogSize      = size;
+
+    return 0;
+}
+
+static const iocshArg dataLogArg0 = { "Directory", iocshArgString };
+static const iocshArg dataLogArg1 = { "Size (MB)", iocshArgInt    };
+
+static const iocshArg * const dataLogArgs[] =
+{
+    &dataLogArg0,
+    &dataLogArg1
+};
+
+static const iocshFuncDef dataLogFuncDef = { "CAENHVAsynSetDataLog", 2, dataLogArgs };
+
+static void dataLogCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetDataLog(args[0].sval, args[1].ival);
+}
+// - CAENHVAsynSetDataLog //
+
+// + CAENHVAsynRestoreSetpoints //
+extern "C" int CAENHVAsynRestoreSetpoints(const char *portName, const char *fileName)
+{
+    CAENHVAsyn *drv = ( portName ) ? dynamic_cast<CAENHVAsyn*>(static_cast<asynPortDriver*>(findAsynPortDriver(portName))) : NULL;
+    if (!drv) {
+        printf("CAENHVAsynRestoreSetpoints: '%s' is not a CAENHVAsyn port\n", portName ? portName : "");
+        return -1;
+    }
+
+    if ( ( !fileName ) || ( !*fileName ) ) {
+        printf("CAENHVAsynRestoreSetpoints: no file name given\n");
+        return -1;
+    }
+
+    epicsTimeStamp start, end;
+    epicsTimeGetCurrent(&start);
+
+    drv->lock();
+    int failed = drv->restoreSetpoints(fileName);
+    drv->unlock();
+
+    epicsTimeGetCurrent(&end);
+
+    if (failed < 0)
+        printf("CAENHVAsynRestoreSetpoints: '%s' could not be read\n", fileName);
+    else
+        printf("CAENHVAsynRestoreSetpoints: '%s' restored in %.3f ms, %d setpoints failed\n",
+            fileName, epicsTimeDiffInSeconds(&end, &start) * 1000.0, failed);
+
+    return failed;
+}
+
+static const iocshArg restoreSetpointsArg0 = { "PortName", iocshArgString };
+static const iocshArg restoreSetpointsArg1 = { "FileName", iocshArgString };
+
+static const iocshArg * const restoreSetpointsArgs[] =
+{
+    &restoreSetpointsArg0,
+    &restoreSetpointsArg1
+};
+
+static const iocshFuncDef restoreSetpointsFuncDef = { "CAENHVAsynRestoreSetpoints", 2, restoreSetpointsArgs };
+
+static void restoreSetpointsCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynRestoreSetpoints(args[0].sval, args[1].sval);
+}
+// - CAENHVAsynRestoreSetpoints //
+
+// + CAENHVAsynSaveSetpoints //
+extern "C" int CAENHVAsynSaveSetpoints(const char *portName, const char *fileName)
+{
+    CAENHVAsyn *drv = ( portName ) ? dynamic_cast<CAENHVAsyn*>(static_cast<asynPortDriver*>(findAsynPortDriver(portName))) : NULL;
+    if (!drv) {
+        printf("CAENHVAsynSaveSetpoints: '%s' is not a CAENHVAsyn port\n", portName ? portName : "");
+        return -1;
+    }
+
+    if ( ( !fileName ) || ( !*fileName ) ) {
+        printf("CAENHVAsynSaveSetpoints: no file name given\n");
+        return -1;
+    }
+
+    epicsTimeStamp start, end;
+    epicsTimeGetCurrent(&start);
+
+    drv->lock();
+    int failed = drv->saveSetpoints(fileName);
+    drv->unlock();
+
+    epicsTimeGetCurrent(&end);
+
+    if (failed < 0)
+        printf("CAENHVAsynSaveSetpoints: '%s' could not be written\n", fileName);
+    else
+        printf("CAENHVAsynSaveSetpoints: '%s' saved in %.3f ms, %d boards could not be read\n",
+            fileName, epicsTimeDiffInSeconds(&end, &start) * 1000.0, failed);
+
+    return failed;
+}
+
+static const iocshArg saveSetpointsArg0 = { "PortName", iocshArgString };
+static const iocshArg saveSetpointsArg1 = { "FileName", iocshArgString };
+
+static const iocshArg * const saveSetpointsArgs[] =
+{
+    &saveSetpointsArg0,
+    &saveSetpointsArg1
+};
+
+static const iocshFuncDef saveSetpointsFuncDef = { "CAENHVAsynSaveSetpoints", 2, saveSetpointsArgs };
+
+static void saveSetpointsCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSaveSetpoints(args[0].sval, args[1].sval);
+}
+// - CAENHVAsynSaveSetpoints //
+
+// + CAENHVAsynDumpEventTrace //
+extern "C" int CAENHVAsynDumpEventTrace(const char *fileName)
+{
+    if (!EventTrace::isEnabled())
+    {
+        printf("The event trace is not enabled. Build the module with CAENHVASYN_EVENT_TRACE=YES\n");
+        return 1;
+    }
+
+    if ( ( ! fileName ) || ( fileName[0] == '\0' ) )
+    {
+        printf("Usage: CAENHVAsynDumpEventTrace fileName\n");
+        return 1;
+    }
+
+    std::ofstream file(fileName);
+    if (!file.is_open())
+    {
+        printf("Failed to open '%s'\n", fileName);
+        return 1;
+    }
+
+    std::size_t count = EventTrace::dump(file);
+    printf("%zu events written to '%s'\n", count, fileName);
+
+    return 0;
+}
+
+static const iocshArg dumpEventTraceArg0 = { "FileName", iocshArgString };
+
+static const iocshArg * const dumpEventTraceArgs[] =
+{
+    &dumpEventTraceArg0
+};
+
+static const iocshFuncDef dumpEventTraceFuncDef = { "CAENHVAsynDumpEventTrace", 1, dumpEventTraceArgs };
+
+static void dumpEventTraceCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynDumpEventTrace(args[0].sval);
+}
+// - CAENHVAsynDumpEventTrace //
+
 // iocshRegister
 void drvCAENHVAsynRegister(void)
 {
-    iocshRegister( &configFuncDef,      configCallFunc      );
-    iocshRegister( &epicsPrefixFuncDef, epicsPrefixCallFunc );
+    iocshRegister( &configFuncDef,         configCallFunc         );
+    iocshRegister( &epicsPrefixFuncDef,    epicsPrefixCallFunc    );
+    iocshRegister( &timeStampEventFuncDef, timeStampEventCallFunc );
+    iocshRegister( &acqPeriodFuncDef,      acqPeriodCallFunc      );
+    iocshRegister( &wrapperTimeoutFuncDef, wrapperTimeoutCallFunc );
+    iocshRegister( &historyDepthFuncDef,   historyDepthCallFunc   );
+    iocshRegister( &tripCaptureFuncDef,    tripCaptureCallFunc    );
+    iocshRegister( &statsWindowFuncDef,    statsWindowCallFunc    );
+    iocshRegister( &dataLogFuncDef,        dataLogCallFunc        );
+    iocshRegister( &restoreSetpointsFuncDef, restoreSetpointsCallFunc );
+    iocshRegister( &saveSetpointsFuncDef,    saveSetpointsCallFunc    );
+    iocshRegister( &dumpEventTraceFuncDef, dumpEventTraceCallFunc );
 }
 
 extern "C"
@@ -27,10 +27,12 @@
 #include <stdexcept>
 #include <iomanip>
 #include <bitset>
+#include <algorithm>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <map>
+#include <atomic>
 #include <utility>
 #include <iostream>
 #include <fstream>
@@ -54,6 +56,12 @@
 #include "CAENHVWrapper.h"
 #include "common.h"
 #include "crate.h"
+#include "wrapper_scheduler.h"
+#include "event_trace.h"
+#include "board_history.h"
+#include "trip_snapshot.h"
+#include "data_log.h"
+#include "setpoint_file.h"
 
 #define MAX_SIGNALS (3)
 #define NUM_PARAMS (1500)
@@ -112,6 +120,36 @@ statusRecordMap_t recordFieldBdParamBdStatus =
     { 0x020, std::pair<std::string,std::string>( "_OT",   "Bd is in over-temperature status"   ) },
 };
 
+// Wrapper call statistics reported by an asyn parameter: a function or a
+// slot (WrapperStats::NoSlot for the calls not related to a board)
+struct WrapperStatsEntry
+{
+    enum Kind { Hist, Count, Mean, P99 };
+
+    Kind        kind;
+    bool        perSlot;
+    std::size_t index;
+};
+
+// Per-board array of the values of a channel parameter, for all the
+// channels, at position 'index' of the board snapshot
+struct BoardArrayEntry
+{
+    Board       board;
+    std::size_t index;
+};
+
+// Location of an asyn parameter in the board snapshots
+struct SnapshotEntry
+{
+    enum Kind { ChFloat, ChWord, BdFloat, BdWord };
+
+    Board       board;
+    Kind        kind;
+    std::size_t index;
+    std::size_t channel;
+};
+
 class CAENHVAsyn : public asynPortDriver
 {
     public:
@@ -126,14 +164,54 @@ class CAENHVAsyn : public asynPortDriver
         virtual asynStatus writeOctet         (asynUser *pasynUser, const char *value, size_t maxChars, size_t *nActual);
         virtual asynStatus readInt32          (asynUser *pasynUser, epicsInt32 *value);
         virtual asynStatus writeInt32         (asynUser *pasynUser, epicsInt32 value);
+        virtual asynStatus readInt32Array     (asynUser *pasynUser, epicsInt32 *value, size_t nElements, size_t *nIn);
+        virtual asynStatus readFloat64Array   (asynUser *pasynUser, epicsFloat64 *value, size_t nElements, size_t *nIn);
+        virtual void       report             (FILE *fp, int details);
 
         //Connection monitor task to be called inside epicsThread
         void connMon();
 
+        // Acquisition task to be called inside epicsThread
+        void acqLoop();
+
+        // Driver statistics task to be called inside epicsThread
+        void statsLoop();
+
+        // Apply the setpoints in a file, grouped in multi-channel writes. Must
+        // be called with the port locked. Returns the number of setpoints which
+        // could not be applied, or -1 if the file can not be read.
+        int restoreSetpoints(const std::string& fileName);
+
+        // Write the readable setpoints of all the boards to a file, in the
+        // format read by restoreSetpoints. Must be called with the port locked.
+        // Returns the number of boards which could not be read, or -1 if the
+        // file can not be written.
+        int saveSetpoints(const std::string& fileName);
+
         // EPICS record prefix. Use for autogeneration of PVs.
         static std::string epicsPrefix;
         // Crate information output file location
         static std::string crateInfoFilePath;
+        // TSE field used in the auto-generated input records
+        static int timeStampEvent;
+        // Default acquisition period, in seconds. Zero disables the batched acquisition.
+        static double defaultAcqPeriod;
+        // Maximum execution time of each wrapper call, in seconds. Zero means no limit.
+        static double wrapperTimeout;
+        // Number of acquisitions kept in the per-channel history. Zero disables it.
+        static int historyDepth;
+        // Trip snapshots: number of samples, number of them after the trip, and
+        // directory where they are written (none if empty)
+        static int tripSamples;
+        static int tripPostSamples;
+        static std::string tripDirectory;
+
+        // Number of acquisitions in the window of the VMon and IMon statistics
+        static int statsWindow;
+
+        // Data log directory (disabled if empty), and size of the file, in MB
+        static std::string dataLogDirectory;
+        static int dataLogSize;
 
     private:
 
@@ -156,6 +234,280 @@ class CAENHVAsyn : public asynPortDriver
         // Crate object
         Crate crate;
 
+        // All the wrapper calls are serialized, and prioritized, by this scheduler
+        WrapperScheduler scheduler;
+
+        // Scheduler statistics
+        asynStatus createSchedulerParams();
+        bool updateSchedulerParams(int function);
+        int sched_depth_param[WrapperScheduler::NumPriorities];
+        int sched_last_wait_param[WrapperScheduler::NumPriorities];
+        int sched_max_wait_param[WrapperScheduler::NumPriorities];
+        int sched_reset_param;
+        int wrapper_timeout_param;
+        int wrapper_timeouts_param;
+        int wrapper_quarantined_param;
+
+        // Fast crate-wide channel OFF
+        asynStatus createAllOffParams();
+        void allChannelsOff();
+        int all_off_param;
+        int all_off_time_param;
+
+        // Bulk setpoint restore and snapshot
+        asynStatus createSetpointParams();
+        int setpoint_file_param;
+        int setpoint_restore_param;
+        int setpoint_restore_count_param;
+        int setpoint_restore_failed_param;
+        int setpoint_restore_time_param;
+        int setpoint_save_param;
+        int setpoint_save_count_param;
+        int setpoint_save_failed_param;
+        int setpoint_save_time_param;
+
+        // Channel names. They are read with one wrapper call per board when the
+        // driver starts, after they are written, after a reconnection, and on
+        // demand; they are not polled.
+        struct ChNameEntry
+        {
+            Board                    board;
+            std::vector<std::string> names;
+            int                      names_param;    // All the channels, one name per line
+            std::vector<int>         channel_params;
+        };
+        asynStatus createChNameParams();
+        void refreshChNames(ChNameEntry& e);
+        void writeChNames(ChNameEntry& e, int channel, const std::string& value);
+        ChNameEntry* findChName(int function, int& channel);
+        std::vector<ChNameEntry> chNameList; // In the same order as the crate boards
+        int ch_name_refresh_param;
+
+        // Acquisition
+        asynStatus createAcquisitionParams();
+        void createSnapshotMap();
+        bool readSnapshot(asynUser *pasynUser, int function, epicsFloat64 *value);
+        bool readSnapshot(asynUser *pasynUser, int function, epicsUInt32 *value);
+        bool isStale(const epicsTimeStamp& stamp) const;
+        int acq_duration_param;
+        int acq_period_param;
+        std::atomic<double> acqPeriod;
+        epicsEventId acqWakeUp;
+        std::map<int, SnapshotEntry> snapshotParamList;
+
+        // Per-board arrays of channel values, published after each acquisition
+        asynStatus createBoardArrayParams();
+        void publishBoardArrays(const Board& board, const BoardSnapshotData& d);
+        std::map<int, BoardArrayEntry> boardFloatArrayList;  // Numeric channel parameters
+        std::map<int, BoardArrayEntry> boardStatusArrayList; // ChStatus channel parameters
+        std::map<int, BoardArrayEntry> boardStatusWordList;  // BdStatus board parameters, as raw Int32 words
+
+        // Per-channel history of the acquired values. Writing a channel number
+        // to the channel parameter of a board reads the history of that channel
+        // into 'trace', which is then served by the array parameters.
+        struct HistoryEntry
+        {
+            History             history;
+            int                 channel_param;
+            int                 vmon_param;
+            int                 imon_param;
+            int                 status_param;
+            int                 time_param;
+            BoardHistory::Trace trace;
+        };
+        asynStatus createHistoryParams();
+        bool selectHistoryChannel(int function, epicsInt32 channel);
+        const HistoryEntry* findHistory(int function) const;
+        std::vector<HistoryEntry> historyList; // In the same order as the crate boards
+
+        // Trip snapshots. When an OC, OV, ET or IT bit rises on a channel, the
+        // history of all the channels of the board is frozen, 'tripPostSamples'
+        // acquisitions later. Only the acquisition thread detects the trips;
+        // all the other fields are protected by the port lock.
+        struct TripEntry
+        {
+            int                   statusIndex;  // Positions in the board snapshot, or -1
+            int                   bdStatusIndex;
+            int                   tempIndex;
+            bool                  primed;       // 'lastStatus' holds a valid acquisition
+            std::vector<uint32_t> lastStatus;
+            bool                  armed;
+            int                   pending;      // Acquisitions left before freezing, or -1
+            epicsInt32            count;
+            TripSnapshot          next;         // Being captured
+            TripSnapshot          snapshot;     // Published
+            int                   vmon_param;
+            int                   imon_param;
+            int                   status_param;
+            int                   time_param;
+            int                   channel_param;
+            int                   bits_param;
+            int                   bdstatus_param;
+            int                   temp_param;
+            int                   count_param;
+            int                   arm_param;
+        };
+        asynStatus createTripParams();
+        void checkTrips(std::size_t i, const BoardSnapshotData& d);
+        void freezeTrip(TripEntry& t);
+        bool armTripCapture(int function, epicsInt32 value);
+        const TripEntry* findTrip(int function) const;
+        std::vector<TripEntry> tripList; // In the same order as the crate boards
+
+        // Windowed statistics of VMon and IMon, for all the channels of a
+        // board, updated by the acquisition thread after each acquisition.
+        struct StatsParams
+        {
+            int min_param;
+            int max_param;
+            int mean_param;
+            int rms_param;
+            int slope_param;
+        };
+        struct StatsEntry
+        {
+            BoardHistory::Stats vMon;      // Published, protected by the port lock
+            BoardHistory::Stats iMon;
+            BoardHistory::Stats nextVMon;  // Being computed
+            BoardHistory::Stats nextIMon;
+            epicsTimeStamp      stamp;
+            StatsParams         vmon_params;
+            StatsParams         imon_params;
+        };
+        asynStatus createStatsParams();
+        void updateStats(std::size_t i, const BoardSnapshotData& d);
+        void publishStats(const StatsParams& p, BoardHistory::Stats& s);
+        const StatsEntry* findStats(int function, const std::vector<epicsFloat64>** v) const;
+        std::vector<StatsEntry> statsList; // In the same order as the crate boards
+
+        // Acquisition cycle timing. Only used by the acquisition thread, and
+        // by the timing reset, with the port locked.
+        struct AcqSlotTiming
+        {
+            int time_param;
+            int max_param;
+            int overruns_param;
+            double max;
+            epicsInt32 overruns;
+        };
+        void publishAcqTiming(double period, double cycleTime, double jitter, const std::vector<double>& boardTimes);
+        void resetAcqTiming();
+        int acq_cycle_max_param;
+        int acq_jitter_param;
+        int acq_jitter_max_param;
+        int acq_overrun_slot_param;
+        int acq_timing_reset_param;
+        double acqCycleMax;
+        double acqJitterMax;
+        std::vector<AcqSlotTiming> acqSlotTiming; // In the same order as the crate boards
+
+        // Crate summary, maintained incrementally by the acquisition thread:
+        // after each acquisition the previous contributions of the board are
+        // subtracted from the crate totals, and the new ones added.
+        struct BoardSummary
+        {
+            std::size_t  slot;
+            int          vmonIndex;     // Positions in the board snapshot, or -1
+            int          imonIndex;
+            int          statusIndex;
+            int          tempIndex;
+            double       currentScale;  // Amperes per IMon unit
+            bool         valid;         // The contributions are in the crate totals
+            double       power;         // W
+            double       current;       // IMon units
+            double       temp;
+            epicsInt32   on;
+            epicsInt32   ramping;
+            epicsInt32   tripped;
+            int          current_param;
+            int          power_param;
+        };
+        asynStatus createSummaryParams();
+        void updateSummary(std::size_t i, const BoardSnapshotData& d);
+        std::vector<BoardSummary> summaryList; // In the same order as the crate boards
+        double     sumPower;
+        epicsInt32 sumOn;
+        epicsInt32 sumRamping;
+        epicsInt32 sumTripped;
+        int sum_power_param;
+        int sum_on_param;
+        int sum_ramping_param;
+        int sum_tripped_param;
+        int sum_max_temp_param;
+        int sum_max_temp_slot_param;
+
+        // Binary log of all the acquired channel values, written by the
+        // acquisition thread
+        void createDataLog();
+        void logAcquisition(std::size_t i, const BoardSnapshotData& d);
+        DataLogWriter dataLog;
+        std::vector<uint32_t> dataLogFirstParam; // Log id of the first parameter of each board, in crate order
+
+        // Wrapper call latency statistics
+        asynStatus createWrapperStatsParams();
+        asynStatus createWrapperStatsParams(const std::string& prefix, bool perSlot, std::size_t index);
+        WrapperStats::Summary getWrapperStats(const WrapperStatsEntry& e) const;
+        bool updateWrapperStatsParams(int function);
+        Stats wrapperStats;
+        int wrapper_stats_reset_param;
+        std::map<int, WrapperStatsEntry> wrapperStatsParamList;
+
+        // Throughput and health counters
+        enum IoMethod
+        {
+            ReadInt32,
+            WriteInt32,
+            ReadFloat64,
+            WriteFloat64,
+            ReadUInt32Digital,
+            WriteUInt32Digital,
+            ReadOctet,
+            WriteOctet,
+            NumIoMethods
+        };
+        static const char* getIoMethodName(IoMethod m);
+        asynStatus createDriverStatsParams();
+        std::atomic<unsigned long> ioCount[NumIoMethods];
+        std::atomic<unsigned long> cacheHits;
+        std::atomic<unsigned long> cacheMisses;
+        std::atomic<unsigned long> missedDeadlines;
+        std::atomic<unsigned long> reconnects;
+        std::atomic<double> pollCycleTime;
+        std::atomic<double> lastReadTime;
+        int io_rate_param[NumIoMethods];
+        int cache_hit_ratio_param;
+        int poll_cycle_time_param;
+        int poll_missed_param;
+        int queue_depth_param;
+        int failed_gets_param;
+        int reconnects_param;
+        int last_read_age_param;
+
+        // Tracing helpers. The parameter name is only resolved when a message
+        // is going to be printed, to keep it out of the read/write path.
+        bool isTraced(asynUser *pasynUser, int reason) const { return pasynTrace->getTraceMask(pasynUser) & reason; };
+        const char* getTraceParamName(asynUser *pasynUser, int function);
+
+        // Per-parameter access statistics, used by report()
+        struct ParamStats
+        {
+            std::atomic<double>        lastUpdate; // Time of the last value, in seconds past the EPICS epoch
+            std::atomic<unsigned long> errors;
+        };
+        void createParamStats();
+        void updateParamStats(asynUser *pasynUser, int function, bool ok);
+        void reportBoards(FILE *fp);
+        void reportParams(FILE *fp);
+        std::unique_ptr<ParamStats[]> paramStats;
+        int numParams;
+
+        // Read a value through the scheduler, stamping it with the time of the wrapper call
+        template <typename T>
+        T acquire(asynUser *pasynUser, WrapperScheduler::Priority p, const std::function<T()>& f);
+
+        // Priority used to read a parameter, based on its access mode
+        static WrapperScheduler::Priority getPollPriority(const std::string& mode);
+
         //Reconnection monitor and processing
         asynStatus createReconnParams();
         int fail_count_limit;
@@ -0,0 +1,193 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : event_trace.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * In-memory ring of driver events, which can be dumped in the Chrome trace
+ * event format.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <unistd.h>
+#include <epicsThread.h>
+#include "event_trace.h"
+
+namespace
+{
+    // Entry of the ring. 'seq' is the index of the event plus one, or zero
+    // while the entry is being written. All the fields are atomic, so that
+    // reading an entry while it is overwritten is not a data race; such reads
+    // are detected by checking 'seq' before and after.
+    struct Entry
+    {
+        std::atomic<uint64_t>    seq;
+        std::atomic<int64_t>     time; // ns
+        std::atomic<const char*> category;
+        std::atomic<const char*> name;
+        std::atomic<int32_t>     arg;
+        std::atomic<uint32_t>    tid;
+        std::atomic<char>        phase;
+    };
+
+    const std::size_t Mask = EventTrace::Size - 1;
+
+    std::atomic<uint64_t> next(0);
+
+    typedef std::chrono::steady_clock Clock;
+
+    // The ring is only allocated when the first event is recorded
+    Entry* getRing()
+    {
+        static Entry* ring = new Entry[EventTrace::Size]();
+        return ring;
+    }
+
+    const Clock::time_point& getStart()
+    {
+        static const Clock::time_point start = Clock::now();
+        return start;
+    }
+
+    // Names of the threads which recorded events, indexed by thread id
+    std::mutex               threadMutex;
+    std::vector<std::string> threadNames;
+
+    uint32_t registerThread()
+    {
+        const char* name = epicsThreadGetNameSelf();
+
+        std::lock_guard<std::mutex> lock(threadMutex);
+        threadNames.push_back(name ? name : "");
+        return threadNames.size();
+    }
+
+    uint32_t getThreadId()
+    {
+        static thread_local uint32_t tid = registerThread();
+        return tid;
+    }
+
+    void writeString(std::ostream& os, const char* s)
+    {
+        os << '"';
+        for (; *s; ++s)
+        {
+            if ( ( *s == '"' ) || ( *s == '\\' ) )
+                os << '\\' << *s;
+            else if ( static_cast<unsigned char>(*s) < 0x20 )
+                os << ' ';
+            else
+                os << *s;
+        }
+        os << '"';
+    }
+}
+
+void EventTrace::record(Phase phase, const char* category, const char* name, int32_t arg)
+{
+    int64_t  time = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - getStart()).count();
+    uint32_t tid  = getThreadId();
+    uint64_t i    = next.fetch_add(1, std::memory_order_relaxed);
+    Entry&   e    = getRing()[i & Mask];
+
+    e.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    e.time.store(time, std::memory_order_relaxed);
+    e.category.store(category, std::memory_order_relaxed);
+    e.name.store(name, std::memory_order_relaxed);
+    e.arg.store(arg, std::memory_order_relaxed);
+    e.tid.store(tid, std::memory_order_relaxed);
+    e.phase.store(static_cast<char>(phase), std::memory_order_relaxed);
+
+    e.seq.store(i + 1, std::memory_order_release);
+}
+
+std::size_t EventTrace::dump(std::ostream& os)
+{
+    uint64_t    last  = next.load(std::memory_order_acquire);
+    uint64_t    first = ( last > Size ) ? last - Size : 0;
+    std::size_t count = 0;
+    const char* sep   = "\n";
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    int pid = getpid();
+
+    {
+        std::lock_guard<std::mutex> lock(threadMutex);
+        for (std::size_t t = 0; t < threadNames.size(); ++t)
+        {
+            os << sep << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << t + 1
+               << ",\"args\":{\"name\":";
+            writeString(os, threadNames.at(t).c_str());
+            os << "}}";
+            sep = ",\n";
+        }
+    }
+
+    os << std::fixed << std::setprecision(3);
+
+    for (uint64_t i = first; i < last; ++i)
+    {
+        const Entry& e = getRing()[i & Mask];
+
+        if (e.seq.load(std::memory_order_acquire) != i + 1)
+            continue;
+
+        int64_t     time     = e.time.load(std::memory_order_relaxed);
+        const char* category = e.category.load(std::memory_order_relaxed);
+        const char* name     = e.name.load(std::memory_order_relaxed);
+        int32_t     arg      = e.arg.load(std::memory_order_relaxed);
+        uint32_t    tid      = e.tid.load(std::memory_order_relaxed);
+        char        phase    = e.phase.load(std::memory_order_relaxed);
+
+        // Skip the entry if it was overwritten while we were reading it
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (e.seq.load(std::memory_order_relaxed) != i + 1)
+            continue;
+
+        os << sep << "{\"name\":";
+        writeString(os, name);
+        os << ",\"cat\":";
+        writeString(os, category);
+        os << ",\"ph\":\"" << phase << "\",\"ts\":" << time / 1e3 << ",\"pid\":" << pid << ",\"tid\":" << tid;
+        if (phase == Instant)
+            os << ",\"s\":\"t\"";
+        os << ",\"args\":{\"arg\":" << arg << "}}";
+
+        sep = ",\n";
+        ++count;
+    }
+
+    os << "\n]}" << std::endl;
+
+    return count;
+}
+
+bool EventTrace::isEnabled()
+{
+#ifdef CAENHVASYN_EVENT_TRACE
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,98 @@
+#ifndef EVENT_TRACE_H
+#define EVENT_TRACE_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : event_trace.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * In-memory ring of driver events, which can be dumped in the Chrome trace
+ * event format.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <ostream>
+#include <stdint.h>
+
+// Ring of the last 'Size' driver events, shared by all the driver instances.
+// Each event has a monotonic timestamp, the thread which recorded it, a
+// category, a name and an integer argument. The category and the name must
+// be string literals (or live as long as the program), as only the pointers
+// are stored.
+//
+// Recording an event is lock-free and never blocks: each thread claims the
+// next entry with an atomic increment, and the oldest events are overwritten.
+// The entries being written while the ring is dumped are skipped.
+//
+// The events are only recorded when the module is built with
+// CAENHVASYN_EVENT_TRACE=YES; otherwise the EVENT_TRACE_* macros are empty.
+class EventTrace
+{
+public:
+    // Event phases, as in the Chrome trace event format
+    enum Phase
+    {
+        Begin   = 'B',
+        End     = 'E',
+        Instant = 'i'
+    };
+
+    static const std::size_t Size = 1 << 16;
+
+    static void record(Phase phase, const char* category, const char* name, int32_t arg);
+
+    // Write the events in the ring, oldest first, as a Chrome trace JSON
+    // object. Returns the number of events written.
+    static std::size_t dump(std::ostream& os);
+
+    // Whether the module was built with the events enabled
+    static bool isEnabled();
+
+    // Records a begin event when created, and the matching end event when
+    // destroyed
+    class Scope
+    {
+    public:
+        Scope(const char* category, const char* name, int32_t arg)
+        :
+            category_(category),
+            name_(name),
+            arg_(arg)
+        {
+            record(Begin, category_, name_, arg_);
+        };
+
+        ~Scope() { record(End, category_, name_, arg_); };
+
+    private:
+        const char* category_;
+        const char* name_;
+        int32_t     arg_;
+    };
+};
+
+#ifdef CAENHVASYN_EVENT_TRACE
+#define EVENT_TRACE_BEGIN(category, name, arg)   EventTrace::record(EventTrace::Begin, category, name, arg)
+#define EVENT_TRACE_END(category, name, arg)     EventTrace::record(EventTrace::End, category, name, arg)
+#define EVENT_TRACE_INSTANT(category, name, arg) EventTrace::record(EventTrace::Instant, category, name, arg)
+#define EVENT_TRACE_SCOPE(category, name, arg)   EventTrace::Scope eventTraceScope_(category, name, arg)
+#else
+#define EVENT_TRACE_BEGIN(category, name, arg)   do {} while (0)
+#define EVENT_TRACE_END(category, name, arg)     do {} while (0)
+#define EVENT_TRACE_INSTANT(category, name, arg) do {} while (0)
+#define EVENT_TRACE_SCOPE(category, name, arg)   do {} while (0)
+#endif
+
+#endif
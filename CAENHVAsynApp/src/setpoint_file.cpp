@@ -0,0 +1,176 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : setpoint_file.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Files with the setpoints (writable parameters) of the boards and channels
+ * of a crate
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <tuple>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "setpoint_file.h"
+
+void readSetpointFile(const std::string& fileName, std::vector<Setpoint>& setpoints)
+{
+    std::ifstream file(fileName.c_str());
+    if (!file.is_open())
+        throw std::runtime_error("Can not open '" + fileName + "'");
+
+    setpoints.clear();
+
+    std::string line;
+    std::size_t number(0);
+    while (std::getline(file, line))
+    {
+        ++number;
+
+        std::size_t comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+
+        std::istringstream fields(line);
+        std::string slot, channel, param, value, extra;
+        if (!(fields >> slot))
+            continue;
+
+        std::stringstream error;
+        error << "'" << fileName << "' line " << number << ": ";
+
+        if ( ( !(fields >> channel >> param >> value) ) || ( fields >> extra ) )
+            throw std::runtime_error(error.str() + "expected '<slot> <channel> <parameter> <value>'");
+
+        Setpoint s;
+        char* end;
+
+        unsigned long n = strtoul(slot.c_str(), &end, 10);
+        if (*end)
+            throw std::runtime_error(error.str() + "invalid slot '" + slot + "'");
+        s.slot = n;
+
+        if (channel == "-")
+        {
+            s.channel = -1;
+        }
+        else
+        {
+            n = strtoul(channel.c_str(), &end, 10);
+            if ( ( *end ) || ( n > 0xffff ) )
+                throw std::runtime_error(error.str() + "invalid channel '" + channel + "'");
+            s.channel = n;
+        }
+
+        s.param = param;
+
+        s.value = strtod(value.c_str(), &end);
+        if (*end)
+            throw std::runtime_error(error.str() + "invalid value '" + value + "'");
+
+        setpoints.push_back(s);
+    }
+
+    if (file.bad())
+        throw std::runtime_error("Can not read '" + fileName + "'");
+}
+
+void groupSetpoints(const std::vector<Setpoint>& setpoints, std::vector<SetpointGroup>& groups)
+{
+    typedef std::tuple<std::size_t, int, std::string>          SetpointKey;
+    typedef std::tuple<std::size_t, bool, std::string, double> GroupKey;
+
+    // Last occurrence of each setpoint
+    std::map<SetpointKey, std::size_t> last;
+    for (std::size_t i(0); i < setpoints.size(); ++i)
+        last[SetpointKey(setpoints[i].slot, setpoints[i].channel, setpoints[i].param)] = i;
+
+    std::map<GroupKey, std::size_t> index;
+
+    groups.clear();
+
+    for (std::size_t i(0); i < setpoints.size(); ++i)
+    {
+        const Setpoint& s = setpoints[i];
+        if (last[SetpointKey(s.slot, s.channel, s.param)] != i)
+            continue;
+
+        GroupKey key(s.slot, ( s.channel < 0 ), s.param, s.value);
+
+        std::map<GroupKey, std::size_t>::iterator it = index.find(key);
+        if (it == index.end())
+        {
+            SetpointGroup g;
+            g.slot  = s.slot;
+            g.board = ( s.channel < 0 );
+            g.param = s.param;
+            g.value = s.value;
+            g.count = 0;
+            it = index.insert(std::make_pair(key, groups.size())).first;
+            groups.push_back(g);
+        }
+
+        SetpointGroup& g = groups.at(it->second);
+        ++g.count;
+        if (!g.board)
+            g.channels.push_back(s.channel);
+    }
+}
+
+void writeSetpointFile(const std::string& fileName, const std::vector<std::string>& comments, const std::vector<Setpoint>& setpoints)
+{
+    std::string tempName(fileName + ".tmp");
+
+    FILE *f = fopen(tempName.c_str(), "w");
+    if (!f)
+        throw std::runtime_error("Can not open '" + tempName + "'");
+
+    int r(0);
+
+    for (std::vector<std::string>::const_iterator it = comments.begin(); it != comments.end(); ++it)
+        r |= ( fprintf(f, "# %s\n", it->c_str()) < 0 );
+
+    for (std::vector<Setpoint>::const_iterator it = setpoints.begin(); it != setpoints.end(); ++it)
+    {
+        char channel[8];
+        if (it->channel < 0)
+            snprintf(channel, sizeof(channel), "-");
+        else
+            snprintf(channel, sizeof(channel), "%d", it->channel);
+
+        // Integer values (the 32-bit word parameters) are written with all
+        // their digits, and the float values with the precision of a float
+        if ( ( it->value == floor(it->value) ) && ( fabs(it->value) < 1e15 ) )
+            r |= ( fprintf(f, "%zu %s %s %.0f\n", it->slot, channel, it->param.c_str(), it->value) < 0 );
+        else
+            r |= ( fprintf(f, "%zu %s %s %.7g\n", it->slot, channel, it->param.c_str(), it->value) < 0 );
+    }
+
+    if ( ( fclose(f) ) || ( r ) )
+    {
+        remove(tempName.c_str());
+        throw std::runtime_error("Can not write '" + tempName + "'");
+    }
+
+    if (rename(tempName.c_str(), fileName.c_str()))
+    {
+        remove(tempName.c_str());
+        throw std::runtime_error("Can not rename '" + tempName + "' to '" + fileName + "'");
+    }
+}
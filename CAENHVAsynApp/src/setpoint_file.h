@@ -0,0 +1,71 @@
+#ifndef SETPOINT_FILE_H
+#define SETPOINT_FILE_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : setpoint_file.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Files with the setpoints (writable parameters) of the boards and channels
+ * of a crate
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <stdint.h>
+
+// A setpoint file has one setpoint per line:
+//   <slot> <channel> <parameter> <value>
+// where <channel> is '-' for the board parameters. Empty lines, and
+// everything after a '#', are ignored.
+
+// Value of a channel parameter, or of a board parameter if 'channel' < 0
+struct Setpoint
+{
+    std::size_t slot;
+    int         channel;
+    std::string param;
+    double      value;
+};
+
+// Setpoints which are applied with a single wrapper call: a parameter set to
+// the same value in several channels of a board, or a board parameter
+struct SetpointGroup
+{
+    std::size_t           slot;
+    bool                  board;
+    std::string           param;
+    double                value;
+    std::vector<uint16_t> channels;
+    std::size_t           count;    // Number of setpoints in the group
+};
+
+// Reads a setpoint file. Throws a std::runtime_error, with the line number,
+// if it can not be read or parsed.
+void readSetpointFile(const std::string& fileName, std::vector<Setpoint>& setpoints);
+
+// Groups the setpoints by slot, parameter and value, in the order in which
+// each group first appears. If a setpoint appears several times, the last
+// value is used.
+void groupSetpoints(const std::vector<Setpoint>& setpoints, std::vector<SetpointGroup>& groups);
+
+// Writes a setpoint file, starting with the comment lines. The file is
+// written under a temporary name and then renamed, so an existing file is
+// only replaced by a complete one. Throws a std::runtime_error on errors.
+void writeSetpointFile(const std::string& fileName, const std::vector<std::string>& comments, const std::vector<Setpoint>& setpoints);
+
+#endif
@@ -21,9 +21,10 @@
 
 #include "system_property.h"
 
-SystemPropertyBase::SystemPropertyBase(int h, const std::string&  p, uint32_t m)
+SystemPropertyBase::SystemPropertyBase(int h, const Stats& st, const std::string&  p, uint32_t m)
 :
     handle(h),
+    stats(st),
     prop(p),
     mode(m)
 {
@@ -60,14 +61,14 @@ void SystemPropertyBase::printInfo(std::ostream& stream) const
 }
 
 // String class
-SystemPropertyString ISystemPropertyString::create(int h, const std::string&  p, uint32_t m)
+SystemPropertyString ISystemPropertyString::create(int h, const Stats& st, const std::string&  p, uint32_t m)
 {
-    return std::make_shared<ISystemPropertyString>(h, p, m);
+    return std::make_shared<ISystemPropertyString>(h, st, p, m);
 }
 
-ISystemPropertyString::ISystemPropertyString(int h, const std::string&  p, uint32_t m)
+ISystemPropertyString::ISystemPropertyString(int h, const Stats& st, const std::string&  p, uint32_t m)
 :
-    SystemPropertyBase(h,p,m)
+    SystemPropertyBase(h,st,p,m)
 {
 }
 
@@ -79,7 +80,7 @@ std::string ISystemPropertyString::getVal() const
 
     char temp[4096];
 
-    CAENHVRESULT r = CAENHV_GetSysProp(handle, prop.c_str(), temp);
+    CAENHVRESULT r = timedCall(stats, WrapperStats::GetSysProp, WrapperStats::NoSlot, [&]() { return CAENHV_GetSysProp(handle, prop.c_str(), temp); });
 
     if ( r != CAENHV_OK && r != CAENHV_GETPROPNOTIMPL && r != CAENHV_NOTGETPROP )
         throw std::runtime_error("CAENHV_GetSysProp failed: " + std::string(CAENHV_GetError(handle)));
@@ -96,21 +97,21 @@ void ISystemPropertyString::setVal(const std::string& v) const
     char temp[v.size() + 1];
     strcpy(temp, v.c_str());
 
-    CAENHVRESULT r = CAENHV_SetSysProp(handle, prop.c_str(), temp);
+    CAENHVRESULT r = timedCall(stats, WrapperStats::SetSysProp, WrapperStats::NoSlot, [&]() { return CAENHV_SetSysProp(handle, prop.c_str(), temp); });
 
     if ( r != CAENHV_OK && r != CAENHV_GETPROPNOTIMPL && r != CAENHV_NOTGETPROP )
         throw std::runtime_error("CAENHV_SetSysProp failed: " + std::string(CAENHV_GetError(handle)));
 }
 
 // Float class
-SystemPropertyFloat ISystemPropertyFloat::create(int h, const std::string&  p, uint32_t m)
+SystemPropertyFloat ISystemPropertyFloat::create(int h, const Stats& st, const std::string&  p, uint32_t m)
 {
-    return std::make_shared<ISystemPropertyFloat>(h, p, m);
+    return std::make_shared<ISystemPropertyFloat>(h, st, p, m);
 }
 
-ISystemPropertyFloat::ISystemPropertyFloat(int h, const std::string&  p, uint32_t m)
+ISystemPropertyFloat::ISystemPropertyFloat(int h, const Stats& st, const std::string&  p, uint32_t m)
 :
-    SystemPropertyBase(h,p,m)
+    SystemPropertyBase(h,st,p,m)
 {
 }
 
@@ -121,7 +122,7 @@ float ISystemPropertyFloat::getVal() const
 
     float temp;
 
-    CAENHVRESULT r = CAENHV_GetSysProp(handle, prop.c_str(), &temp);
+    CAENHVRESULT r = timedCall(stats, WrapperStats::GetSysProp, WrapperStats::NoSlot, [&]() { return CAENHV_GetSysProp(handle, prop.c_str(), &temp); });
 
     if ( r != CAENHV_OK && r != CAENHV_GETPROPNOTIMPL && r != CAENHV_NOTGETPROP )
         throw std::runtime_error("CAENHV_GetSysProp failed: " + std::string(CAENHV_GetError(handle)));
@@ -134,7 +135,7 @@ void ISystemPropertyFloat::setVal(float v) const
     if (mode == SYSPROP_MODE_RDONLY)
         return;
 
-    CAENHVRESULT r = CAENHV_SetSysProp(handle, prop.c_str(), &v);
+    CAENHVRESULT r = timedCall(stats, WrapperStats::SetSysProp, WrapperStats::NoSlot, [&]() { return CAENHV_SetSysProp(handle, prop.c_str(), &v); });
 
     if ( r != CAENHV_OK && r != CAENHV_GETPROPNOTIMPL && r != CAENHV_NOTGETPROP )
         throw std::runtime_error("CAENHV_SetSysProp failed: " + std::string(CAENHV_GetError(handle)));
@@ -142,9 +143,9 @@ void ISystemPropertyFloat::setVal(float v) const
 
 // Integer class template
 template<typename T>
-std::shared_ptr< ISystemPropertyIntegerTemplate<T> > ISystemPropertyIntegerTemplate<T>::create(int h, const std::string&  p, uint32_t m)
+std::shared_ptr< ISystemPropertyIntegerTemplate<T> > ISystemPropertyIntegerTemplate<T>::create(int h, const Stats& st, const std::string&  p, uint32_t m)
 {
-    return std::make_shared<ISystemPropertyIntegerTemplate>(h, p, m);
+    return std::make_shared<ISystemPropertyIntegerTemplate>(h, st, p, m);
 }
 
 template<typename T>
@@ -155,7 +156,7 @@ int32_t ISystemPropertyIntegerTemplate<T>::getVal() const
 
     T temp;
 
-    CAENHVRESULT r = CAENHV_GetSysProp(handle, prop.c_str(), &temp);
+    CAENHVRESULT r = timedCall(stats, WrapperStats::GetSysProp, WrapperStats::NoSlot, [&]() { return CAENHV_GetSysProp(handle, prop.c_str(), &temp); });
 
     if ( r != CAENHV_OK && r != CAENHV_GETPROPNOTIMPL && r != CAENHV_NOTGETPROP )
         throw std::runtime_error("CAENHV_GetSysProp failed: " + std::string(CAENHV_GetError(handle)));
@@ -170,7 +171,7 @@ void ISystemPropertyIntegerTemplate<T>::setVal(int32_t value) const
         return;
 
     T temp = static_cast<T>(value);
-    CAENHVRESULT r = CAENHV_SetSysProp(handle, prop.c_str(), &temp);
+    CAENHVRESULT r = timedCall(stats, WrapperStats::SetSysProp, WrapperStats::NoSlot, [&]() { return CAENHV_SetSysProp(handle, prop.c_str(), &temp); });
 
     if ( r != CAENHV_OK && r != CAENHV_GETPROPNOTIMPL && r != CAENHV_NOTGETPROP )
         throw std::runtime_error("CAENHV_SetSysProp failed: " + std::string(CAENHV_GetError(handle)));
@@ -0,0 +1,77 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : trip_snapshot.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * History of all the channels of a board, frozen after a channel trip
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <stdio.h>
+#include "trip_snapshot.h"
+
+namespace
+{
+    const char     tripMagic[4] = { 'C', 'H', 'V', 'S' };
+    const uint32_t tripVersion  = 1;
+
+    template <typename T>
+    void writeArray(FILE *f, const std::vector<T>& v)
+    {
+        if ( ( !v.empty() ) && ( fwrite(v.data(), sizeof(T), v.size(), f) != v.size() ) )
+            throw std::runtime_error("write error");
+    }
+}
+
+void TripSnapshot::write(const std::string& fileName) const
+{
+    FILE *f = fopen(fileName.c_str(), "wb");
+    if (!f)
+        throw std::runtime_error("Can not open '" + fileName + "'");
+
+    try
+    {
+        uint32_t header[] =
+        {
+            tripVersion,
+            static_cast<uint32_t>(slot),
+            static_cast<uint32_t>(numChannels),
+            static_cast<uint32_t>(numSamples),
+            static_cast<uint32_t>(channel),
+            bits,
+            bdStatus
+        };
+
+        if ( ( fwrite(tripMagic, sizeof(tripMagic), 1, f) != 1 ) ||
+             ( fwrite(header, sizeof(header), 1, f) != 1 ) ||
+             ( fwrite(&temp, sizeof(temp), 1, f) != 1 ) ||
+             ( fwrite(&trigger.secPastEpoch, sizeof(uint32_t), 1, f) != 1 ) ||
+             ( fwrite(&trigger.nsec, sizeof(uint32_t), 1, f) != 1 ) )
+            throw std::runtime_error("write error");
+
+        writeArray(f, time);
+        writeArray(f, block.vMon);
+        writeArray(f, block.iMon);
+        writeArray(f, block.status);
+    }
+    catch(std::runtime_error& e)
+    {
+        fclose(f);
+        throw std::runtime_error("Can not write '" + fileName + "': " + e.what());
+    }
+
+    if (fclose(f))
+        throw std::runtime_error("Can not write '" + fileName + "'");
+}
@@ -0,0 +1,78 @@
+#ifndef TRIP_SNAPSHOT_H
+#define TRIP_SNAPSHOT_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : trip_snapshot.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * History of all the channels of a board, frozen after a channel trip
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <stdint.h>
+#include <epicsTypes.h>
+#include <epicsTime.h>
+#include "board_history.h"
+
+// Channel status bits which trigger a trip snapshot: OC, OV, ET and IT
+// (see recordFieldChParamChStatus). The crate summary counts the channels
+// with any of them set as tripped, and uses the ON and RU/RD bits too.
+const uint32_t chStatusTripMask = 0x0008 | 0x0010 | 0x0040 | 0x0200;
+const uint32_t chStatusOnMask   = 0x0001;
+const uint32_t chStatusRampMask = 0x0002 | 0x0004;
+
+// A trip snapshot file has a header:
+//   char[4]  magic ("CHVS")
+//   uint32   version
+//   uint32   slot
+//   uint32   number of channels
+//   uint32   number of samples
+//   int32    channel which triggered the snapshot
+//   uint32   trip bits which rose on that channel
+//   uint32   board status word (BdStatus), at the time of the trip
+//   double   board temperature, at the time of the trip
+//   uint32   trip time, seconds past the EPICS epoch
+//   uint32   trip time, nanoseconds
+// followed by the arrays:
+//   double   time of each sample, in seconds relative to the trip [samples]
+//   double   VMon  [samples][channels]
+//   double   IMon  [samples][channels]
+//   int32    Status [samples][channels]
+// All the values are in the byte order of the host which wrote the file.
+struct TripSnapshot
+{
+    TripSnapshot() : slot(0), numChannels(0), numSamples(0), channel(-1), bits(0), bdStatus(0), temp(0)
+    { trigger.secPastEpoch = 0; trigger.nsec = 0; };
+
+    std::size_t               slot;
+    std::size_t               numChannels;
+    std::size_t               numSamples;
+    epicsInt32                channel;
+    epicsUInt32               bits;
+    epicsUInt32               bdStatus;
+    epicsFloat64              temp;
+    epicsTimeStamp            trigger;
+    std::vector<epicsFloat64> time;  // Relative to the trigger
+    BoardHistory::Block       block;
+
+    // Write the snapshot to a file. Throws std::runtime_error on errors.
+    void write(const std::string& fileName) const;
+};
+
+#endif
@@ -0,0 +1,364 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : wrapper_scheduler.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Priority scheduler for CAEN HV Wrapper calls
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include "wrapper_scheduler.h"
+
+WrapperScheduler::WrapperScheduler(const std::string& name)
+:
+    name_(name),
+    workerId_(NULL),
+    mutex_(epicsMutexMustCreate()),
+    wakeUp_(epicsEventMustCreate(epicsEventEmpty)),
+    timeout_(0),
+    quarantined_(false),
+    hung_(false),
+    timeouts_(0)
+{
+    resetStats();
+
+    epicsMutexMustLock(mutex_);
+    startWorker();
+    epicsMutexUnlock(mutex_);
+}
+
+WrapperScheduler::~WrapperScheduler()
+{
+    // The scheduler lives as long as the driver, which is never destroyed.
+}
+
+void WrapperScheduler::workerTaskC(void* drvPvt)
+{
+    WrapperScheduler *pPvt = (WrapperScheduler *)drvPvt;
+
+    pPvt->workerTask();
+}
+
+void WrapperScheduler::startWorker()
+{
+    workerId_ = epicsThreadCreate(name_.c_str(),
+                                  epicsThreadPriorityMedium,
+                                  epicsThreadGetStackSize(epicsThreadStackMedium),
+                                  (EPICSTHREADFUNC)workerTaskC,
+                                  this);
+
+    if (!workerId_)
+        throw std::runtime_error("epicsThreadCreate failure for wrapper scheduler task '" + name_ + "'");
+}
+
+void WrapperScheduler::failQueued(const char* reason)
+{
+    for (std::size_t i(0); i < NumPriorities; ++i)
+    {
+        for (std::deque< std::shared_ptr<Job> >::iterator it = queues_[i].begin(); it != queues_[i].end(); ++it)
+        {
+            (*it)->finished = true;
+            (*it)->error    = std::make_exception_ptr(WrapperSuspended(reason));
+            epicsEventSignal((*it)->done);
+        }
+
+        queues_[i].clear();
+    }
+}
+
+void WrapperScheduler::run(Priority p, const std::function<void()>& f, epicsTimeStamp* stamp, double* duration)
+{
+    epicsMutexMustLock(mutex_);
+    bool   inPlace(epicsThreadGetIdSelf() == workerId_);
+    bool   quarantined(quarantined_);
+    bool   hung(hung_);
+    double timeout(timeout_);
+    epicsMutexUnlock(mutex_);
+
+    // Calls done from the worker thread itself (for example, from inside
+    // another job) are executed in place, otherwise we will deadlock.
+    if (inPlace)
+    {
+        epicsTimeStamp start, end;
+        epicsTimeGetCurrent(&start);
+        f();
+        epicsTimeGetCurrent(&end);
+
+        if (stamp)
+            *stamp = start;
+
+        if (duration)
+            *duration = epicsTimeDiffInSeconds(&end, &start);
+
+        return;
+    }
+
+    if (hung)
+        throw WrapperSuspended("Wrapper calls are suspended until the hung call returns");
+
+    if ( quarantined && ( p != Safety ) )
+        throw WrapperSuspended("Wrapper calls are suspended until the connection is reinitialized");
+
+    // Time the caller waits for the call: in the queue and executing
+    EVENT_TRACE_SCOPE("sched", getPriorityName(p), p);
+
+    std::shared_ptr<Job> job = std::make_shared<Job>();
+    job->p = p;
+    job->f = f;
+    epicsTimeGetCurrent(&job->queued);
+
+    epicsMutexMustLock(mutex_);
+    queues_[p].push_back(job);
+    epicsMutexUnlock(mutex_);
+
+    epicsEventSignal(wakeUp_);
+
+    if (timeout <= 0)
+    {
+        epicsEventMustWait(job->done);
+    }
+    else
+    {
+        // The deadline starts when the call starts to execute. The time spent
+        // in the queue is already bounded by the deadlines of the calls ahead.
+        double wait(timeout);
+        while (epicsEventWaitWithTimeout(job->done, wait) != epicsEventOK)
+        {
+            epicsMutexMustLock(mutex_);
+
+            if (job->finished)
+            {
+                epicsMutexUnlock(mutex_);
+                break;
+            }
+
+            if (job->running)
+            {
+                epicsTimeStamp now;
+                epicsTimeGetCurrent(&now);
+                double elapsed(epicsTimeDiffInSeconds(&now, &job->started));
+
+                if (elapsed >= timeout)
+                {
+                    // The call is hung. No other call can use the handle
+                    // until it returns, so the calls waiting in the queues
+                    // fail now, and the new ones fail right away.
+                    quarantined_ = true;
+                    hung_        = true;
+                    ++timeouts_;
+
+                    failQueued("Wrapper calls are suspended until the hung call returns");
+
+                    epicsMutexUnlock(mutex_);
+
+                    std::ostringstream msg;
+                    msg << "Wrapper call timed out after " << elapsed << " s";
+                    throw WrapperTimeout(msg.str());
+                }
+
+                wait = timeout - elapsed;
+            }
+            else
+            {
+                wait = timeout;
+            }
+
+            epicsMutexUnlock(mutex_);
+        }
+    }
+
+    if (stamp)
+        *stamp = job->started;
+
+    if (duration)
+        *duration = job->duration;
+
+    if (job->error)
+        std::rethrow_exception(job->error);
+}
+
+void WrapperScheduler::workerTask()
+{
+    while (true)
+    {
+        std::shared_ptr<Job> job;
+        bool refused(false);
+
+        epicsMutexMustLock(mutex_);
+        for (std::size_t i(0); i < NumPriorities; ++i)
+        {
+            if (!queues_[i].empty())
+            {
+                job = queues_[i].front();
+                queues_[i].pop_front();
+
+                epicsTimeGetCurrent(&job->started);
+                double wait(epicsTimeDiffInSeconds(&job->started, &job->queued));
+
+                lastWait_[i] = wait;
+                if (wait > maxWait_[i])
+                    maxWait_[i] = wait;
+
+                // Calls queued before the quarantine started are refused too
+                if ( quarantined_ && ( job->p != Safety ) )
+                {
+                    refused       = true;
+                    job->finished = true;
+                    job->error    = std::make_exception_ptr(WrapperSuspended("Wrapper calls are suspended until the connection is reinitialized"));
+                }
+                else
+                {
+                    job->running = true;
+                }
+
+                break;
+            }
+        }
+        epicsMutexUnlock(mutex_);
+
+        if (!job)
+        {
+            epicsEventMustWait(wakeUp_);
+            continue;
+        }
+
+        if (refused)
+        {
+            epicsEventSignal(job->done);
+            continue;
+        }
+
+        try
+        {
+            job->f();
+        }
+        catch(...)
+        {
+            job->error = std::current_exception();
+        }
+
+        epicsTimeStamp end;
+        epicsTimeGetCurrent(&end);
+        job->duration = epicsTimeDiffInSeconds(&end, &job->started);
+
+        // If the call took too long, the calls can be executed again
+        epicsMutexMustLock(mutex_);
+        job->finished = true;
+        hung_         = false;
+        epicsMutexUnlock(mutex_);
+
+        epicsEventSignal(job->done);
+    }
+}
+
+void WrapperScheduler::setTimeout(double t)
+{
+    epicsMutexMustLock(mutex_);
+    timeout_ = t;
+    epicsMutexUnlock(mutex_);
+}
+
+double WrapperScheduler::getTimeout() const
+{
+    epicsMutexMustLock(mutex_);
+    double t(timeout_);
+    epicsMutexUnlock(mutex_);
+
+    return t;
+}
+
+bool WrapperScheduler::isQuarantined() const
+{
+    epicsMutexMustLock(mutex_);
+    bool q(quarantined_);
+    epicsMutexUnlock(mutex_);
+
+    return q;
+}
+
+void WrapperScheduler::clearQuarantine()
+{
+    epicsMutexMustLock(mutex_);
+    quarantined_ = false;
+    epicsMutexUnlock(mutex_);
+}
+
+bool WrapperScheduler::isHung() const
+{
+    epicsMutexMustLock(mutex_);
+    bool h(hung_);
+    epicsMutexUnlock(mutex_);
+
+    return h;
+}
+
+std::size_t WrapperScheduler::getTimeouts() const
+{
+    epicsMutexMustLock(mutex_);
+    std::size_t n(timeouts_);
+    epicsMutexUnlock(mutex_);
+
+    return n;
+}
+
+std::size_t WrapperScheduler::getQueueDepth(Priority p) const
+{
+    epicsMutexMustLock(mutex_);
+    std::size_t n(queues_[p].size());
+    epicsMutexUnlock(mutex_);
+
+    return n;
+}
+
+double WrapperScheduler::getLastWait(Priority p) const
+{
+    epicsMutexMustLock(mutex_);
+    double w(lastWait_[p]);
+    epicsMutexUnlock(mutex_);
+
+    return w;
+}
+
+double WrapperScheduler::getMaxWait(Priority p) const
+{
+    epicsMutexMustLock(mutex_);
+    double w(maxWait_[p]);
+    epicsMutexUnlock(mutex_);
+
+    return w;
+}
+
+void WrapperScheduler::resetStats()
+{
+    epicsMutexMustLock(mutex_);
+    for (std::size_t i(0); i < NumPriorities; ++i)
+    {
+        lastWait_[i] = 0;
+        maxWait_[i]  = 0;
+    }
+    epicsMutexUnlock(mutex_);
+}
+
+const char* WrapperScheduler::getPriorityName(Priority p)
+{
+    switch (p)
+    {
+        case Safety:   return "SAFETY";
+        case Operator: return "OPERATOR";
+        case FastPoll: return "FAST_POLL";
+        case SlowPoll: return "SLOW_POLL";
+        default:       return "UNKNOWN";
+    }
+}
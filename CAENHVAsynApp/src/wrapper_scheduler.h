@@ -0,0 +1,149 @@
+#ifndef WRAPPER_SCHEDULER_H
+#define WRAPPER_SCHEDULER_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : wrapper_scheduler.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Priority scheduler for CAEN HV Wrapper calls
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <exception>
+#include <epicsTime.h>
+#include <epicsThread.h>
+#include <epicsMutex.h>
+#include <epicsEvent.h>
+#include "event_trace.h"
+
+// Exception thrown when a wrapper call doesn't finish before its deadline,
+// or when calls are refused because the handle is quarantined.
+class WrapperTimeout : public std::runtime_error
+{
+public:
+    WrapperTimeout(const std::string& what) : std::runtime_error(what) {};
+};
+
+// Thrown when a call is refused, without being executed, because of a
+// previous timeout
+class WrapperSuspended : public WrapperTimeout
+{
+public:
+    WrapperSuspended(const std::string& what) : WrapperTimeout(what) {};
+};
+
+// All the calls to the CAEN HV Wrapper library are executed by a single
+// worker thread owned by this class. Callers submit a function with a
+// priority class and block until the worker has executed it. Pending
+// requests are always served in priority order, so a channel OFF command
+// only waits for the wrapper call which is already in progress.
+//
+// Each call has a deadline. If a call is still running when its deadline
+// passes, the caller gets a WrapperTimeout exception and the scheduler is
+// quarantined: until clearQuarantine() is called (after the connection is
+// reinitialized), only calls with Safety priority are executed, all others
+// fail right away. The worker is not replaced, as the library does not
+// support concurrent calls on the same handle: while the hung call has not
+// returned, all the calls, including the Safety ones, fail right away, and
+// so does the reinitialization of the connection.
+class WrapperScheduler
+{
+public:
+    // Priority classes, from highest to lowest
+    enum Priority
+    {
+        Safety = 0,     // Channel OFF commands, reconnection
+        Operator,       // Operator writes
+        FastPoll,       // Reads of monitor parameters (VMon, IMon, Status, ...)
+        SlowPoll,       // Reads of everything else (setpoint readbacks, system properties, ...)
+        NumPriorities
+    };
+
+    WrapperScheduler(const std::string& name);
+    ~WrapperScheduler();
+
+    // Execute 'f' on the worker thread, with priority 'p', and wait for it
+    // to finish. Exceptions thrown by 'f' are re-thrown to the caller.
+    // If 'stamp' and 'duration' are given, they are filled with the time
+    // at which 'f' started to execute, and how long it took (in seconds).
+    // As 'f' can outlive this call if it times out, it must not reference
+    // any variable in the caller's stack: capture by value.
+    void run(Priority p, const std::function<void()>& f, epicsTimeStamp* stamp = NULL, double* duration = NULL);
+
+    // Maximum execution time of each call, in seconds. Zero means no limit.
+    void   setTimeout(double t);
+    double getTimeout() const;
+
+    // Quarantine, after a call timed out
+    bool isQuarantined() const;
+    void clearQuarantine();
+
+    // A call which timed out is still executing
+    bool isHung() const;
+
+    // Statistics
+    std::size_t getQueueDepth(Priority p) const;
+    double      getLastWait(Priority p)   const; // Seconds
+    double      getMaxWait(Priority p)    const; // Seconds
+    std::size_t getTimeouts()             const;
+    void        resetStats();
+
+    static const char* getPriorityName(Priority p);
+
+private:
+    struct Job
+    {
+        Job() : p(Safety), running(false), finished(false), queued(), started(), duration(0), done(epicsEventMustCreate(epicsEventEmpty)) {};
+        ~Job() { epicsEventDestroy(done); };
+
+        Priority              p;
+        std::function<void()> f;
+        bool                  running;
+        bool                  finished;
+        epicsTimeStamp        queued;
+        epicsTimeStamp        started;
+        double                duration;
+        std::exception_ptr    error;
+        epicsEventId          done;
+    };
+
+    static void workerTaskC(void* drvPvt);
+    void workerTask();
+
+    // Must be called with the mutex held
+    void startWorker();
+    void failQueued(const char* reason);
+
+    std::string        name_;
+    epicsThreadId      workerId_;
+    epicsMutexId       mutex_;
+    epicsEventId       wakeUp_;
+    std::deque< std::shared_ptr<Job> > queues_[NumPriorities];
+    double             lastWait_[NumPriorities];
+    double             maxWait_[NumPriorities];
+    double             timeout_;
+    bool               quarantined_;
+    bool               hung_;
+    std::size_t        timeouts_;
+};
+
+#endif
@@ -0,0 +1,155 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : wrapper_stats.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Latency histograms of the calls to the CAEN HV Wrapper library
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include "wrapper_stats.h"
+
+constexpr double WrapperStats::BucketBase;
+
+namespace
+{
+    const char* functionNames[WrapperStats::NumFunctions] =
+    {
+        "InitSystem",
+        "DeinitSystem",
+        "GetCrateMap",
+        "GetSysPropList",
+        "GetSysPropInfo",
+        "GetSysProp",
+        "SetSysProp",
+        "GetBdParamInfo",
+        "GetBdParamProp",
+        "GetBdParam",
+        "SetBdParam",
+        "GetChParamInfo",
+        "GetChParamProp",
+        "GetChParam",
+        "SetChParam",
+        "GetChName",
+        "SetChName",
+    };
+}
+
+WrapperStats::WrapperStats()
+{
+    reset();
+}
+
+void WrapperStats::record(Function f, std::size_t slot, double seconds)
+{
+    if (slot > MaxSlots)
+        slot = NoSlot;
+
+    std::size_t b(0);
+    for (double edge(BucketBase); ( seconds >= edge ) && ( b < NumBuckets - 1 ); edge *= 2)
+        ++b;
+
+    Histogram& h = histograms[f][slot];
+    ++h.buckets[b];
+    ++h.count;
+    h.sum += static_cast<uint64_t>(seconds * 1e9);
+}
+
+void WrapperStats::accumulate(const Histogram& h, Summary& s, uint64_t& sum)
+{
+    for (std::size_t b(0); b < NumBuckets; ++b)
+        s.buckets.at(b) += h.buckets[b].load();
+
+    s.count += h.count.load();
+    sum     += h.sum.load();
+}
+
+void WrapperStats::finish(Summary& s, uint64_t sum)
+{
+    s.mean = s.count ? ( sum * 1e-9 / s.count ) : 0;
+    s.p99  = 0;
+
+    // Upper edge of the bucket where 99% of the calls is reached
+    uint64_t target = ( s.count * 99 + 99 ) / 100;
+    uint64_t cumulative(0);
+    for (std::size_t b(0); ( b < NumBuckets ) && ( s.count > 0 ); ++b)
+    {
+        cumulative += s.buckets.at(b);
+        if (cumulative >= target)
+        {
+            s.p99 = getBucketEdge(b);
+            break;
+        }
+    }
+}
+
+WrapperStats::Summary WrapperStats::getFunction(Function f) const
+{
+    Summary  s = { 0, 0, 0, std::vector<uint32_t>(NumBuckets, 0) };
+    uint64_t sum(0);
+
+    for (std::size_t slot(0); slot <= MaxSlots; ++slot)
+        accumulate(histograms[f][slot], s, sum);
+
+    finish(s, sum);
+    return s;
+}
+
+WrapperStats::Summary WrapperStats::getSlot(std::size_t slot) const
+{
+    Summary  s = { 0, 0, 0, std::vector<uint32_t>(NumBuckets, 0) };
+    uint64_t sum(0);
+
+    if (slot > MaxSlots)
+        slot = NoSlot;
+
+    for (std::size_t f(0); f < NumFunctions; ++f)
+        accumulate(histograms[f][slot], s, sum);
+
+    finish(s, sum);
+    return s;
+}
+
+void WrapperStats::reset()
+{
+    for (std::size_t f(0); f < NumFunctions; ++f)
+    {
+        for (std::size_t slot(0); slot <= MaxSlots; ++slot)
+        {
+            Histogram& h = histograms[f][slot];
+
+            for (std::size_t b(0); b < NumBuckets; ++b)
+                h.buckets[b] = 0;
+
+            h.count = 0;
+            h.sum   = 0;
+        }
+    }
+}
+
+const char* WrapperStats::getFunctionName(Function f)
+{
+    return functionNames[f];
+}
+
+double WrapperStats::getBucketEdge(std::size_t bucket)
+{
+    // The last bucket has no upper edge: return the one it would have
+    double edge(BucketBase);
+    for (std::size_t b(0); b < bucket; ++b)
+        edge *= 2;
+
+    return edge;
+}
@@ -0,0 +1,137 @@
+#ifndef WRAPPER_STATS_H
+#define WRAPPER_STATS_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : wrapper_stats.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Latency histograms of the calls to the CAEN HV Wrapper library
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+#include "CAENHVWrapper.h"
+#include "event_trace.h"
+
+class WrapperStats;
+
+typedef std::shared_ptr<WrapperStats> Stats;
+
+// Latency statistics of the wrapper calls done on a crate, per wrapper
+// function and per slot. Each latency is accumulated in a histogram with
+// logarithmic buckets: bucket 0 holds calls faster than 'BucketBase', and
+// each next bucket doubles the upper edge. The last bucket has no upper edge.
+//
+// The crate creates one instance and shares it with all its boards, channels
+// and properties, so it stays the same when the crate is reinitialized.
+// Recording a call is lock-free, so it can be done from any thread.
+class WrapperStats
+{
+public:
+    // Wrapper functions
+    enum Function
+    {
+        InitSystem,
+        DeinitSystem,
+        GetCrateMap,
+        GetSysPropList,
+        GetSysPropInfo,
+        GetSysProp,
+        SetSysProp,
+        GetBdParamInfo,
+        GetBdParamProp,
+        GetBdParam,
+        SetBdParam,
+        GetChParamInfo,
+        GetChParamProp,
+        GetChParam,
+        SetChParam,
+        GetChName,
+        SetChName,
+        NumFunctions
+    };
+
+    static const std::size_t NumBuckets = 20;
+    static const std::size_t MaxSlots   = 32;
+    // Slot used for calls not related to a board
+    static const std::size_t NoSlot     = MaxSlots;
+
+    // Upper edge of the first bucket, in seconds
+    static constexpr double BucketBase = 10e-6;
+
+    // Summary of a histogram
+    struct Summary
+    {
+        uint32_t              count;
+        double                mean; // seconds
+        double                p99;  // seconds, upper edge of the bucket
+        std::vector<uint32_t> buckets;
+    };
+
+    WrapperStats();
+
+    // Record a call of 'f' on 'slot', which took 'seconds'
+    void record(Function f, std::size_t slot, double seconds);
+
+    // Statistics of a function, for all slots, and of a slot, for all functions
+    Summary getFunction(Function f) const;
+    Summary getSlot(std::size_t slot) const;
+
+    void reset();
+
+    // Function name, without the 'CAENHV_' prefix
+    static const char* getFunctionName(Function f);
+
+    // Upper edge of a bucket, in seconds
+    static double getBucketEdge(std::size_t bucket);
+
+private:
+    struct Histogram
+    {
+        std::atomic<uint32_t> buckets[NumBuckets];
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> sum;  // ns
+    };
+
+    // Add 'h' to the summary 's'
+    static void accumulate(const Histogram& h, Summary& s, uint64_t& sum);
+    static void finish(Summary& s, uint64_t sum);
+
+    // Indexed by [function][slot]
+    Histogram histograms[NumFunctions][MaxSlots + 1];
+};
+
+// Call a wrapper function, recording its latency in 'stats'
+template <typename F>
+CAENHVRESULT timedCall(const Stats& stats, WrapperStats::Function f, std::size_t slot, F call)
+{
+    EVENT_TRACE_BEGIN("wrapper", WrapperStats::getFunctionName(f), slot);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    CAENHVRESULT r = call();
+    std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+    EVENT_TRACE_END("wrapper", WrapperStats::getFunctionName(f), slot);
+
+    stats->record(f, slot, d.count());
+
+    return r;
+}
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef CAENHVWRAPPERTRACE_H
+#define CAENHVWRAPPERTRACE_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : CAENHVWrapperTrace.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Control interface of the record and replay CAEN HV Wrapper library
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Record all the calls to the CAEN HV Wrapper library in 'fileName',
+// replacing the current recording or replay. Returns 0 on success.
+int CAENHVTrace_Record(const char *fileName);
+
+// Serve all the calls from the trace in 'fileName' instead of the CAEN HV
+// Wrapper library, replacing the current recording or replay. With 'speed'
+// equal to 1 the calls take their original duration and return the values
+// recorded at the same time since the start of the trace; with 'speed'
+// greater than 1 the trace is played that many times faster. With 'speed'
+// equal to 0 the calls don't wait, and the recorded results of each call
+// are returned in order. Returns 0 on success.
+int CAENHVTrace_Replay(const char *fileName, double speed);
+
+// Stop the recording or replay, and go back to calling the library directly.
+void CAENHVTrace_Stop(void);
+
+// Number of calls which were not found in the trace during the replay.
+unsigned long CAENHVTrace_GetUnmatched(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
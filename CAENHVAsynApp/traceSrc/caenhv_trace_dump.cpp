@@ -0,0 +1,167 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : caenhv_trace_dump.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Prints the calls, or a per-function summary, of a CAEN HV Wrapper call
+ * trace file.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <getopt.h>
+#include "trace_file.h"
+
+namespace
+{
+    // Per-function summary
+    struct Summary
+    {
+        Summary() : count(0), errors(0), total(0), max(0), bytes(0) {};
+
+        unsigned long count;
+        unsigned long errors;
+        double        total; // s
+        double        max;   // s
+        unsigned long bytes;
+    };
+
+    void usage(const char* name)
+    {
+        std::cout << "Usage: " << name << " [options] FILE" << std::endl;
+        std::cout << "  -s, --summary             Only print the per-function summary" << std::endl;
+        std::cout << "  -h, --help                Show this message" << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    bool summaryOnly(false);
+
+    static struct option longOptions[] =
+    {
+        { "summary", no_argument, 0, 's' },
+        { "help",    no_argument, 0, 'h' },
+        { 0,         0,           0, 0   }
+    };
+
+    int c;
+    while ( ( c = getopt_long(argc, argv, "sh", longOptions, NULL) ) != -1 )
+    {
+        switch (c)
+        {
+            case 's':
+                summaryOnly = true;
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (optind != argc - 1)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    TraceReader reader;
+    if (!reader.open(argv[optind]))
+    {
+        std::cerr << "'" << argv[optind] << "' is not a trace file" << std::endl;
+        return 1;
+    }
+
+    std::vector<Summary> summaries(TraceNumFunctions + 1);
+    double        end(0);
+    unsigned long count(0);
+
+    std::cout << std::fixed;
+
+    if (!summaryOnly)
+        std::cout << std::setw(14) << "Time (s)" << "  " << std::left << std::setw(24) << "Function" << std::right
+                  << std::setw(8) << "Result" << std::setw(14) << "Duration (ms)" << std::setw(10) << "In (B)"
+                  << std::setw(10) << "Out (B)" << std::endl;
+
+    try
+    {
+        TraceRecord r;
+        while (reader.read(r))
+        {
+            double start    = r.start * 1e-9;
+            double duration = r.duration * 1e-9;
+
+            Summary& s = summaries.at(std::min<unsigned>(r.function, TraceNumFunctions));
+            ++s.count;
+            s.total += duration;
+            s.max    = std::max(s.max, duration);
+            s.bytes += r.input.size() + r.output.size();
+            if (r.result)
+                ++s.errors;
+
+            end = std::max(end, start + duration);
+            ++count;
+
+            if (!summaryOnly)
+            {
+                std::cout << std::setw(14) << std::setprecision(6) << start << "  "
+                          << std::left << std::setw(24) << traceFunctionName(r.function) << std::right
+                          << std::setw(8) << r.result
+                          << std::setw(14) << std::setprecision(3) << duration * 1e3
+                          << std::setw(10) << r.input.size()
+                          << std::setw(10) << r.output.size();
+
+                if (r.result)
+                    std::cout << "  " << r.output;
+
+                std::cout << std::endl;
+            }
+        }
+    }
+    catch(std::runtime_error& e)
+    {
+        std::cerr << "'" << argv[optind] << "': " << e.what() << std::endl;
+    }
+
+    if (!summaryOnly)
+        std::cout << std::endl;
+
+    std::cout << "Calls: " << count << ", duration: " << std::setprecision(3) << end << " s, rate: "
+              << ( ( end > 0 ) ? count / end : 0 ) << " calls/s" << std::endl;
+    std::cout << std::left << std::setw(24) << "Function" << std::right << std::setw(10) << "Calls" << std::setw(10) << "Errors"
+              << std::setw(12) << "Mean (ms)" << std::setw(12) << "Max (ms)" << std::setw(12) << "Bytes" << std::endl;
+
+    for (std::size_t f(0); f <= TraceNumFunctions; ++f)
+    {
+        const Summary& s = summaries.at(f);
+        if (!s.count)
+            continue;
+
+        std::cout << std::left << std::setw(24) << traceFunctionName(f) << std::right
+                  << std::setw(10) << s.count
+                  << std::setw(10) << s.errors
+                  << std::setw(12) << s.total * 1e3 / s.count
+                  << std::setw(12) << s.max * 1e3
+                  << std::setw(12) << s.bytes << std::endl;
+    }
+
+    return 0;
+}
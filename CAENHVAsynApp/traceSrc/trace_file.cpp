@@ -0,0 +1,220 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : trace_file.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Binary file format of the CAEN HV Wrapper call traces
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include "trace_file.h"
+
+namespace
+{
+    const char     magic[4] = { 'C', 'H', 'V', 'T' };
+    const uint32_t version  = 1;
+
+    const char* functionNames[TraceNumFunctions] =
+    {
+        "CAENHV_InitSystem",
+        "CAENHV_DeinitSystem",
+        "CAENHV_GetCrateMap",
+        "CAENHV_GetSysPropList",
+        "CAENHV_GetSysPropInfo",
+        "CAENHV_GetSysProp",
+        "CAENHV_SetSysProp",
+        "CAENHV_GetBdParamInfo",
+        "CAENHV_GetBdParamProp",
+        "CAENHV_GetBdParam",
+        "CAENHV_SetBdParam",
+        "CAENHV_GetChParamInfo",
+        "CAENHV_GetChParamProp",
+        "CAENHV_GetChParam",
+        "CAENHV_SetChParam",
+        "CAENHV_GetChName",
+        "CAENHV_SetChName",
+    };
+
+    template<typename T>
+    bool readValue(FILE* f, T& v)
+    {
+        return fread(&v, sizeof(T), 1, f) == 1;
+    }
+
+    bool readBlock(FILE* f, std::string& s)
+    {
+        uint32_t n;
+        if (!readValue(f, n))
+            return false;
+
+        s.resize(n);
+        return ( n == 0 ) || ( fread(&s[0], 1, n, f) == n );
+    }
+}
+
+const char* traceFunctionName(unsigned f)
+{
+    return ( f < TraceNumFunctions ) ? functionNames[f] : "Unknown";
+}
+
+void TraceEncoder::putBytes(const void* p, std::size_t n)
+{
+    put<uint32_t>(n);
+    data.append(static_cast<const char*>(p), n);
+}
+
+void TraceEncoder::putString(const char* s)
+{
+    putBytes(s, s ? strlen(s) : 0);
+}
+
+TraceDecoder::TraceDecoder(const std::string& d)
+:
+    data(d),
+    pos(0)
+{
+}
+
+void TraceDecoder::check(std::size_t n) const
+{
+    if (pos + n > data.size())
+        throw std::runtime_error("Trace record is shorter than expected");
+}
+
+std::size_t TraceDecoder::getBytes(void* p)
+{
+    uint32_t n = get<uint32_t>();
+    check(n);
+    memcpy(p, data.data() + pos, n);
+    pos += n;
+    return n;
+}
+
+std::string TraceDecoder::getString()
+{
+    uint32_t n = get<uint32_t>();
+    check(n);
+    std::string s(data, pos, n);
+    pos += n;
+    return s;
+}
+
+TraceWriter::TraceWriter()
+:
+    file(NULL)
+{
+}
+
+TraceWriter::~TraceWriter()
+{
+    close();
+}
+
+bool TraceWriter::open(const std::string& fileName, double startTime)
+{
+    close();
+
+    file = fopen(fileName.c_str(), "wb");
+    if (!file)
+        return false;
+
+    fwrite(magic, sizeof(magic), 1, file);
+    fwrite(&version, sizeof(version), 1, file);
+    fwrite(&startTime, sizeof(startTime), 1, file);
+
+    return true;
+}
+
+void TraceWriter::write(const TraceRecord& r)
+{
+    if (!file)
+        return;
+
+    uint32_t inSize(r.input.size()), outSize(r.output.size());
+
+    fwrite(&r.function, sizeof(r.function), 1, file);
+    fwrite(&r.result,   sizeof(r.result),   1, file);
+    fwrite(&r.start,    sizeof(r.start),    1, file);
+    fwrite(&r.duration, sizeof(r.duration), 1, file);
+    fwrite(&inSize,     sizeof(inSize),     1, file);
+    fwrite(r.input.data(), 1, inSize, file);
+    fwrite(&outSize,    sizeof(outSize),    1, file);
+    fwrite(r.output.data(), 1, outSize, file);
+
+    // Keep the file complete up to the last call, in case the IOC dies
+    fflush(file);
+}
+
+void TraceWriter::close()
+{
+    if (file)
+        fclose(file);
+
+    file = NULL;
+}
+
+TraceReader::TraceReader()
+:
+    file(NULL),
+    startTime(0)
+{
+}
+
+TraceReader::~TraceReader()
+{
+    close();
+}
+
+bool TraceReader::open(const std::string& fileName)
+{
+    close();
+
+    file = fopen(fileName.c_str(), "rb");
+    if (!file)
+        return false;
+
+    char     m[4];
+    uint32_t v;
+
+    if ( ( fread(m, sizeof(m), 1, file) != 1 ) || memcmp(m, magic, sizeof(m)) ||
+         ( !readValue(file, v) ) || ( v != version ) ||
+         ( !readValue(file, startTime) ) )
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool TraceReader::read(TraceRecord& r)
+{
+    if ( ( !file ) || ( !readValue(file, r.function) ) )
+        return false;
+
+    if ( ( !readValue(file, r.result) ) || ( !readValue(file, r.start) ) || ( !readValue(file, r.duration) ) ||
+         ( !readBlock(file, r.input) ) || ( !readBlock(file, r.output) ) )
+        throw std::runtime_error("Truncated trace record");
+
+    return true;
+}
+
+void TraceReader::close()
+{
+    if (file)
+        fclose(file);
+
+    file = NULL;
+}
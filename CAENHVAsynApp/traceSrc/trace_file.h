@@ -0,0 +1,164 @@
+#ifndef TRACE_FILE_H
+#define TRACE_FILE_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : trace_file.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Binary file format of the CAEN HV Wrapper call traces
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <stdexcept>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+// A trace file starts with a header:
+//   char[4]  magic ("CHVT")
+//   uint32   version
+//   double   start time, in seconds since the Unix epoch
+// followed by one record per call:
+//   uint8    function
+//   int32    result
+//   uint64   start of the call, in ns since the start of the trace
+//   uint32   duration, in ns
+//   uint32   input size,  followed by the serialized arguments
+//   uint32   output size, followed by the serialized results, or by the
+//            error message when the call failed
+// All the values are in the byte order of the host which wrote the file.
+
+// Wrapper functions in a trace
+enum TraceFunction
+{
+    TraceInitSystem,
+    TraceDeinitSystem,
+    TraceGetCrateMap,
+    TraceGetSysPropList,
+    TraceGetSysPropInfo,
+    TraceGetSysProp,
+    TraceSetSysProp,
+    TraceGetBdParamInfo,
+    TraceGetBdParamProp,
+    TraceGetBdParam,
+    TraceSetBdParam,
+    TraceGetChParamInfo,
+    TraceGetChParamProp,
+    TraceGetChParam,
+    TraceSetChParam,
+    TraceGetChName,
+    TraceSetChName,
+    TraceNumFunctions
+};
+
+// Function name, with the 'CAENHV_' prefix
+const char* traceFunctionName(unsigned f);
+
+// One wrapper call
+struct TraceRecord
+{
+    uint8_t     function;
+    int32_t     result;
+    uint64_t    start;    // ns since the start of the trace
+    uint32_t    duration; // ns
+    std::string input;
+    std::string output;
+};
+
+// Serializes the arguments or the results of a call
+class TraceEncoder
+{
+public:
+    template<typename T>
+    void put(T v) { data.append(reinterpret_cast<const char*>(&v), sizeof(T)); };
+
+    // Byte arrays and strings are preceded by their length, as uint32
+    void putBytes(const void* p, std::size_t n);
+    void putString(const char* s);
+
+    const std::string& str() const { return data; };
+
+private:
+    std::string data;
+};
+
+// Reads back the data serialized by a TraceEncoder. It throws a
+// std::runtime_error if the data is shorter than expected.
+class TraceDecoder
+{
+public:
+    explicit TraceDecoder(const std::string& d);
+
+    template<typename T>
+    T get()
+    {
+        T v;
+        check(sizeof(T));
+        memcpy(&v, data.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return v;
+    };
+
+    // Copies the next byte array to 'p', returning its length
+    std::size_t getBytes(void* p);
+    std::string getString();
+
+private:
+    void check(std::size_t n) const;
+
+    const std::string& data;
+    std::size_t        pos;
+};
+
+class TraceWriter
+{
+public:
+    TraceWriter();
+    ~TraceWriter();
+
+    // Creates the file and writes the header. Returns false on error.
+    bool open(const std::string& fileName, double startTime);
+    void write(const TraceRecord& r);
+    void close();
+
+private:
+    FILE* file;
+};
+
+class TraceReader
+{
+public:
+    TraceReader();
+    ~TraceReader();
+
+    // Opens the file and reads the header. Returns false on error, or if
+    // the file is not a trace.
+    bool open(const std::string& fileName);
+
+    // Reads the next record. Returns false at the end of the file, and
+    // throws a std::runtime_error if the last record is truncated.
+    bool read(TraceRecord& r);
+    void close();
+
+    double getStartTime() const { return startTime; };
+
+private:
+    FILE*  file;
+    double startTime;
+};
+
+#endif
@@ -0,0 +1,941 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : trace_wrapper.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Record and replay CAEN HV Wrapper library. It implements the subset of the
+ * CAEN HV Wrapper API used by this module, forwarding the calls to the CAEN
+ * library (loaded at run time) while recording them to a trace file, or
+ * serving them from a previously recorded trace file.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <map>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+#include <stdlib.h>
+#include <dlfcn.h>
+#include "CAENHVWrapper.h"
+#include "CAENHVWrapperTrace.h"
+#include "trace_file.h"
+
+namespace
+{
+    typedef std::chrono::steady_clock TraceClock;
+
+    enum Mode
+    {
+        PassThrough,
+        Record,
+        Replay
+    };
+
+    // Functions of the CAEN HV Wrapper library
+    struct Library
+    {
+        decltype(&CAENHV_InitSystem)     InitSystem;
+        decltype(&CAENHV_DeinitSystem)   DeinitSystem;
+        decltype(&CAENHV_GetError)       GetError;
+        decltype(&CAENHV_Free)           Free;
+        decltype(&CAENHV_GetCrateMap)    GetCrateMap;
+        decltype(&CAENHV_GetSysPropList) GetSysPropList;
+        decltype(&CAENHV_GetSysPropInfo) GetSysPropInfo;
+        decltype(&CAENHV_GetSysProp)     GetSysProp;
+        decltype(&CAENHV_SetSysProp)     SetSysProp;
+        decltype(&CAENHV_GetBdParamInfo) GetBdParamInfo;
+        decltype(&CAENHV_GetBdParamProp) GetBdParamProp;
+        decltype(&CAENHV_GetBdParam)     GetBdParam;
+        decltype(&CAENHV_SetBdParam)     SetBdParam;
+        decltype(&CAENHV_GetChParamInfo) GetChParamInfo;
+        decltype(&CAENHV_GetChParamProp) GetChParamProp;
+        decltype(&CAENHV_GetChParam)     GetChParam;
+        decltype(&CAENHV_SetChParam)     SetChParam;
+        decltype(&CAENHV_GetChName)      GetChName;
+        decltype(&CAENHV_SetChName)      SetChName;
+    };
+
+    // Recorded results of a call with a given set of arguments, sorted by time
+    struct Responses
+    {
+        std::vector<TraceRecord> records;
+        std::size_t              next;    // Next one to return, when the speed is 0
+    };
+
+    const char* successMessage = "Command Successfully Executed";
+
+    // Global state
+    std::mutex                         stateMutex;
+    bool                               initialized(false);
+    Mode                               mode(PassThrough);
+    void*                              libHandle(NULL);
+    bool                               libTried(false);
+    std::atomic<bool>                  libLoaded(false);
+    Library                            lib;
+    TraceWriter                        writer;
+    TraceClock::time_point             traceStart;
+    double                             speed(1);
+    std::map<std::string, Responses>   responses;      // Indexed by function and arguments
+    std::map<int, std::string>         replayErrors;   // Last error message of each handle, during the replay
+    std::map<std::string, unsigned>    sysPropTypes;   // Types of the system properties, to know their size
+    unsigned long                      unmatched(0);
+
+    template<typename F>
+    bool loadSymbol(F& f, const char* name)
+    {
+        f = reinterpret_cast<F>(dlsym(libHandle, name));
+        if (!f)
+            std::cerr << "CAENHVWrapperTrace: symbol '" << name << "' not found: " << dlerror() << std::endl;
+
+        return f != NULL;
+    }
+
+    // Load the CAEN HV Wrapper library. Must be called with the state mutex held.
+    bool loadLibrary()
+    {
+        if (libLoaded)
+            return true;
+
+        // Only try once, instead of on every call
+        if (libTried)
+            return false;
+
+        libTried = true;
+
+        const char* name = getenv("CAENHVTRACE_LIBRARY");
+        if (!name)
+            name = "libcaenhvwrapper.so";
+
+        // The library must use its own functions, and not the ones with the
+        // same name defined here
+        int flags = RTLD_NOW | RTLD_LOCAL;
+#ifdef RTLD_DEEPBIND
+        flags |= RTLD_DEEPBIND;
+#endif
+
+        libHandle = dlopen(name, flags);
+        if (!libHandle)
+        {
+            std::cerr << "CAENHVWrapperTrace: can not load '" << name << "': " << dlerror() << std::endl;
+            return false;
+        }
+
+        libLoaded = loadSymbol(lib.InitSystem,     "CAENHV_InitSystem")     &&
+                    loadSymbol(lib.DeinitSystem,   "CAENHV_DeinitSystem")   &&
+                    loadSymbol(lib.GetError,       "CAENHV_GetError")       &&
+                    loadSymbol(lib.Free,           "CAENHV_Free")           &&
+                    loadSymbol(lib.GetCrateMap,    "CAENHV_GetCrateMap")    &&
+                    loadSymbol(lib.GetSysPropList, "CAENHV_GetSysPropList") &&
+                    loadSymbol(lib.GetSysPropInfo, "CAENHV_GetSysPropInfo") &&
+                    loadSymbol(lib.GetSysProp,     "CAENHV_GetSysProp")     &&
+                    loadSymbol(lib.SetSysProp,     "CAENHV_SetSysProp")     &&
+                    loadSymbol(lib.GetBdParamInfo, "CAENHV_GetBdParamInfo") &&
+                    loadSymbol(lib.GetBdParamProp, "CAENHV_GetBdParamProp") &&
+                    loadSymbol(lib.GetBdParam,     "CAENHV_GetBdParam")     &&
+                    loadSymbol(lib.SetBdParam,     "CAENHV_SetBdParam")     &&
+                    loadSymbol(lib.GetChParamInfo, "CAENHV_GetChParamInfo") &&
+                    loadSymbol(lib.GetChParamProp, "CAENHV_GetChParamProp") &&
+                    loadSymbol(lib.GetChParam,     "CAENHV_GetChParam")     &&
+                    loadSymbol(lib.SetChParam,     "CAENHV_SetChParam")     &&
+                    loadSymbol(lib.GetChName,      "CAENHV_GetChName")      &&
+                    loadSymbol(lib.SetChName,      "CAENHV_SetChName");
+
+        return libLoaded;
+    }
+
+    // Must be called with the state mutex held
+    void stop()
+    {
+        writer.close();
+        responses.clear();
+        replayErrors.clear();
+        mode = PassThrough;
+    }
+
+    // Must be called with the state mutex held
+    bool startRecord(const std::string& fileName)
+    {
+        stop();
+
+        if (!loadLibrary())
+            return false;
+
+        std::chrono::duration<double> now = std::chrono::system_clock::now().time_since_epoch();
+        if (!writer.open(fileName, now.count()))
+        {
+            std::cerr << "CAENHVWrapperTrace: can not create '" << fileName << "'" << std::endl;
+            return false;
+        }
+
+        traceStart = TraceClock::now();
+        mode       = Record;
+
+        return true;
+    }
+
+    // Must be called with the state mutex held
+    bool startReplay(const std::string& fileName, double s)
+    {
+        stop();
+
+        TraceReader reader;
+        if (!reader.open(fileName))
+        {
+            std::cerr << "CAENHVWrapperTrace: '" << fileName << "' is not a trace file" << std::endl;
+            return false;
+        }
+
+        try
+        {
+            TraceRecord r;
+            while (reader.read(r))
+            {
+                Responses& rs = responses[std::string(1, r.function) + r.input];
+                rs.records.push_back(r);
+                rs.next = 0;
+            }
+        }
+        catch(std::runtime_error& e)
+        {
+            // Use the records before the truncated one
+            std::cerr << "CAENHVWrapperTrace: '" << fileName << "': " << e.what() << std::endl;
+        }
+
+        // The calls are written when they finish, so calls from different
+        // threads can be out of order
+        for (std::map<std::string, Responses>::iterator it = responses.begin(); it != responses.end(); ++it)
+            std::stable_sort(it->second.records.begin(), it->second.records.end(),
+                [](const TraceRecord& a, const TraceRecord& b) { return a.start < b.start; });
+
+        speed      = ( s > 0 ) ? s : 0;
+        unmatched  = 0;
+        traceStart = TraceClock::now();
+        mode       = Replay;
+
+        return true;
+    }
+
+    // Must be called with the state mutex held
+    void init()
+    {
+        if (initialized)
+            return;
+
+        initialized = true;
+
+        const char* replay = getenv("CAENHVTRACE_REPLAY");
+        const char* record = getenv("CAENHVTRACE_RECORD");
+        const char* s      = getenv("CAENHVTRACE_SPEED");
+
+        if (replay)
+            startReplay(replay, s ? atof(s) : 1);
+        else if (record)
+            startRecord(record);
+    }
+
+    uint64_t elapsedNs(TraceClock::time_point t)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t - traceStart).count();
+    }
+
+    // Size of the value of a system property
+    std::size_t sysPropSize(const char* name, const void* value)
+    {
+        unsigned type(SYSPROP_TYPE_UINT4);
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            std::map<std::string, unsigned>::const_iterator it = sysPropTypes.find(name);
+            if (it != sysPropTypes.end())
+                type = it->second;
+        }
+
+        switch (type)
+        {
+            case SYSPROP_TYPE_STR:   return strlen(static_cast<const char*>(value)) + 1;
+            case SYSPROP_TYPE_UINT2: return sizeof(uint16_t);
+            case SYSPROP_TYPE_INT2:  return sizeof(int16_t);
+            default:                 return sizeof(uint32_t);
+        }
+    }
+
+    // Size of the value of a board or channel parameter property
+    std::size_t paramPropSize(const char* propName, const void* value)
+    {
+        std::string p(propName);
+
+        if ( ( p == "Onstate" ) || ( p == "Offstate" ) )
+            return strlen(static_cast<const char*>(value)) + 1;
+
+        if ( ( p == "Unit" ) || ( p == "Exp" ) )
+            return sizeof(uint16_t);
+
+        return sizeof(uint32_t);
+    }
+
+    // Size of a list of fixed length names, terminated with an empty name
+    std::size_t nameArraySize(const char* list)
+    {
+        std::size_t n(0);
+        while (list[n * MAX_PARAM_NAME])
+            ++n;
+
+        return ( n + 1 ) * MAX_PARAM_NAME;
+    }
+
+    // Size of a list of 'n' consecutive null terminated strings
+    std::size_t stringListSize(const char* list, std::size_t n)
+    {
+        const char* p(list);
+        for (std::size_t i(0); i < n; ++i)
+            p += strlen(p) + 1;
+
+        return p - list;
+    }
+
+    template<typename T>
+    T* copyToHeap(const std::string& s)
+    {
+        // Empty lists still need a valid pointer, which is freed by the caller
+        T* p = static_cast<T*>(malloc(s.size() + 1));
+        memcpy(p, s.data(), s.size());
+        reinterpret_cast<char*>(p)[s.size()] = '\0';
+        return p;
+    }
+
+    // A call to the library, which is forwarded and recorded, or replayed,
+    // depending on the current mode. The arguments which identify the call
+    // are serialized in 'in', and the results in 'out'.
+    class Call
+    {
+    public:
+        Call(TraceFunction f)
+        :
+            function(f),
+            result(CAENHV_OK),
+            startNs(0),
+            durationNs(0)
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            init();
+            m = mode;
+        };
+
+        bool replaying() const { return m == Replay;     };
+        bool recording() const { return m == Record;     };
+        bool active()    const { return m != PassThrough; };
+
+        // Find the recorded call with the arguments in 'in', wait for its
+        // duration and return its result. Its results are in 'reply'.
+        CAENHVRESULT replay(int handle)
+        {
+            double wait(0);
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+
+                std::map<std::string, Responses>::iterator it = responses.find(std::string(1, function) + in.str());
+                if ( it == responses.end() )
+                {
+                    ++unmatched;
+                    replayErrors[handle] = std::string(traceFunctionName(function)) + ": call not found in the trace";
+                    return CAENHV_SYSERR;
+                }
+
+                std::vector<TraceRecord>& records = it->second.records;
+                std::size_t i;
+
+                if (speed > 0)
+                {
+                    // The last one started before the current time in the trace
+                    uint64_t t = static_cast<uint64_t>(elapsedNs(TraceClock::now()) * speed);
+                    for (i = 0; ( i + 1 < records.size() ) && ( records.at(i + 1).start <= t ); ++i);
+
+                    wait = records.at(i).duration * 1e-9 / speed;
+                }
+                else
+                {
+                    i = std::min(it->second.next, records.size() - 1);
+                    ++it->second.next;
+                }
+
+                result = records.at(i).result;
+                reply  = records.at(i).output;
+            }
+
+            if (wait > 0)
+                std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+
+            setReplayError(handle);
+
+            return result;
+        };
+
+        // Read the results of a replayed call. A record which doesn't match
+        // the call makes it fail.
+        template<typename F>
+        void decode(F f)
+        {
+            try
+            {
+                TraceDecoder d(reply);
+                f(d);
+            }
+            catch(std::runtime_error& e)
+            {
+                result = CAENHV_SYSERR;
+                reply  = std::string(traceFunctionName(function)) + ": " + e.what();
+            }
+        };
+
+        // Set the error message returned by CAENHV_GetError, after a replay
+        void setReplayError(int handle)
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            replayErrors[handle] = ( result == CAENHV_OK ) ? successMessage : reply;
+        };
+
+        // Call the library, timing the call
+        template<typename F>
+        CAENHVRESULT call(F f)
+        {
+            if (!libLoaded)
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                if (!loadLibrary())
+                    return result = CAENHV_SYSERR;
+            }
+
+            TraceClock::time_point t = TraceClock::now();
+            result = f();
+            TraceClock::time_point end = TraceClock::now();
+
+            if (recording())
+            {
+                startNs    = elapsedNs(t);
+                durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - t).count();
+            }
+
+            return result;
+        };
+
+        // Write the call to the trace, when recording
+        CAENHVRESULT done(int handle)
+        {
+            if (!recording())
+                return result;
+
+            TraceRecord r;
+            r.function = function;
+            r.result   = result;
+            r.start    = startNs;
+            r.duration = durationNs;
+            r.input    = in.str();
+            r.output   = ( result == CAENHV_OK ) ? out.str() : std::string(lib.GetError(handle));
+
+            std::lock_guard<std::mutex> lock(stateMutex);
+            if (mode == Record)
+                writer.write(r);
+
+            return result;
+        };
+
+        TraceEncoder in;
+        TraceEncoder out;
+        std::string  reply;
+
+    private:
+        TraceFunction function;
+        Mode          m;
+        CAENHVRESULT  result;
+        uint64_t      startNs;
+        uint32_t      durationNs;
+    };
+}
+
+// Control interface
+int CAENHVTrace_Record(const char *fileName)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    initialized = true;
+    return startRecord(fileName) ? 0 : -1;
+}
+
+int CAENHVTrace_Replay(const char *fileName, double speed)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    initialized = true;
+    return startReplay(fileName, speed) ? 0 : -1;
+}
+
+void CAENHVTrace_Stop(void)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    initialized = true;
+    stop();
+}
+
+unsigned long CAENHVTrace_GetUnmatched(void)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return unmatched;
+}
+
+// CAEN HV Wrapper API
+CAENHVRESULT CAENHV_InitSystem(CAENHV_SYSTEM_TYPE_t system, int LinkType, void *Arg, const char *UserName, const char *Passwd, int *handle)
+{
+    Call c(TraceInitSystem);
+
+    // The password is not recorded
+    if (c.active())
+    {
+        c.in.put<int32_t>(system);
+        c.in.put<int32_t>(LinkType);
+        c.in.putString( ( LinkType == LINKTYPE_TCPIP ) ? static_cast<const char*>(Arg) : "" );
+        c.in.putString(UserName);
+    }
+
+    if (c.replaying())
+    {
+        // The handles are the recorded ones, so the rest of the calls match
+        *handle = -1;
+        if (c.replay(-1) == CAENHV_OK)
+            c.decode([&](TraceDecoder& d) { *handle = d.get<int32_t>(); });
+
+        c.setReplayError(*handle);
+        return c.done(*handle);
+    }
+
+    c.call([&]() { return lib.InitSystem(system, LinkType, Arg, UserName, Passwd, handle); });
+    c.out.put<int32_t>(*handle);
+    return c.done(*handle);
+}
+
+CAENHVRESULT CAENHV_DeinitSystem(int handle)
+{
+    Call c(TraceDeinitSystem);
+
+    if (c.active())
+        c.in.put<int32_t>(handle);
+
+    if (c.replaying())
+        return c.replay(handle);
+
+    c.call([&]() { return lib.DeinitSystem(handle); });
+    return c.done(handle);
+}
+
+char* CAENHV_GetError(int handle)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    init();
+
+    if (mode == Replay)
+    {
+        std::map<int, std::string>::iterator it = replayErrors.find(handle);
+        if (it == replayErrors.end())
+            it = replayErrors.insert(std::make_pair(handle, std::string("Invalid handle"))).first;
+
+        return const_cast<char*>(it->second.c_str());
+    }
+
+    if (!loadLibrary())
+        return const_cast<char*>("CAEN HV Wrapper library not loaded");
+
+    return lib.GetError(handle);
+}
+
+CAENHVRESULT CAENHV_Free(void *arg)
+{
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if ( ( mode != Replay ) && libLoaded )
+            return lib.Free(arg);
+    }
+
+    free(arg);
+    return CAENHV_OK;
+}
+
+CAENHVRESULT CAENHV_GetCrateMap(int handle, unsigned short *NrOfSlot, unsigned short **NrofChList, char **ModelList, char **DescriptionList, unsigned short **SerNumList, unsigned char **FmwRelMinList, unsigned char **FmwRelMaxList)
+{
+    Call c(TraceGetCrateMap);
+
+    if (c.active())
+        c.in.put<int32_t>(handle);
+
+    if (c.replaying())
+    {
+        if (c.replay(handle) == CAENHV_OK)
+            c.decode([&](TraceDecoder& d)
+            {
+                *NrOfSlot        = d.get<uint16_t>();
+                *NrofChList      = copyToHeap<unsigned short>(d.getString());
+                *ModelList       = copyToHeap<char>(d.getString());
+                *DescriptionList = copyToHeap<char>(d.getString());
+                *SerNumList      = copyToHeap<unsigned short>(d.getString());
+                *FmwRelMinList   = copyToHeap<unsigned char>(d.getString());
+                *FmwRelMaxList   = copyToHeap<unsigned char>(d.getString());
+            });
+        return c.done(handle);
+    }
+
+    if ( ( c.call([&]() { return lib.GetCrateMap(handle, NrOfSlot, NrofChList, ModelList, DescriptionList, SerNumList, FmwRelMinList, FmwRelMaxList); }) == CAENHV_OK ) && c.recording() )
+    {
+        std::size_t n(*NrOfSlot);
+        c.out.put<uint16_t>(n);
+        c.out.putBytes(*NrofChList,      n * sizeof(unsigned short));
+        c.out.putBytes(*ModelList,       stringListSize(*ModelList, n));
+        c.out.putBytes(*DescriptionList, stringListSize(*DescriptionList, n));
+        c.out.putBytes(*SerNumList,      n * sizeof(unsigned short));
+        c.out.putBytes(*FmwRelMinList,   n * sizeof(unsigned char));
+        c.out.putBytes(*FmwRelMaxList,   n * sizeof(unsigned char));
+    }
+    return c.done(handle);
+}
+
+CAENHVRESULT CAENHV_GetSysPropList(int handle, unsigned short *NumProp, char **PropNameList)
+{
+    Call c(TraceGetSysPropList);
+
+    if (c.active())
+        c.in.put<int32_t>(handle);
+
+    if (c.replaying())
+    {
+        if (c.replay(handle) == CAENHV_OK)
+            c.decode([&](TraceDecoder& d)
+            {
+                *NumProp      = d.get<uint16_t>();
+                *PropNameList = copyToHeap<char>(d.getString());
+            });
+        return c.done(handle);
+    }
+
+    if ( ( c.call([&]() { return lib.GetSysPropList(handle, NumProp, PropNameList); }) == CAENHV_OK ) && c.recording() )
+    {
+        c.out.put<uint16_t>(*NumProp);
+        c.out.putBytes(*PropNameList, stringListSize(*PropNameList, *NumProp));
+    }
+    return c.done(handle);
+}
+
+CAENHVRESULT CAENHV_GetSysPropInfo(int handle, const char *PropName, unsigned *PropMode, unsigned *PropType)
+{
+    Call c(TraceGetSysPropInfo);
+
+    if (c.active())
+    {
+        c.in.put<int32_t>(handle);
+        c.in.putString(PropName);
+    }
+
+    if (c.replaying())
+    {
+        if (c.replay(handle) == CAENHV_OK)
+            c.decode([&](TraceDecoder& d)
+            {
+                *PropMode = d.get<uint32_t>();
+                *PropType = d.get<uint32_t>();
+            });
+        return c.done(handle);
+    }
+
+    if (c.call([&]() { return lib.GetSysPropInfo(handle, PropName, PropMode, PropType); }) == CAENHV_OK)
+    {
+        // Needed to know the size of the property values
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            sysPropTypes[PropName] = *PropType;
+        }
+
+        c.out.put<uint32_t>(*PropMode);
+        c.out.put<uint32_t>(*PropType);
+    }
+    return c.done(handle);
+}
+
+CAENHVRESULT CAENHV_GetSysProp(int handle, const char *PropName, void *Result)
+{
+    Call c(TraceGetSysProp);
+
+    if (c.active())
+    {
+        c.in.put<int32_t>(handle);
+        c.in.putString(PropName);
+    }
+
+    if (c.replaying())
+    {
+        if (c.replay(handle) == CAENHV_OK)
+            c.decode([&](TraceDecoder& d) { d.getBytes(Result); });
+        return c.done(handle);
+    }
+
+    if ( ( c.call([&]() { return lib.GetSysProp(handle, PropName, Result); }) == CAENHV_OK ) && c.recording() )
+        c.out.putBytes(Result, sysPropSize(PropName, Result));
+    return c.done(handle);
+}
+
+CAENHVRESULT CAENHV_SetSysProp(int handle, const char *PropName, void *Set)
+{
+    Call c(TraceSetSysProp);
+
+    if (c.active())
+    {
+        c.in.put<int32_t>(handle);
+        c.in.putString(PropName);
+        c.in.putBytes(Set, sysPropSize(PropName, Set));
+    }
+
+    if (c.replaying())
+        return c.replay(handle);
+
+    c.call([&]() { return lib.SetSysProp(handle, PropName, Set); });
+    return c.done(handle);
+}
+
+CAENHVRESULT CAENHV_GetBdParamInfo(int handle, unsigned short slot, char **ParNameList)
+{
+    Call c(TraceGetBdParamInfo);
+
+    if (c.active())
+    {
+        c.in.put<int32_t>(handle);
+        c.in.put<uint16_t>(slot);
+    }
+
+    if (c.replaying())
+    {
+        if (c.replay(handle) == CAENHV_OK)
+            c.decode([&](TraceDecoder& d) { *ParNameList = copyToHeap<char>(d.getString()); });
+        return c.done(handle);
+    }
+
+    if ( ( c.call([&]() { return lib.GetBdParamInfo(handle, slot, ParNameList); }) == CAENHV_OK ) && c.recording() )
+        c.out.putBytes(*ParNameList, nameArraySize(*ParNameList));
+    return c.done(handle);
+}
+
+CAENHVRESULT CAENHV_GetBdParamProp(int handle, unsigned short slot, const char *ParName, const char *PropName, void *retval)
+{
+    Call c(TraceGetBdParamProp);
+
+    if (c.active())
+    {
+        c.in.put<int32_t>(handle);
+        c.in.put<uint16_t>(slot);
+        c.in.putString(ParName);
+        c.in.putString(PropName);
+    }
+
+    if (c.replaying())
+    {
+        if (c.replay(handle) == CAENHV_OK)
+            c.decode([&](TraceDecoder& d) { d.getBytes(retval); });
+        return c.done(handle);
+    }
+
+    if ( ( c.call([&]() { return lib.GetBdParamProp(handle, slot, ParName, PropName, retval); }) == CAENHV_OK ) && c.recording() )
+        c.out.putBytes(retval, paramPropSize(PropName, retval));
+    return c.done(handle);
+}
+
+CAENHVRESULT CAENHV_GetBdParam(int handle, unsigned short slotNum, const unsigned short *slotList, const char *ParName, void *ParValList)
+{
+    Call c(TraceGetBdParam);
+
+    if (c.active())
+    {
+        c.in.put<int32_t>(handle);
+        c.in.putBytes(slotList, slotNum * sizeof(unsigned short));
+        c.in.putString(ParName);
+    }
+
+    if (c.replaying())
+    {
+        if (c.replay(handle) == CAENHV_OK)
+            c.decode([&](TraceDecoder& d) { d.getBytes(ParValList); });
+        return c.done(handle);
+    }
+
+    // The values are either floats or 32-bit integers
+    if ( ( c.call([&]() { return lib.GetBdParam(handle, slotNum, slotList, ParName, ParValList); }) == CAENHV_OK ) && c.recording() )
+        c.out.putBytes(ParValList, slotNum * sizeof(uint32_t));
+    return c.done(handle);
+}
+
+CAENHVRESULT CAENHV_SetBdParam(int handle, unsigned short slotNum, const unsigned short *slotList, const char *ParName, void *ParValue)
+{
+    Call c(TraceSetBdParam);
+
+    if (c.active())
+    {
+        c.in.put<int32_t>(handle);
+        c.in.putBytes(slotList, slotNum * sizeof(unsigned short));
+        c.in.putString(ParName);
+        c.in.putBytes(ParValue, sizeof(uint32_t));
+    }
+
+    if (c.replaying())
+        return c.replay(handle);
+
+    c.call([&]() { return lib.SetBdParam(handle, slotNum, slotList, ParName, ParValue); });
+    return c.done(handle);
+}
+
+CAENHVRESULT CAENHV_GetChParamInfo(int handle, unsigned short slot, unsigned short Ch, char **ParNameList, int *ParNumber)
+{
+    Call c(TraceGetChParamInfo);
+
+    if (c.active())
+    {
+        c.in.put<int32_t>(handle);
+        c.in.put<uint16_t>(slot);
+        c.in.put<uint16_t>(Ch);
+    }
+
+    if (c.replaying())
+    {
+        if (c.replay(handle) == CAENHV_OK)
+            c.decode([&](TraceDecoder& d)
+            {
+                *ParNumber   = d.get<int32_t>();
+                *ParNameList = copyToHeap<char>(d.getString());
+            });
+        return c.done(handle);
+    }
+
+    if ( ( c.call([&]() { return lib.GetChParamInfo(handle, slot, Ch, ParNameList, ParNumber); }) == CAENHV_OK ) && c.recording() )
+    {
+        c.out.put<int32_t>(*ParNumber);
+        c.out.putBytes(*ParNameList, *ParNumber * MAX_PARAM_NAME);
+    }
+    return c.done(handle);
+}
+
+CAENHVRESULT CAENHV_GetChParamProp(int handle, unsigned short slot, unsigned short Ch, const char *ParName, const char *PropName, void *retval)
+{
+    Call c(TraceGetChParamProp);
+
+    if (c.active())
+    {
+        c.in.put<int32_t>(handle);
+        c.in.put<uint16_t>(slot);
+        c.in.put<uint16_t>(Ch);
+        c.in.putString(ParName);
+        c.in.putString(PropName);
+    }
+
+    if (c.replaying())
+    {
+        if (c.replay(handle) == CAENHV_OK)
+            c.decode([&](TraceDecoder& d) { d.getBytes(retval); });
+        return c.done(handle);
+    }
+
+    if ( ( c.call([&]() { return lib.GetChParamProp(handle, slot, Ch, ParName, PropName, retval); }) == CAENHV_OK ) && c.recording() )
+        c.out.putBytes(retval, paramPropSize(PropName, retval));
+    return c.done(handle);
+}
+
+CAENHVRESULT CAENHV_GetChParam(int handle, unsigned short slot, const char *ParName, unsigned short ChNum, const unsigned short *ChList, void *ParValList)
+{
+    Call c(TraceGetChParam);
+
+    if (c.active())
+    {
+        c.in.put<int32_t>(handle);
+        c.in.put<uint16_t>(slot);
+        c.in.putString(ParName);
+        c.in.putBytes(ChList, ChNum * sizeof(unsigned short));
+    }
+
+    if (c.replaying())
+    {
+        if (c.replay(handle) == CAENHV_OK)
+            c.decode([&](TraceDecoder& d) { d.getBytes(ParValList); });
+        return c.done(handle);
+    }
+
+    // The values are either floats or 32-bit integers
+    if ( ( c.call([&]() { return lib.GetChParam(handle, slot, ParName, ChNum, ChList, ParValList); }) == CAENHV_OK ) && c.recording() )
+        c.out.putBytes(ParValList, ChNum * sizeof(uint32_t));
+    return c.done(handle);
+}
+
+CAENHVRESULT CAENHV_SetChParam(int handle, unsigned short slot, const char *ParName, unsigned short ChNum, const unsigned short *ChList, void *ParValue)
+{
+    Call c(TraceSetChParam);
+
+    if (c.active())
+    {
+        c.in.put<int32_t>(handle);
+        c.in.put<uint16_t>(slot);
+        c.in.putString(ParName);
+        c.in.putBytes(ChList, ChNum * sizeof(unsigned short));
+        c.in.putBytes(ParValue, sizeof(uint32_t));
+    }
+
+    if (c.replaying())
+        return c.replay(handle);
+
+    c.call([&]() { return lib.SetChParam(handle, slot, ParName, ChNum, ChList, ParValue); });
+    return c.done(handle);
+}
+
+CAENHVRESULT CAENHV_GetChName(int handle, unsigned short slot, unsigned short ChNum, const unsigned short *ChList, char (*ChNameList)[MAX_CH_NAME])
+{
+    Call c(TraceGetChName);
+
+    if (c.active())
+    {
+        c.in.put<int32_t>(handle);
+        c.in.put<uint16_t>(slot);
+        c.in.putBytes(ChList, ChNum * sizeof(unsigned short));
+    }
+
+    if (c.replaying())
+    {
+        if (c.replay(handle) == CAENHV_OK)
+            c.decode([&](TraceDecoder& d) { d.getBytes(ChNameList); });
+        return c.done(handle);
+    }
+
+    if ( ( c.call([&]() { return lib.GetChName(handle, slot, ChNum, ChList, ChNameList); }) == CAENHV_OK ) && c.recording() )
+        c.out.putBytes(ChNameList, ChNum * MAX_CH_NAME);
+    return c.done(handle);
+}
+
+CAENHVRESULT CAENHV_SetChName(int handle, unsigned short slot, unsigned short ChNum, const unsigned short *ChList, const char *ChName)
+{
+    Call c(TraceSetChName);
+
+    if (c.active())
+    {
+        c.in.put<int32_t>(handle);
+        c.in.put<uint16_t>(slot);
+        c.in.putBytes(ChList, ChNum * sizeof(unsigned short));
+        c.in.putString(ChName);
+    }
+
+    if (c.replaying())
+        return c.replay(handle);
+
+    c.call([&]() { return lib.SetChName(handle, slot, ChNum, ChList, ChName); });
+    return c.done(handle);
+}